@@ -0,0 +1,50 @@
+/**
+ * \file bench/bench_vcjson.h
+ *
+ * \brief Helpers shared by the vcjson benchmarks.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <vcjson/vcjson.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/**
+ * \brief Get the current monotonic time in nanoseconds.
+ *
+ * \returns the current time in nanoseconds.
+ */
+double bench_now(void);
+
+/**
+ * \brief Report a benchmark result.
+ *
+ * \param name          The name of this benchmark.
+ * \param elapsed       The elapsed time in nanoseconds.
+ * \param ops           The number of operations performed.
+ */
+void bench_report(const char* name, double elapsed, size_t ops);
+
+/**
+ * \brief Time JSON and CBOR round trips of the given document.
+ *
+ * \param name          The name of this benchmark.
+ * \param alloc         The allocator to use.
+ * \param doc           The JSON document to round trip.
+ * \param objects       The number of objects in this document.
+ *
+ * \returns a status code indicating success or failure.
+ */
+status bench_cbor_round_trip(
+    const char* name, RCPR_SYM(allocator)* alloc, const char* doc,
+    size_t objects);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
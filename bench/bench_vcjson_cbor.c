@@ -0,0 +1,248 @@
+/**
+ * \file bench/bench_vcjson_cbor.c
+ *
+ * \brief Benchmarks comparing JSON and CBOR round trips.
+ *
+ * Each document is emitted and parsed back as JSON text and as CBOR, so that
+ * the cost and size of the two encodings can be compared on the same trees.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "bench_vcjson.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+#define BENCH_CBOR_ROUNDS       20
+
+/**
+ * \brief A growable buffer receiving emitted CBOR.
+ */
+typedef struct bench_cbor_buffer bench_cbor_buffer;
+struct bench_cbor_buffer
+{
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+};
+
+/**
+ * \brief Sink that appends to a \ref bench_cbor_buffer, growing it as needed.
+ *
+ * \param context       The buffer to append to.
+ * \param data          The data to append.
+ * \param size          The size of this data.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status bench_cbor_sink(void* context, const void* data, size_t size)
+{
+    bench_cbor_buffer* buffer = (bench_cbor_buffer*)context;
+
+    if (buffer->size + size > buffer->capacity)
+    {
+        buffer->capacity = 2 * (buffer->size + size);
+        buffer->data = (uint8_t*)realloc(buffer->data, buffer->capacity);
+        if (NULL == buffer->data)
+        {
+            fprintf(stderr, "out of memory.\n");
+            exit(1);
+        }
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Time emitting and parsing a value as JSON text.
+ *
+ * \param name          The name of this benchmark.
+ * \param alloc         The allocator to use.
+ * \param value         The value to round trip.
+ * \param objects       The number of objects in this value.
+ * \param size          Pointer to receive the size of the JSON text.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status bench_cbor_json_round_trip(
+    const char* name, allocator* alloc, vcjson_value* value, size_t objects,
+    size_t* size)
+{
+    status retval;
+    vcjson_string* text;
+    vcjson_value* parsed;
+    const char* str;
+    size_t length, error_begin, error_end;
+    char label[64];
+    double begin, emit_elapsed = 0.0, parse_elapsed = 0.0;
+
+    for (size_t round = 0; round < BENCH_CBOR_ROUNDS; ++round)
+    {
+        begin = bench_now();
+        retval = vcjson_emit_string(&text, alloc, value);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+        emit_elapsed += bench_now() - begin;
+
+        str = vcjson_string_value(text, &length);
+        *size = strlen(str);
+
+        begin = bench_now();
+        retval =
+            vcjson_parse(
+                &parsed, &error_begin, &error_end, alloc, str, *size);
+        if (STATUS_SUCCESS != retval)
+        {
+            (void)resource_release(vcjson_string_resource_handle(text));
+            return retval;
+        }
+        parse_elapsed += bench_now() - begin;
+
+        retval = resource_release(vcjson_value_resource_handle(parsed));
+        if (STATUS_SUCCESS != retval)
+        {
+            (void)resource_release(vcjson_string_resource_handle(text));
+            return retval;
+        }
+
+        retval = resource_release(vcjson_string_resource_handle(text));
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    snprintf(label, sizeof(label), "%s json emit", name);
+    bench_report(label, emit_elapsed, BENCH_CBOR_ROUNDS * objects);
+    snprintf(label, sizeof(label), "%s json parse", name);
+    bench_report(label, parse_elapsed, BENCH_CBOR_ROUNDS * objects);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Time emitting and parsing a value as CBOR.
+ *
+ * \param name          The name of this benchmark.
+ * \param alloc         The allocator to use.
+ * \param value         The value to round trip.
+ * \param objects       The number of objects in this value.
+ * \param size          Pointer to receive the size of the CBOR encoding.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status bench_cbor_cbor_round_trip(
+    const char* name, allocator* alloc, vcjson_value* value, size_t objects,
+    size_t* size)
+{
+    status retval = STATUS_SUCCESS;
+    bench_cbor_buffer buffer = { NULL, 0, 0 };
+    vcjson_value* parsed;
+    size_t error_offset;
+    char label[64];
+    double begin, emit_elapsed = 0.0, parse_elapsed = 0.0;
+
+    for (size_t round = 0; round < BENCH_CBOR_ROUNDS; ++round)
+    {
+        buffer.size = 0;
+
+        begin = bench_now();
+        retval = vcjson_emit_cbor(value, &bench_cbor_sink, &buffer);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+        emit_elapsed += bench_now() - begin;
+
+        begin = bench_now();
+        retval =
+            vcjson_parse_cbor(
+                &parsed, &error_offset, alloc, buffer.data, buffer.size, 0);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+        parse_elapsed += bench_now() - begin;
+
+        retval = resource_release(vcjson_value_resource_handle(parsed));
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
+    *size = buffer.size;
+
+    snprintf(label, sizeof(label), "%s cbor emit", name);
+    bench_report(label, emit_elapsed, BENCH_CBOR_ROUNDS * objects);
+    snprintf(label, sizeof(label), "%s cbor parse", name);
+    bench_report(label, parse_elapsed, BENCH_CBOR_ROUNDS * objects);
+
+done:
+    free(buffer.data);
+
+    return retval;
+}
+
+/**
+ * \brief Time JSON and CBOR round trips of the given document.
+ *
+ * \param name          The name of this benchmark.
+ * \param alloc         The allocator to use.
+ * \param doc           The JSON document to round trip.
+ * \param objects       The number of objects in this document.
+ *
+ * \returns a status code indicating success or failure.
+ */
+status bench_cbor_round_trip(
+    const char* name, allocator* alloc, const char* doc, size_t objects)
+{
+    status retval, release_retval;
+    vcjson_value* value;
+    size_t error_begin, error_end, json_size = 0, cbor_size = 0;
+
+    /* both encodings start from the same tree. */
+    retval = vcjson_parse_string(&value, &error_begin, &error_end, alloc, doc);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        bench_cbor_json_round_trip(name, alloc, value, objects, &json_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_value;
+    }
+
+    retval =
+        bench_cbor_cbor_round_trip(name, alloc, value, objects, &cbor_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_value;
+    }
+
+    printf(
+        "%-28s %10zu json bytes %7zu cbor bytes\n", name, json_size,
+        cbor_size);
+
+cleanup_value:
+    release_retval = resource_release(vcjson_value_resource_handle(value));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,395 @@
+/**
+ * \file bench/bench_vcjson_object.c
+ *
+ * \brief Benchmarks for object-heavy documents.
+ *
+ * This benchmark parses documents made up of many small objects and of a few
+ * wide objects, round trips them through JSON and CBOR, and builds and queries
+ * wide objects using each storage, so that changes to object insertion and
+ * lookup can be compared.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vcjson/vcjson.h>
+
+#include "bench_vcjson.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+#define BENCH_SMALL_OBJECTS     20000
+#define BENCH_WIDE_OBJECTS      20
+#define BENCH_WIDE_KEYS         1000
+#define BENCH_ROUNDS            20
+
+/**
+ * \brief Get the current monotonic time in nanoseconds.
+ *
+ * \returns the current time in nanoseconds.
+ */
+double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * \brief Report a benchmark result.
+ *
+ * \param name          The name of this benchmark.
+ * \param elapsed       The elapsed time in nanoseconds.
+ * \param ops           The number of operations performed.
+ */
+void bench_report(const char* name, double elapsed, size_t ops)
+{
+    printf("%-28s %10.1f ns/op %12zu ops\n", name, elapsed / ops, ops);
+}
+
+/**
+ * \brief Append formatted text to a document buffer, growing it as needed.
+ *
+ * \param doc           Pointer to the document buffer.
+ * \param size          Pointer to the document size.
+ * \param capacity      Pointer to the document capacity.
+ * \param text          The text to append.
+ */
+static void bench_append(
+    char** doc, size_t* size, size_t* capacity, const char* text)
+{
+    size_t length = strlen(text);
+
+    if (*size + length + 1 > *capacity)
+    {
+        *capacity = 2 * (*size + length + 1);
+        *doc = (char*)realloc(*doc, *capacity);
+        if (NULL == *doc)
+        {
+            fprintf(stderr, "out of memory.\n");
+            exit(1);
+        }
+    }
+
+    memcpy(*doc + *size, text, length + 1);
+    *size += length;
+}
+
+/**
+ * \brief Build a document made up of many small records.
+ *
+ * \returns the document, which must be freed by the caller.
+ */
+static char* bench_small_document(void)
+{
+    char* doc = NULL;
+    size_t size = 0, capacity = 0;
+    char text[256];
+
+    bench_append(&doc, &size, &capacity, "[");
+    for (size_t i = 0; i < BENCH_SMALL_OBJECTS; ++i)
+    {
+        snprintf(
+            text, sizeof(text),
+            "%s{\"id\":%zu,\"name\":\"user%zu\",\"active\":true,"
+            "\"score\":%zu,\"region\":\"r%zu\",\"tags\":null}",
+            (0 == i) ? "" : ",", i, i, i * 7, i % 13);
+        bench_append(&doc, &size, &capacity, text);
+    }
+    bench_append(&doc, &size, &capacity, "]");
+
+    return doc;
+}
+
+/**
+ * \brief Build a document made up of a few wide objects.
+ *
+ * \returns the document, which must be freed by the caller.
+ */
+static char* bench_wide_document(void)
+{
+    char* doc = NULL;
+    size_t size = 0, capacity = 0;
+    char text[64];
+
+    bench_append(&doc, &size, &capacity, "[");
+    for (size_t i = 0; i < BENCH_WIDE_OBJECTS; ++i)
+    {
+        bench_append(&doc, &size, &capacity, (0 == i) ? "{" : ",{");
+        for (size_t j = 0; j < BENCH_WIDE_KEYS; ++j)
+        {
+            snprintf(
+                text, sizeof(text), "%s\"field%zu\":%zu",
+                (0 == j) ? "" : ",", (j * 7919) % BENCH_WIDE_KEYS, j);
+            bench_append(&doc, &size, &capacity, text);
+        }
+        bench_append(&doc, &size, &capacity, "}");
+    }
+    bench_append(&doc, &size, &capacity, "]");
+
+    return doc;
+}
+
+/**
+ * \brief Time parsing the given document.
+ *
+ * \param name          The name of this benchmark.
+ * \param alloc         The allocator to use.
+ * \param doc           The document to parse.
+ * \param objects       The number of objects in this document.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status bench_parse(
+    const char* name, allocator* alloc, const char* doc, size_t objects)
+{
+    status retval;
+    vcjson_value* value;
+    size_t error_begin, error_end;
+    double begin, elapsed = 0.0;
+
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        begin = bench_now();
+        retval =
+            vcjson_parse_string(&value, &error_begin, &error_end, alloc, doc);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+        elapsed += bench_now() - begin;
+
+        retval = resource_release(vcjson_value_resource_handle(value));
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    bench_report(name, elapsed, BENCH_ROUNDS * objects);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Time building and querying a wide object with the given storage.
+ *
+ * \param name          The name of this benchmark.
+ * \param alloc         The allocator to use.
+ * \param storage       The object storage to use.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status bench_wide_object(
+    const char* name, allocator* alloc, int storage)
+{
+    status retval, release_retval;
+    vcjson_object* obj;
+    vcjson_string* key;
+    vcjson_number* number;
+    vcjson_value* value;
+    char text[64], label[64];
+    double begin, put_elapsed = 0.0, get_elapsed = 0.0;
+
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        retval = vcjson_object_create_with_storage(&obj, alloc, storage);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* build the object, including the key and value allocations. */
+        begin = bench_now();
+        for (size_t j = 0; j < BENCH_WIDE_KEYS; ++j)
+        {
+            snprintf(
+                text, sizeof(text), "field%zu", (j * 7919) % BENCH_WIDE_KEYS);
+
+            retval = vcjson_string_create(&key, alloc, text);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_obj;
+            }
+
+            retval = vcjson_number_create(&number, alloc, (double)j);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_key;
+            }
+
+            retval = vcjson_value_create_from_number(&value, alloc, number);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_number;
+            }
+
+            retval = vcjson_object_put(obj, key, value);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_value;
+            }
+        }
+        put_elapsed += bench_now() - begin;
+
+        /* look up every key. */
+        begin = bench_now();
+        for (size_t j = 0; j < BENCH_WIDE_KEYS; ++j)
+        {
+            snprintf(text, sizeof(text), "field%zu", j);
+
+            retval = vcjson_object_get_cstr(&value, obj, text);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_obj;
+            }
+        }
+        get_elapsed += bench_now() - begin;
+
+        retval = resource_release(vcjson_object_resource_handle(obj));
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    snprintf(label, sizeof(label), "%s put", name);
+    bench_report(label, put_elapsed, BENCH_ROUNDS * BENCH_WIDE_KEYS);
+    snprintf(label, sizeof(label), "%s get", name);
+    bench_report(label, get_elapsed, BENCH_ROUNDS * BENCH_WIDE_KEYS);
+
+    return STATUS_SUCCESS;
+
+cleanup_value:
+    release_retval = resource_release(vcjson_value_resource_handle(value));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+    goto cleanup_key;
+
+cleanup_number:
+    release_retval = resource_release(vcjson_number_resource_handle(number));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_key:
+    release_retval = resource_release(vcjson_string_resource_handle(key));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_obj:
+    release_retval = resource_release(vcjson_object_resource_handle(obj));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Run the object benchmarks.
+ *
+ * \returns 0 on success and 1 on failure.
+ */
+int main(void)
+{
+    status retval, release_retval;
+    allocator* alloc;
+    char* small_doc = NULL;
+    char* wide_doc = NULL;
+
+    retval = malloc_allocator_create(&alloc);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    small_doc = bench_small_document();
+    wide_doc = bench_wide_document();
+
+    retval =
+        bench_parse(
+            "parse small objects", alloc, small_doc, BENCH_SMALL_OBJECTS);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+    retval =
+        bench_parse(
+            "parse wide object members", alloc, wide_doc,
+            BENCH_WIDE_OBJECTS * BENCH_WIDE_KEYS);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+    retval =
+        bench_cbor_round_trip(
+            "small objects", alloc, small_doc, BENCH_SMALL_OBJECTS);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+    retval =
+        bench_cbor_round_trip(
+            "wide members", alloc, wide_doc,
+            BENCH_WIDE_OBJECTS * BENCH_WIDE_KEYS);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+    retval =
+        bench_wide_object("wide tree", alloc, VCJSON_OBJECT_STORAGE_TREE);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+    retval =
+        bench_wide_object("wide hash", alloc, VCJSON_OBJECT_STORAGE_HASH);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+    retval =
+        bench_wide_object("wide flat", alloc, VCJSON_OBJECT_STORAGE_FLAT);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc;
+    }
+
+cleanup_alloc:
+    release_retval = resource_release(allocator_resource_handle(alloc));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    free(small_doc);
+    free(wide_doc);
+
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "benchmark failed: 0x%x\n", retval);
+        return 1;
+    }
+
+    return 0;
+}
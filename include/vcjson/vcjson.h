@@ -10,6 +10,8 @@
 
 #include <rcpr/allocator.h>
 #include <rcpr/status.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 #if defined(__cplusplus)
 extern "C" {
@@ -28,6 +30,39 @@ enum vcjson_value_type
     VCJSON_VALUE_TYPE_BOOL
 };
 
+/**
+ * \brief JSON object storage.
+ */
+enum vcjson_object_storage
+{
+    /* members are stored in a balanced tree. */
+    VCJSON_OBJECT_STORAGE_TREE,
+    /* members are stored in an open-addressing hash table. */
+    VCJSON_OBJECT_STORAGE_HASH,
+    /* members are stored in a small array, and promoted to a hash table. */
+    VCJSON_OBJECT_STORAGE_FLAT
+};
+
+/**
+ * \brief Flags controlling the parser.
+ */
+enum vcjson_parse_flags
+{
+    /* parsed objects keep their members in document order. */
+    VCJSON_PARSE_FLAG_INSERTION_ORDER = 0x0001,
+    /* every parsed string is sensitive. */
+    VCJSON_PARSE_FLAG_SENSITIVE = 0x0002
+};
+
+/**
+ * \brief Flags controlling how a snapshot is mapped.
+ */
+enum vcjson_snapshot_flags
+{
+    /* skip the checksum of the tape, trusting that it is intact. */
+    VCJSON_SNAPSHOT_FLAG_NO_VERIFY = 0x0001
+};
+
 /**
  * \brief JSON object type.
  */
@@ -68,6 +103,72 @@ typedef struct vcjson_null vcjson_null;
  */
 typedef struct vcjson_value vcjson_value;
 
+/**
+ * \brief Scatter/gather list of emitted JSON text.
+ */
+typedef struct vcjson_iovec_list vcjson_iovec_list;
+
+/**
+ * \brief Pool of small node allocations.
+ */
+typedef struct vcjson_pool vcjson_pool;
+
+/**
+ * \brief A JSON value frozen into a contiguous, read-only tape.
+ */
+typedef struct vcjson_frozen vcjson_frozen;
+
+/**
+ * \brief A value within a frozen tape.
+ */
+typedef struct vcjson_frozen_value vcjson_frozen_value;
+
+/**
+ * \brief An object within a frozen tape.
+ */
+typedef struct vcjson_frozen_object vcjson_frozen_object;
+
+/**
+ * \brief An array within a frozen tape.
+ */
+typedef struct vcjson_frozen_array vcjson_frozen_array;
+
+/* forward decl for scatter/gather emission. */
+struct iovec;
+
+/**
+ * \brief Sink function that receives emitted JSON text.
+ *
+ * \param context       The user context for this sink.
+ * \param data          The data to write.
+ * \param size          The size of this data.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure, which aborts the emission.
+ */
+typedef status (*vcjson_emit_sink_fn)(
+    void* context, const void* data, size_t size);
+
+/**
+ * \brief Callback function that receives each member of an object.
+ *
+ * \param context       The user context for this callback.
+ * \param key           The key of this member.
+ * \param value         The value of this member.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS to continue with the next member.
+ *      - a non-zero error code, which stops the walk.
+ */
+typedef status (*vcjson_object_foreach_fn)(
+    void* context, const vcjson_string* key, vcjson_value* value);
+
+/**
+ * \brief Size of a SHA-256 digest, in bytes.
+ */
+#define VCJSON_SHA256_DIGEST_SIZE 32
+
 /**
  * \brief the JSON null singleton for this library.
  */
@@ -92,6 +193,49 @@ extern const vcjson_bool* VCJSON_FALSE;
 #define VCJSON_PARSER_MAXIMUM_RECURSION_DEPTH 128
 #endif
 
+/**
+ * \brief Maximum number of members held by a flat object.
+ *
+ * Flat objects, which the parser uses for every object, are searched linearly.
+ * Adding a member beyond this count promotes the object to hash storage.
+ */
+#define VCJSON_OBJECT_FLAT_MAXIMUM_SIZE 16
+
+/**
+ * \brief Minimum size of a string run referenced by a scatter/gather list.
+ *
+ * Shorter runs are copied into the list's scratch area, since an extra iovec
+ * entry costs more than copying a few bytes.
+ */
+#define VCJSON_EMIT_IOVEC_REFERENCE_MINIMUM 64
+
+/**
+ * \brief Number of members per chunk for parallel emission.
+ *
+ * Objects and arrays larger than this are split into chunks of this size.
+ */
+#define VCJSON_EMIT_PARALLEL_CHUNK_SIZE 4096
+
+/**
+ * \brief Depth to which parallel emission searches for large containers.
+ *
+ * Smaller containers at a shallower depth than this are descended into, so
+ * that large containers nested within them can be split into chunks.
+ */
+#define VCJSON_EMIT_PARALLEL_MAXIMUM_DEPTH 4
+
+/**
+ * \brief Size of each slab that a \ref vcjson_pool carves into nodes.
+ */
+#define VCJSON_POOL_SLAB_SIZE 16384
+
+/**
+ * \brief Version of the snapshot format written by this library.
+ *
+ * Snapshots of any other version are rejected when they are mapped.
+ */
+#define VCJSON_SNAPSHOT_VERSION 1
+
 /* error codes. */
 #define ERROR_VCJSON_INVALID_GET                                        0x6300
 #define ERROR_VCJSON_KEY_NOT_FOUND                                      0x6301
@@ -102,6 +246,20 @@ extern const vcjson_bool* VCJSON_FALSE;
 #define ERROR_VCJSON_EMIT_NUMBER_FORMAT                                 0x6306
 #define ERROR_VCJSON_EMIT_GENERAL_FORMAT                                0x6307
 #define ERROR_VCJSON_EMIT_UNKNOWN_VALUE_TYPE                            0x6308
+#define ERROR_VCJSON_OBJECT_BAD_STORAGE                                 0x6309
+#define ERROR_VCJSON_OBJECT_DUPLICATE_KEY                               0x630a
+#define ERROR_VCJSON_ARRAY_NOT_PACKED                                   0x630b
+#define ERROR_VCJSON_VALUE_SHARED                                       0x630c
+#define ERROR_VCJSON_FREEZE_TOO_LARGE                                   0x630d
+#define ERROR_VCJSON_SNAPSHOT_IO                                        0x630e
+#define ERROR_VCJSON_SNAPSHOT_BAD_HEADER                                0x630f
+#define ERROR_VCJSON_SNAPSHOT_BAD_CHECKSUM                              0x6310
+#define ERROR_VCJSON_SNAPSHOT_SENSITIVE                                 0x6311
+#define ERROR_VCJSON_CBOR_TRUNCATED                                     0x6312
+#define ERROR_VCJSON_CBOR_MALFORMED                                     0x6313
+#define ERROR_VCJSON_CBOR_UNSUPPORTED                                   0x6314
+#define ERROR_VCJSON_POOL_IN_USE                                        0x6315
+#define ERROR_VCJSON_SNAPSHOT_BAD_TAPE                                  0x6316
 #define ERROR_VCJSON_PARSE_RECURSION_DEPTH_EXCEEDED                     0x6380
 #define ERROR_VCJSON_PARSE_b369f991_4e11_4210_9076_ddc799d5bf44         0x6381
 #define ERROR_VCJSON_PARSE_fb48555e_2ed9_414a_841e_0d5b39b52090         0x6382
@@ -170,6 +328,94 @@ extern const vcjson_bool* VCJSON_FALSE;
 status FN_DECL_MUST_CHECK
 vcjson_object_create(vcjson_object** obj, RCPR_SYM(allocator)* alloc);
 
+/**
+ * \brief Create an empty \ref vcjson_object using the given storage.
+ *
+ * \ref VCJSON_OBJECT_STORAGE_TREE is what \ref vcjson_object_create uses.
+ * \ref VCJSON_OBJECT_STORAGE_HASH keeps members in an open-addressing hash
+ * table, giving constant time lookups on wide objects.
+ * \ref VCJSON_OBJECT_STORAGE_FLAT keeps a few members in a small array
+ * allocated along with the object, and becomes a hash-backed object once it
+ * holds more than \ref VCJSON_OBJECT_FLAT_MAXIMUM_SIZE members. All storage
+ * kinds iterate and emit members in the same sorted key order.
+ *
+ * \note On success, this function creates a  \ref vcjson_object instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle.
+ *
+ * \param obj           Pointer to the object pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param storage       The \ref vcjson_object_storage for this object.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_OBJECT_BAD_STORAGE if \p storage is unknown.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_create_with_storage(
+    vcjson_object** obj, RCPR_SYM(allocator)* alloc, int storage);
+
+/**
+ * \brief Create a \ref vcjson_object holding the given members.
+ *
+ * This builds the object in a single pass instead of one
+ * \ref vcjson_object_put per member. Members whose keys are already in
+ * ascending order need no sorting; otherwise they are sorted once. Objects
+ * with at most \ref VCJSON_OBJECT_FLAT_MAXIMUM_SIZE members use
+ * \ref VCJSON_OBJECT_STORAGE_FLAT, and larger objects use
+ * \ref VCJSON_OBJECT_STORAGE_HASH.
+ *
+ * \note On success, this function creates a  \ref vcjson_object instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. On success, the object takes ownership of the given keys and
+ * values. On failure, they remain owned by the caller.
+ *
+ * \param obj           Pointer to the object pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param keys          The keys of the members.
+ * \param values        The values of the members, matching \p keys.
+ * \param count         The number of members.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_OBJECT_DUPLICATE_KEY if a key appears more than once.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_create_from_members(
+    vcjson_object** obj, RCPR_SYM(allocator)* alloc, vcjson_string** keys,
+    vcjson_value** values, size_t count);
+
+/**
+ * \brief Choose whether an object walks its members in insertion order.
+ *
+ * By default, objects iterate and emit their members in sorted key order. An
+ * object using \ref VCJSON_OBJECT_STORAGE_HASH or
+ * \ref VCJSON_OBJECT_STORAGE_FLAT can instead keep the order in which its
+ * members were first put. Replacing the value of an existing key keeps its
+ * position, and removing a member keeps the order of the rest. Members are
+ * removed faster while this is off, by moving the last member into the gap,
+ * so turning it on after such a removal walks the members in the order they
+ * were left in. Canonical emission always sorts members.
+ *
+ * \param obj           The object instance for this operation.
+ * \param enabled       true to walk members in insertion order, or false to
+ *                      walk them in sorted key order.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - ERROR_VCJSON_OBJECT_BAD_STORAGE if \p obj uses
+ *        \ref VCJSON_OBJECT_STORAGE_TREE.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_set_insertion_order(vcjson_object* obj, bool enabled);
+
 /**
  * \brief Make a deep copy of the given object.
  *
@@ -213,6 +459,8 @@ size_t vcjson_object_elements(const vcjson_object* obj);
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
@@ -240,6 +488,51 @@ status FN_DECL_MUST_CHECK
 vcjson_object_get(
     vcjson_value** value, vcjson_object* obj, const vcjson_string* key);
 
+/**
+ * \brief Get a value from the object using the given key bytes.
+ *
+ * On success, the value pointer is updated with the \ref vcjson_value instance
+ * associated with the given key in this object. The key is compared directly
+ * against the stored keys, so no \ref vcjson_string is created.
+ *
+ * \note Ownership of the returned value remains with the object.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The key bytes for this operation.
+ * \param length        The length of this key, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_get_raw(
+    vcjson_value** value, vcjson_object* obj, const char* key, size_t length);
+
+/**
+ * \brief Get a value from the object using the given C string key.
+ *
+ * On success, the value pointer is updated with the \ref vcjson_value instance
+ * associated with the given key in this object. The key is compared directly
+ * against the stored keys, so no \ref vcjson_string is created.
+ *
+ * \note Ownership of the returned value remains with the object.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The NUL-terminated key for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_get_cstr(
+    vcjson_value** value, vcjson_object* obj, const char* key);
+
 /**
  * \brief Remove the given key from the object.
  *
@@ -254,6 +547,8 @@ vcjson_object_get(
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
@@ -270,11 +565,33 @@ vcjson_object_remove(vcjson_object* obj, const vcjson_string* key);
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
 vcjson_object_clear(vcjson_object* obj);
 
+/**
+ * \brief Call the given function for each member of an object.
+ *
+ * Members are visited in the same order as \ref vcjson_object_iterator_create
+ * would visit them. Unlike an iterator, this walk does not allocate.
+ *
+ * \note The callback must not add or remove members of this object.
+ *
+ * \param obj           The object instance for this operation.
+ * \param fn            The function to call for each member.
+ * \param context       The user context to pass to this function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code returned by \p fn, which stops the walk.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_foreach(
+    vcjson_object* obj, vcjson_object_foreach_fn fn, void* context);
+
 /* TODO - use a separate allocator for creating an iterator. */
 
 /**
@@ -387,6 +704,34 @@ status FN_DECL_MUST_CHECK
 vcjson_array_create(
     vcjson_array** arr, RCPR_SYM(allocator)* alloc, size_t size);
 
+/**
+ * \brief Create a packed \ref vcjson_array holding the given numbers.
+ *
+ * A packed array stores its numbers contiguously instead of as a value per
+ * element. \ref vcjson_array_get_doubles gives direct access to them, and
+ * \ref vcjson_array_get boxes an element into a value the first time it is
+ * requested. Modifying a packed array converts it to an array of values. The
+ * parser creates packed arrays for arrays that hold only numbers.
+ *
+ * \note On success, this function creates a \ref vcjson_array instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle.
+ *
+ * \param arr           Pointer to the array pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param numbers       The numbers to copy into this array.
+ * \param size          The number of numbers.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_create_from_doubles(
+    vcjson_array** arr, RCPR_SYM(allocator)* alloc, const double* numbers,
+    size_t size);
+
 /**
  * \brief Make a deep copy of the given \ref vcjson_array.
  *
@@ -407,6 +752,24 @@ status FN_DECL_MUST_CHECK
 vcjson_array_copy(
     vcjson_array** arr, RCPR_SYM(allocator)* alloc, const vcjson_array* orig);
 
+/**
+ * \brief Get the numbers of a packed \ref vcjson_array.
+ *
+ * \note On success, the numbers pointer refers to the storage of this array,
+ * holding \ref vcjson_array_size numbers. It remains valid until the array is
+ * modified or released.
+ *
+ * \param numbers       Pointer to receive the numbers of this array.
+ * \param arr           The array instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ARRAY_NOT_PACKED if this array is not a packed number
+ *        array.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_get_doubles(const double** numbers, const vcjson_array* arr);
+
 /**
  * \brief Get the size of the given array instance.
  *
@@ -429,16 +792,104 @@ size_t vcjson_array_size(const vcjson_array* arr);
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
 vcjson_array_set(vcjson_array* arr, size_t offset, vcjson_value* value);
 
+/**
+ * \brief Ensure that the given \ref vcjson_array can hold at least the given
+ * number of elements without growing.
+ *
+ * \note Capacity grows geometrically, so calling this before each append keeps
+ * building an array amortized constant time per element. The size of the
+ * array is not changed, but a packed number array is unpacked.
+ *
+ * \param arr           The array instance for this operation.
+ * \param capacity      The number of elements required.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_reserve(vcjson_array* arr, size_t capacity);
+
+/**
+ * \brief Append a value to the end of the given \ref vcjson_array.
+ *
+ * \note On success, this array instance takes ownership of the given \ref
+ * vcjson_value instance. On failure, the value remains owned by the caller.
+ *
+ * \param arr           The array instance for this operation.
+ * \param value         The value to append.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_append(vcjson_array* arr, vcjson_value* value);
+
+/**
+ * \brief Insert a value into the given \ref vcjson_array at the given offset.
+ *
+ * Elements at and after \p offset move up by one. An offset equal to the size
+ * of the array appends the value.
+ *
+ * \note On success, this array instance takes ownership of the given \ref
+ * vcjson_value instance. On failure, the value remains owned by the caller.
+ *
+ * \param arr           The array instance for this operation.
+ * \param offset        The offset at which this value should be inserted.
+ * \param value         The value to insert.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is greater than
+ *        the size of the array.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_insert(vcjson_array* arr, size_t offset, vcjson_value* value);
+
+/**
+ * \brief Remove the value at the given offset from the given
+ * \ref vcjson_array.
+ *
+ * The removed value is released using \ref resource_release, and elements
+ * after \p offset move down by one.
+ *
+ * \param arr           The array instance for this operation.
+ * \param offset        The offset of the value to remove.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is not less than
+ *        the size of the array.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_remove(vcjson_array* arr, size_t offset);
+
 /**
  * \brief Get the value of the \ref vcjson_array instance at the given offset.
  *
  * \note On success, the value at the given offset of the array is returned.
- * This value remains owned by this array instance.
+ * This value remains owned by this array instance. An element of a packed
+ * number array is boxed into a value the first time it is requested, so this
+ * can allocate even though it does not modify the array. Boxing is safe when
+ * the array is read on several threads at once.
  *
  * \param value         Pointer to the value pointer to receive this value. Note
  *                      that this value is owned by the array instance.
@@ -447,6 +898,10 @@ vcjson_array_set(vcjson_array* arr, size_t offset, vcjson_value* value);
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is past the end
+ *        of this array.
+ *      - ERROR_GENERAL_OUT_OF_MEMORY if boxing an element of a packed number
+ *        array fails to allocate.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
@@ -572,6 +1027,8 @@ vcjson_string_create_from_raw(
 /**
  * \brief Make a deep copy of the given \ref vcjson_string instance.
  *
+ * The copy is sensitive if the original is.
+ *
  * \note On success, this function creates a \ref vcjson_string instance. This
  * is a resource that is owned by the caller. When no longer needed, this
  * resource must be released by calling \ref resource_release on its resource
@@ -605,6 +1062,31 @@ vcjson_string_copy(
  */
 const char* vcjson_string_value(const vcjson_string* string, size_t* length);
 
+/**
+ * \brief Mark whether this \ref vcjson_string instance is sensitive.
+ *
+ * The characters of a sensitive string are wiped before they are reclaimed,
+ * along with the parser and emitter buffers that held them. The characters of
+ * other strings are reclaimed without being wiped.
+ *
+ * \note A string that is already part of an object or array should be marked
+ * through its value with \ref vcjson_value_set_sensitive, so that emitted
+ * forms of its containers that are cached are marked as well.
+ *
+ * \param string        The string instance for this operation.
+ * \param sensitive     true if this string is sensitive.
+ */
+void vcjson_string_set_sensitive(vcjson_string* string, bool sensitive);
+
+/**
+ * \brief Determine whether this \ref vcjson_string instance is sensitive.
+ *
+ * \param string        The string instance for this operation.
+ *
+ * \returns true if this string is sensitive, and false otherwise.
+ */
+bool vcjson_string_is_sensitive(const vcjson_string* string);
+
 /**
  * \brief Get the resource handle for the given \ref vcjson_string instance.
  *
@@ -707,15 +1189,70 @@ vcjson_value_create_from_string(
     vcjson_value** value, RCPR_SYM(allocator)* alloc, vcjson_string* string);
 
 /**
- * \brief Create a \ref vcjson_value instance from the null singleton.
- *
- * \note On success, this function creates a \ref vcjson_value instance which
- * references the null singleton. This value instance is a resource that is
- * owned by the caller. When no longer needed, this resource must be released by
- * calling \ref resource_release on its resource handle.
+ * \brief Create a \ref vcjson_value instance holding the given number.
  *
- * \param value         Pointer to the value pointer to hold this value.
- * \param alloc         The allocator to use for this operation.
+ * Unlike creating a \ref vcjson_number and wrapping it with
+ * \ref vcjson_value_create_from_number, this allocates the value and its
+ * number together in a single block.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. The
+ * \ref vcjson_number instance that it holds is owned by this value instance.
+ * This value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param number        The number value to be used for this instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_create_number(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, double number);
+
+/**
+ * \brief Create a \ref vcjson_value instance holding a copy of the given raw
+ * string value.
+ *
+ * Unlike creating a \ref vcjson_string and wrapping it with
+ * \ref vcjson_value_create_from_string, this allocates the value, its string,
+ * and the string's characters together in a single block.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. The
+ * \ref vcjson_string instance that it holds is owned by this value instance.
+ * This value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param str           The raw string value to be used for this instance. This
+ *                      value is copied; the original value is assumed owned by
+ *                      the caller.
+ * \param size          The size of this raw string value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_create_string_from_raw(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, const char* str,
+    size_t size);
+
+/**
+ * \brief Create a \ref vcjson_value instance from the null singleton.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance which
+ * references the null singleton. This value instance is a resource that is
+ * owned by the caller. When no longer needed, this resource must be released by
+ * calling \ref resource_release on its resource handle.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
@@ -764,7 +1301,21 @@ vcjson_value_create_from_false(
     vcjson_value** value, RCPR_SYM(allocator)* alloc);
 
 /**
- * \brief Create a deep copy of the given \ref vcjson_value instance.
+ * \brief Create a copy of the given \ref vcjson_value instance.
+ *
+ * Objects and arrays are not copied. Instead, the copy shares them with the
+ * original, so copying takes constant time regardless of the size of the
+ * value. A shared object or array can be read through either value, but
+ * modifying it, or any container nested in it, fails with
+ * \ref ERROR_VCJSON_VALUE_SHARED. Fetching it with
+ * \ref vcjson_value_get_object_mut or \ref vcjson_value_get_array_mut gives
+ * that value its own copy of the container's top level. Each nested
+ * container on the path to a modified member must in turn be fetched with
+ * these functions before it is modified, so only that path is copied. Objects
+ * and arrays held in a compact copy made with \ref vcjson_value_copy_compact
+ * are read-only, so they are copied in full instead of shared. Containers are
+ * also copied in full when \p alloc is not the allocator that owns them, so
+ * that the copy never depends on the lifetime of another allocator.
  *
  * \note On success, this function creates a \ref vcjson_value instance. This
  * value instance is a resource that is owned by the caller. When no longer
@@ -783,6 +1334,39 @@ status FN_DECL_MUST_CHECK
 vcjson_value_copy(
     vcjson_value** value, RCPR_SYM(allocator)* alloc, const vcjson_value* orig);
 
+/**
+ * \brief Create a deep copy of the given \ref vcjson_value instance in a
+ * single allocation.
+ *
+ * The size of the whole copy is measured first, and the copy is then laid out
+ * in one block in depth-first order, so that it is created with a single
+ * allocation and released with a single reclaim. Objects in the copy use flat
+ * or hash storage, and arrays of numbers keep their packed numbers. Strings
+ * keep the sensitivity that they have when the copy is made.
+ *
+ * Objects and arrays in a compact copy are read-only; modifying them fails
+ * with ERROR_VCJSON_VALUE_SHARED. Their emitted forms are not memoized. A
+ * value copied from a compact copy with \ref vcjson_value_copy is an ordinary
+ * value that can be modified.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. This
+ * value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle. Values fetched from the copy must be released before
+ * it.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param orig          The original value to copy.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_copy_compact(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, const vcjson_value* orig);
+
 /**
  * \brief Get the value type of this \ref vcjson_value instance.
  *
@@ -792,6 +1376,60 @@ vcjson_value_copy(
  */
 int vcjson_value_type(const vcjson_value* value);
 
+/**
+ * \brief Determine whether two \ref vcjson_value instances hold the same JSON
+ * content.
+ *
+ * Values are compared structurally, without emitting them. Identical and
+ * shared nodes are equal without being walked, and containers or strings whose
+ * sizes differ are unequal without being walked. Objects are equal when they
+ * hold the same keys with equal values, regardless of storage or member
+ * order, and are compared in a single merge of their sorted members. Numbers
+ * are compared by value, so 0 and -0 are equal. Neither value is modified.
+ *
+ * \param lhs           The left-hand-side value to compare.
+ * \param rhs           The right-hand-side value to compare.
+ *
+ * \returns true if these values are equal, or false otherwise.
+ */
+bool vcjson_value_equal(const vcjson_value* lhs, const vcjson_value* rhs);
+
+/**
+ * \brief Compute a hash of the JSON content of a \ref vcjson_value instance.
+ *
+ * The hash is computed from the values themselves, without emitting them, and
+ * does not depend on how a value is stored: object storage and member order,
+ * packed arrays, and the sign of zero do not change it. Values that are equal
+ * according to \ref vcjson_value_equal have the same hash. The hash is stable
+ * across processes, so it may be used as a persistent cache key, but it is not
+ * a cryptographic digest; see \ref vcjson_emit_canonical_sha256 for one.
+ *
+ * \param value         The value to hash.
+ *
+ * \returns the 64-bit hash of this value.
+ */
+uint64_t vcjson_value_hash(const vcjson_value* value);
+
+/**
+ * \brief Mark every string in this \ref vcjson_value instance as sensitive.
+ *
+ * A string value is marked directly. For an object or array, every string
+ * value and key within it is marked, at any depth. Emitted forms of this value
+ * and of its containers that are cached are marked as well, so that they are
+ * wiped when they are reset.
+ *
+ * \note Objects and arrays that this value shares with its copies are marked
+ * for every copy.
+ *
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_set_sensitive(vcjson_value* value);
+
 /**
  * \brief Attempt to get the \ref vcjson_object value of this \ref vcjson_value
  * instance.
@@ -801,6 +1439,12 @@ int vcjson_value_type(const vcjson_value* value);
  * value instance and the lifetime of this value is the same as the lifetime of
  * this instance.
  *
+ * This never modifies \p value. If the object is shared with copies of this
+ * value, or is held in a container that is, modifying it fails with
+ * \ref ERROR_VCJSON_VALUE_SHARED. To modify it, fetch it with
+ * \ref vcjson_value_get_object_mut, after fetching each container holding
+ * it the same way.
+ *
  * \param object        Pointer to the object pointer to hold the object value
  *                      on success.
  * \param value         The value instance for this operation.
@@ -822,6 +1466,12 @@ vcjson_value_get_object(vcjson_object** object, vcjson_value* value);
  * value instance and the lifetime of this value is the same as the lifetime of
  * this instance.
  *
+ * This never modifies \p value. If the array is shared with copies of this
+ * value, or is held in a container that is, modifying it fails with
+ * \ref ERROR_VCJSON_VALUE_SHARED. To modify it, fetch it with
+ * \ref vcjson_value_get_array_mut, after fetching each container holding it the
+ * same way.
+ *
  * \param arr           Pointer to the array pointer to hold the array value
  *                      on success.
  * \param value         The value instance for this operation.
@@ -834,6 +1484,64 @@ vcjson_value_get_object(vcjson_object** object, vcjson_value* value);
 status FN_DECL_MUST_CHECK
 vcjson_value_get_array(vcjson_array** arr, vcjson_value* value);
 
+/**
+ * \brief Attempt to get the \ref vcjson_object value of this \ref vcjson_value
+ * instance, so that it can be modified.
+ *
+ * \note On success, this function sets the object pointer to the object value
+ * of this \ref vcjson_value instance. This pointer is to a value owned by this
+ * value instance and the lifetime of this value is the same as the lifetime of
+ * this instance.
+ *
+ * If the object is shared with copies of this value, this value is first given
+ * its own copy of the object. Only the top level of the object is copied; its
+ * members remain shared until they are in turn fetched with this function.
+ * Every container holding this value must already have been fetched this way,
+ * so that it is not shared.
+ *
+ * \param object        Pointer to the object pointer to hold the object value
+ *                      on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an object.
+ *      - ERROR_VCJSON_VALUE_SHARED if a container holding this value is
+ *        shared.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_get_object_mut(vcjson_object** object, vcjson_value* value);
+
+/**
+ * \brief Attempt to get the \ref vcjson_array value of this \ref vcjson_value
+ * instance, so that it can be modified.
+ *
+ * \note On success, this function sets the array pointer to the array value
+ * of this \ref vcjson_value instance. This pointer is to a value owned by this
+ * value instance and the lifetime of this value is the same as the lifetime of
+ * this instance.
+ *
+ * If the array is shared with copies of this value, this value is first given
+ * its own copy of the array. Only the top level of the array is copied; its
+ * members remain shared until they are in turn fetched with this function.
+ * Every container holding this value must already have been fetched this way,
+ * so that it is not shared.
+ *
+ * \param arr           Pointer to the array pointer to hold the array value
+ *                      on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an array.
+ *      - ERROR_VCJSON_VALUE_SHARED if a container holding this value is
+ *        shared.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_get_array_mut(vcjson_array** arr, vcjson_value* value);
+
 /**
  * \brief Attempt to get the \ref vcjson_number value of this \ref vcjson_value
  * instance.
@@ -906,6 +1614,57 @@ vcjson_value_get_bool(vcjson_bool** boolean, vcjson_value* value);
  */
 RCPR_SYM(resource)* vcjson_value_resource_handle(vcjson_value* value);
 
+/**
+ * \brief Create a \ref vcjson_pool instance using the given allocator.
+ *
+ * A pool holds free lists of small, fixed-size nodes, carved from slabs of
+ * \ref VCJSON_POOL_SLAB_SIZE bytes that are allocated from \p alloc. While a
+ * pool is attached to a thread with \ref vcjson_pool_attach, values, numbers,
+ * short strings, object elements, and object iterators that this thread
+ * creates with \p alloc are taken from the pool, and are returned to it when
+ * released.
+ *
+ * \note On success, this function creates a \ref vcjson_pool instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. Every node taken from the pool must be released before the pool is;
+ * until then, releasing the pool fails with \ref ERROR_VCJSON_POOL_IN_USE and
+ * leaves it intact. Nodes are only taken from a pool by the thread it is
+ * attached to, so it should be attached to one thread at a time. Its nodes may
+ * be released on any thread; those released elsewhere are handed back to the
+ * attached thread through a lock-free list.
+ *
+ * \param pool          Pointer to the pool pointer to hold this pool.
+ * \param alloc         The allocator to use for this pool's slabs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_create(vcjson_pool** pool, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Attach the given \ref vcjson_pool to the calling thread.
+ *
+ * Nodes that this thread creates with the pool's allocator are then taken
+ * from this pool, including the nodes created by \ref vcjson_parse.
+ *
+ * \param pool          The pool to attach, or NULL to detach the current pool.
+ *
+ * \returns the pool that was previously attached to this thread, or NULL.
+ */
+vcjson_pool* vcjson_pool_attach(vcjson_pool* pool);
+
+/**
+ * \brief Get the resource handle for the given \ref vcjson_pool instance.
+ *
+ * \param pool          The instance for this accessor.
+ *
+ * \returns the resource handle for this instance.
+ */
+RCPR_SYM(resource)* vcjson_pool_resource_handle(vcjson_pool* pool);
+
 /**
  * \brief Attempt to parse a JSON value from a UTF-8 character buffer.
  *
@@ -930,6 +1689,75 @@ vcjson_parse(
     vcjson_value** value, size_t* error_begin, size_t* error_end,
     RCPR_SYM(allocator)* alloc, const char* input, size_t size);
 
+/**
+ * \brief Attempt to parse a JSON value from a UTF-8 character buffer, using
+ * the given \ref vcjson_parse_flags.
+ *
+ * With \ref VCJSON_PARSE_FLAG_INSERTION_ORDER, every parsed object walks its
+ * members in the order in which they appear in the input, as if by
+ * \ref vcjson_object_set_insertion_order.
+ *
+ * With \ref VCJSON_PARSE_FLAG_SENSITIVE, every parsed string and key is
+ * sensitive, as if by \ref vcjson_string_set_sensitive, and the parser wipes
+ * its working buffers.
+ *
+ * \note This parse function must consume all input to be successful.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param error_begin   Pointer to receive the start of an error location on
+ *                      failure.
+ * \param error_end     Pointer to receive the end of an error location on
+ *                      failure.
+ * \param alloc         The allocator to use for this operation.
+ * \param input         The input UTF-8 character buffer.
+ * \param size          The size of this buffer.
+ * \param flags         The \ref vcjson_parse_flags for this parse.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_parse_with_flags(
+    vcjson_value** value, size_t* error_begin, size_t* error_end,
+    RCPR_SYM(allocator)* alloc, const char* input, size_t size,
+    uint32_t flags);
+
+/**
+ * \brief Attempt to parse a JSON value from a UTF-8 character buffer, marking
+ * the members with the given keys as sensitive.
+ *
+ * The value of every object member whose key is in \p keys is sensitive, as
+ * if by \ref vcjson_value_set_sensitive, at any depth in the document. The
+ * parser wipes its working buffers only while reading these values. The keys
+ * themselves are not sensitive, unless they are within a sensitive value.
+ *
+ * \note This parse function must consume all input to be successful.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param error_begin   Pointer to receive the start of an error location on
+ *                      failure.
+ * \param error_end     Pointer to receive the end of an error location on
+ *                      failure.
+ * \param alloc         The allocator to use for this operation.
+ * \param input         The input UTF-8 character buffer.
+ * \param size          The size of this buffer.
+ * \param flags         The \ref vcjson_parse_flags for this parse.
+ * \param keys          The keys of the sensitive members.
+ * \param key_count     The number of keys in \p keys.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_parse_with_sensitive_keys(
+    vcjson_value** value, size_t* error_begin, size_t* error_end,
+    RCPR_SYM(allocator)* alloc, const char* input, size_t size,
+    uint32_t flags, const char* const* keys, size_t key_count);
+
 /**
  * \brief Attempt to parse a JSON value from a UTF-8 string.
  *
@@ -953,6 +1781,47 @@ vcjson_parse_string(
     vcjson_value** value, size_t* error_begin, size_t* error_end,
     RCPR_SYM(allocator)* alloc, const char* input);
 
+/**
+ * \brief Attempt to parse a JSON value from an RFC 8949 CBOR buffer, using
+ * the given \ref vcjson_parse_flags.
+ *
+ * Integers and floating point numbers of every width become numbers, text
+ * strings become strings, and maps with text string keys become objects.
+ * Arrays holding only numbers become packed arrays. Both definite and
+ * indefinite-length items are accepted. Tags are skipped, and the undefined
+ * simple value becomes null. Byte strings, keys that are not text strings,
+ * other simple values, and numbers that are not finite have no JSON form and
+ * are not supported.
+ *
+ * The flags have the same meaning as for \ref vcjson_parse_with_flags.
+ *
+ * \note This parse function must consume all input to be successful.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param error_offset  Pointer to receive the offset of the data item at which
+ *                      parsing failed, on failure.
+ * \param alloc         The allocator to use for this operation.
+ * \param input         The input CBOR buffer.
+ * \param size          The size of this buffer.
+ * \param flags         The \ref vcjson_parse_flags for this parse.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_CBOR_TRUNCATED if the input ends within a data item.
+ *      - ERROR_VCJSON_CBOR_MALFORMED if the input is not well-formed CBOR, or
+ *        if data follows the first data item.
+ *      - ERROR_VCJSON_CBOR_UNSUPPORTED if a data item has no JSON form.
+ *      - ERROR_VCJSON_OBJECT_DUPLICATE_KEY if a map repeats a key.
+ *      - ERROR_VCJSON_PARSE_RECURSION_DEPTH_EXCEEDED if the input nests
+ *        deeper than \ref VCJSON_PARSER_MAXIMUM_RECURSION_DEPTH.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_parse_cbor(
+    vcjson_value** value, size_t* error_offset, RCPR_SYM(allocator)* alloc,
+    const void* input, size_t size, uint32_t flags);
+
 /**
  * \brief Emit a JSON value as a string.
  *
@@ -971,6 +1840,541 @@ status FN_DECL_MUST_CHECK
 vcjson_emit_string(
     vcjson_string** string, RCPR_SYM(allocator)* alloc, vcjson_value* value);
 
+/**
+ * \brief Emit a JSON value into a caller-provided buffer.
+ *
+ * This function performs no allocation. The emitted JSON text is written
+ * directly to the given buffer, which is not ASCII zero terminated. The number
+ * of bytes required to hold the emitted value is always written to \p needed,
+ * so a caller can query the required size by passing a NULL buffer with a zero
+ * length.
+ *
+ * \note If the buffer is too small, then the contents of the buffer are
+ * unspecified, and this function returns \ref ERROR_VCJSON_EMIT_BUFFER_OVERRUN.
+ *
+ * \param value         The JSON value to emit.
+ * \param buf           The buffer to receive the JSON text. May be NULL if
+ *                      \p buflen is 0.
+ * \param buflen        The size of this buffer.
+ * \param needed        Pointer to receive the size of the emitted JSON text.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_BUFFER_OVERRUN if the buffer is too small.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_buffer(
+    vcjson_value* value, char* buf, size_t buflen, size_t* needed);
+
+/**
+ * \brief Emit a JSON value as a scatter/gather list.
+ *
+ * Punctuation, escapes, numbers, and short string runs are copied into a
+ * scratch area owned by the list. Unescaped runs of string data that are at
+ * least \ref VCJSON_EMIT_IOVEC_REFERENCE_MINIMUM bytes long are not copied;
+ * instead, their iovec entries point directly at the storage of the
+ * \ref vcjson_string instances in \p value. The resulting vector can be passed
+ * to writev or sendmsg.
+ *
+ * \note On success, this function creates a list that is owned by the caller.
+ * This list is a resource that must be released when no longer in use. Since
+ * the list refers to string storage in \p value, the list is only valid until
+ * \p value is modified or released.
+ *
+ * \param list          Pointer to the list pointer to hold the iovec list.
+ * \param alloc         The allocator to use for this operation.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_iovec(
+    vcjson_iovec_list** list, RCPR_SYM(allocator)* alloc, vcjson_value* value);
+
+/**
+ * \brief Get the iovec vector for the given \ref vcjson_iovec_list instance.
+ *
+ * \note The number of entries may exceed IOV_MAX for large documents, in which
+ * case the caller must write the vector in batches.
+ *
+ * \param list          The instance for this accessor.
+ * \param count         Pointer to receive the number of iovec entries.
+ *
+ * \returns the iovec vector for this instance.
+ */
+const struct iovec* vcjson_iovec_list_vector(
+    const vcjson_iovec_list* list, size_t* count);
+
+/**
+ * \brief Get the resource handle for the given \ref vcjson_iovec_list
+ * instance.
+ *
+ * \param list          The instance for this accessor.
+ *
+ * \returns the resource handle for this instance.
+ */
+RCPR_SYM(resource)* vcjson_iovec_list_resource_handle(vcjson_iovec_list* list);
+
+/**
+ * \brief Emit a JSON value as a string using multiple threads.
+ *
+ * Objects and arrays with more than \ref VCJSON_EMIT_PARALLEL_CHUNK_SIZE
+ * members are split into chunks, and smaller containers within
+ * \ref VCJSON_EMIT_PARALLEL_MAXIMUM_DEPTH levels of the root are descended into
+ * so that large nested containers are found. The worker threads are started
+ * once. They compute the size of each chunk in parallel, then write each chunk
+ * in parallel directly to its offset in the output string. The output is
+ * identical to \ref vcjson_emit_string. A value with no container large enough
+ * to split, or a request for a single thread, is emitted on the calling thread
+ * by \ref vcjson_emit_string instead.
+ *
+ * \note On success, this function creates a string that is owned by the caller.
+ * This string is a resource that must be released when no longer in use. The
+ * allocator is only used from the calling thread. The value must not be
+ * modified while this function runs.
+ *
+ * \param string        Pointer to the string pointer to hold the JSON string.
+ * \param alloc         The allocator to use for this operation.
+ * \param value         The JSON value to emit.
+ * \param threads       The number of threads to use, including the calling
+ *                      thread. If 0, one thread per online CPU is used.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_string_parallel(
+    vcjson_string** string, RCPR_SYM(allocator)* alloc, vcjson_value* value,
+    size_t threads);
+
+/**
+ * \brief Memoize the emitted form of every object and array in a JSON value.
+ *
+ * After this call, the emit functions copy the memoized bytes of each
+ * container instead of formatting it again. Modifying a container with
+ * \ref vcjson_object_put, \ref vcjson_object_remove, \ref vcjson_object_clear,
+ * or \ref vcjson_array_set invalidates the memoized form of that container and
+ * of every container above it. Containers that are still memoized are skipped
+ * by this function, so updating a document after a change only formats the
+ * containers along the changed path.
+ *
+ * \note Memoized bytes are allocated using the allocator of each container and
+ * are released along with it.
+ *
+ * \param value         The JSON value to update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_update(vcjson_value* value);
+
+/**
+ * \brief Emit a JSON value in RFC 8785 (JCS) canonical form to a sink.
+ *
+ * Numbers are formatted using the shortest round-trip ECMAScript form, strings
+ * use the minimal JCS escapes, and object members are ordered by the UTF-16
+ * code units of their keys. The emitted text is passed to \p sink in pieces of
+ * up to a few kilobytes and is never held in memory as a whole.
+ *
+ * \note Memoized forms created by \ref vcjson_emit_cache_update are not used,
+ * since they are not canonical.
+ *
+ * \param value         The JSON value to emit.
+ * \param sink          The sink function to receive the emitted text.
+ * \param context       The user context to pass to the sink function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_NUMBER_FORMAT if a number is not finite.
+ *      - a non-zero error code on failure, including any error returned by the
+ *        sink function.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_canonical(
+    vcjson_value* value, vcjson_emit_sink_fn sink, void* context);
+
+/**
+ * \brief Compute the SHA-256 digest of the RFC 8785 canonical form of a JSON
+ * value.
+ *
+ * The canonical text is fed to the digest as it is emitted, so it is never
+ * held in memory as a whole.
+ *
+ * \param digest        Buffer to receive the \ref VCJSON_SHA256_DIGEST_SIZE
+ *                      byte digest.
+ * \param value         The JSON value to digest.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_canonical_sha256(uint8_t* digest, vcjson_value* value);
+
+/**
+ * \brief Emit a JSON value as RFC 8949 CBOR to a sink.
+ *
+ * Every container is emitted with a definite length, and each number uses
+ * the preferred serialization: integral numbers within the 64-bit range are
+ * emitted as CBOR integers, and other numbers use the shortest of the half,
+ * single, and double precision forms that holds them exactly. Object members
+ * are emitted in the order in which the object walks them. The emitted bytes
+ * are passed to \p sink in pieces of up to a few kilobytes and are never held
+ * in memory as a whole.
+ *
+ * \param value         The JSON value to emit.
+ * \param sink          The sink function to receive the emitted bytes.
+ * \param context       The user context to pass to the sink function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_NUMBER_FORMAT if a number is not finite.
+ *      - a non-zero error code on failure, including any error returned by the
+ *        sink function.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cbor(
+    vcjson_value* value, vcjson_emit_sink_fn sink, void* context);
+
+/**
+ * \brief Freeze the given \ref vcjson_value instance into a contiguous,
+ * read-only tape.
+ *
+ * The tape is a single block holding an entry for every value, followed by the
+ * characters of every string. Each object's members are stored as key and
+ * value entry pairs sorted by key, so that members are found by binary search,
+ * and each array's elements are stored as consecutive entries. Identical
+ * strings, such as keys repeated across objects, are stored once. Entries
+ * refer to their characters, members, and elements by relative offsets, so
+ * the tape does not depend on where it is placed in memory.
+ *
+ * A frozen value is read with the \ref vcjson_frozen_value_get_object family
+ * of accessors, which mirror those of \ref vcjson_value. Since it is never
+ * modified, it may be read from any number of threads without locking, and it
+ * is released with a single reclaim. Strings keep the sensitivity that they
+ * have when the value is frozen, and the tape is wiped when it is released if
+ * it holds a sensitive string.
+ *
+ * \note On success, this function creates a \ref vcjson_frozen instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. Frozen values read from it share its lifetime. The value is not
+ * modified.
+ *
+ * \param frozen        Pointer to the frozen pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param value         The value to freeze.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_FREEZE_TOO_LARGE if a string, object, or array is too
+ *        large to be frozen.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_freeze(
+    vcjson_frozen** frozen, RCPR_SYM(allocator)* alloc, vcjson_value* value);
+
+/**
+ * \brief Get the resource handle for the given \ref vcjson_frozen instance.
+ *
+ * \param frozen        The instance for this accessor.
+ *
+ * \returns the resource handle for this instance.
+ */
+RCPR_SYM(resource)* vcjson_frozen_resource_handle(vcjson_frozen* frozen);
+
+/**
+ * \brief Get the root value of the given \ref vcjson_frozen instance.
+ *
+ * \note The returned value is owned by this instance and shares its lifetime.
+ *
+ * \param frozen        The frozen instance for this operation.
+ *
+ * \returns the root value of this instance.
+ */
+const vcjson_frozen_value* vcjson_frozen_root(const vcjson_frozen* frozen);
+
+/**
+ * \brief Get the value type of this \ref vcjson_frozen_value instance.
+ *
+ * \param value         The value instance for this operation.
+ *
+ * \returns the value type for this instance.
+ */
+int vcjson_frozen_value_type(const vcjson_frozen_value* value);
+
+/**
+ * \brief Attempt to get the object value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \note On success, this function sets the object pointer to the object held by
+ * this value. This pointer is owned by the frozen instance holding this value,
+ * and shares its lifetime.
+ *
+ * \param obj           Pointer to the object pointer to hold the object
+ *                      on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an object.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_object(
+    const vcjson_frozen_object** obj, const vcjson_frozen_value* value);
+
+/**
+ * \brief Attempt to get the array value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \note On success, this function sets the array pointer to the array held by
+ * this value. This pointer is owned by the frozen instance holding this value,
+ * and shares its lifetime.
+ *
+ * \param arr           Pointer to the array pointer to hold the array on
+ *                      success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an array.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_array(
+    const vcjson_frozen_array** arr, const vcjson_frozen_value* value);
+
+/**
+ * \brief Attempt to get the number value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \param number        Pointer to receive the number on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not a number.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_number(
+    double* number, const vcjson_frozen_value* value);
+
+/**
+ * \brief Attempt to get the string value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \note On success, this function sets the string pointer to the ASCIIZ
+ * characters of this string. They are owned by the frozen instance holding
+ * this value, and share its lifetime.
+ *
+ * \param str           Pointer to receive the characters on success.
+ * \param length        Pointer to receive the length of the string, excluding
+ *                      its terminating NUL, on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not a string.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_string(
+    const char** str, size_t* length, const vcjson_frozen_value* value);
+
+/**
+ * \brief Attempt to get the boolean value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \param boolean       Pointer to receive the boolean on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not a boolean.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_bool(
+    bool* boolean, const vcjson_frozen_value* value);
+
+/**
+ * \brief Get the number of members in the given \ref vcjson_frozen_object
+ * instance.
+ *
+ * \param obj           The object instance for this operation.
+ *
+ * \returns the number of members in this object.
+ */
+size_t vcjson_frozen_object_elements(const vcjson_frozen_object* obj);
+
+/**
+ * \brief Get a value from the \ref vcjson_frozen_object instance using the
+ * given key bytes.
+ *
+ * Members are stored in sorted key order, so the key is found by binary
+ * search.
+ *
+ * \note The returned value is owned by the frozen instance holding this
+ * object, and shares its lifetime.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The key bytes for this operation.
+ * \param length        The length of the key, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_object_get_raw(
+    const vcjson_frozen_value** value, const vcjson_frozen_object* obj,
+    const char* key, size_t length);
+
+/**
+ * \brief Get a value from the \ref vcjson_frozen_object instance using the
+ * given C string key.
+ *
+ * \note The returned value is owned by the frozen instance holding this
+ * object, and shares its lifetime.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The NUL-terminated key for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_object_get_cstr(
+    const vcjson_frozen_value** value, const vcjson_frozen_object* obj,
+    const char* key);
+
+/**
+ * \brief Get the member at the given position of the
+ * \ref vcjson_frozen_object instance.
+ *
+ * Members are stored in sorted key order, so walking the positions from zero
+ * visits the members in the order in which an object emits them.
+ *
+ * \note The returned key and value are owned by the frozen instance holding
+ * this object, and share its lifetime.
+ *
+ * \param key           Pointer to receive the ASCIIZ key on success.
+ * \param length        Pointer to receive the length of the key on success.
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param offset        The position of the member to get.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ITERATOR_END if \p offset is past the last member.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_object_member(
+    const char** key, size_t* length, const vcjson_frozen_value** value,
+    const vcjson_frozen_object* obj, size_t offset);
+
+/**
+ * \brief Get the number of elements in the given \ref vcjson_frozen_array
+ * instance.
+ *
+ * \param arr           The array instance for this operation.
+ *
+ * \returns the number of elements in this array.
+ */
+size_t vcjson_frozen_array_size(const vcjson_frozen_array* arr);
+
+/**
+ * \brief Get the value at the given offset of the \ref vcjson_frozen_array
+ * instance.
+ *
+ * \note The returned value is owned by the frozen instance holding this array,
+ * and shares its lifetime.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param arr           The array instance for this operation.
+ * \param offset        The offset of the element to get.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is past the end of
+ *        this array.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_array_get(
+    const vcjson_frozen_value** value, const vcjson_frozen_array* arr,
+    size_t offset);
+
+/**
+ * \brief Write the given \ref vcjson_frozen instance to a sink as a snapshot.
+ *
+ * A snapshot is a versioned header followed by the tape, as it is held in
+ * memory. The header holds checksums of itself and of the tape. A snapshot can
+ * later be mapped with \ref vcjson_frozen_snapshot_map and read in place,
+ * without parsing. Snapshots are specific to the byte order of the host that
+ * wrote them.
+ *
+ * \param frozen        The frozen instance to write.
+ * \param sink          The sink that receives the snapshot.
+ * \param context       The user context for this sink.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_SNAPSHOT_SENSITIVE if the tape holds a sensitive string,
+ *        which must not be written out.
+ *      - a non-zero error code on failure, including any error returned by the
+ *        sink function.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_snapshot_write(
+    const vcjson_frozen* frozen, vcjson_emit_sink_fn sink, void* context);
+
+/**
+ * \brief Map a snapshot written by \ref vcjson_frozen_snapshot_write as a
+ * \ref vcjson_frozen instance.
+ *
+ * The file is mapped read-only, and its header is validated: its magic,
+ * version, byte order, size, and checksum must all match. Unless
+ * \ref VCJSON_SNAPSHOT_FLAG_NO_VERIFY is given, the checksum of the tape is
+ * verified as well. The structure of the tape is always checked in one pass
+ * over its entries: every type tag must be known, every object key must be a
+ * string, and every member, element, and string must lie inside the tape.
+ * The tape is then read in place through the mapping, so no part of the
+ * snapshot is parsed or copied.
+ *
+ * \note On success, this function creates a \ref vcjson_frozen instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle, which unmaps the file. Checksums detect a corrupt or truncated
+ * file, and the structural checks keep a tape that passes them from being read
+ * outside of the mapping.
+ *
+ * \param frozen        Pointer to the frozen pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param path          The path of the snapshot file.
+ * \param flags         Any combination of \ref vcjson_snapshot_flags.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_SNAPSHOT_IO if the file could not be opened or mapped.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_HEADER if the file is not a snapshot of
+ *        this version and byte order, or is truncated.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_CHECKSUM if the tape is corrupt.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_TAPE if the tape is not laid out as a
+ *        frozen value.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_snapshot_map(
+    vcjson_frozen** frozen, RCPR_SYM(allocator)* alloc, const char* path,
+    uint32_t flags);
+
 #if defined(__cplusplus)
 }
 #endif /* defined(__cplusplus) */
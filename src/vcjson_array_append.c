@@ -0,0 +1,32 @@
+/**
+ * \file vcjson_array_append.c
+ *
+ * \brief Append a value to an array.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Append a value to the end of the given \ref vcjson_array.
+ *
+ * \note On success, this array instance takes ownership of the given \ref
+ * vcjson_value instance. On failure, the value remains owned by the caller.
+ *
+ * \param arr           The array instance for this operation.
+ * \param value         The value to append.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_append(vcjson_array* arr, vcjson_value* value)
+{
+    return vcjson_array_insert(arr, arr->elems, value);
+}
@@ -11,9 +11,6 @@
 
 #include "vcjson_internal.h"
 
-RCPR_IMPORT_rbtree;
-RCPR_IMPORT_resource;
-
 /**
  * \brief Make a deep copy of the given \ref vcjson_array.
  *
@@ -34,54 +31,5 @@ status FN_DECL_MUST_CHECK
 vcjson_array_copy(
     vcjson_array** arr, RCPR_SYM(allocator)* alloc, const vcjson_array* orig)
 {
-    status retval, release_retval;
-    vcjson_array* tmp;
-    vcjson_value* value;
-
-    /* create a new array that is the same size as the original array. */
-    retval = vcjson_array_create(&tmp, alloc, orig->elems);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-    /* iterate through all array members. */
-    for (size_t i = 0; i < orig->elems; ++i)
-    {
-        /* duplicate the value of this array member. */
-        retval = vcjson_value_copy(&value, alloc, orig->arr[i]);
-        if (STATUS_SUCCESS != retval)
-        {
-            goto cleanup_tmp;
-        }
-
-        /* set this value in the new array. */
-        retval = vcjson_array_set(tmp, i, value);
-        if (STATUS_SUCCESS != retval)
-        {
-            goto cleanup_value;
-        }
-    }
-
-    /* Success. Recursive deep copy complete. */
-    *arr = tmp;
-    retval = STATUS_SUCCESS;
-    goto done;
-
-cleanup_value:
-    release_retval = resource_release(&value->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
+    return vcjson_array_copy_with(arr, alloc, orig, &vcjson_value_copy_deep);
 }
@@ -55,6 +55,9 @@ vcjson_array_create(
     /* set initial values. */
     tmp->alloc = alloc;
     tmp->elems = size;
+    tmp->capacity = size;
+    tmp->cache.alloc = alloc;
+    tmp->cache.shares = &tmp->shares;
 
     /* get the null value. */
     vcjson_value* nullval;
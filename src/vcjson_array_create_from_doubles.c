@@ -0,0 +1,107 @@
+/**
+ * \file vcjson_array_create_from_doubles.c
+ *
+ * \brief Create a packed array of numbers.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a packed \ref vcjson_array holding the given numbers.
+ *
+ * A packed array stores its numbers contiguously instead of as a value per
+ * element. \ref vcjson_array_get_doubles gives direct access to them, and
+ * \ref vcjson_array_get boxes an element into a value the first time it is
+ * requested. Modifying a packed array converts it to an array of values. The
+ * parser creates packed arrays for arrays that hold only numbers.
+ *
+ * \note On success, this function creates a \ref vcjson_array instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle.
+ *
+ * \param arr           Pointer to the array pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param numbers       The numbers to copy into this array.
+ * \param size          The number of numbers.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_create_from_doubles(
+    vcjson_array** arr, RCPR_SYM(allocator)* alloc, const double* numbers,
+    size_t size)
+{
+    status retval, release_retval;
+    vcjson_array* tmp;
+
+    /* an empty array has nothing to pack. */
+    if (0 == size)
+    {
+        return vcjson_array_create(arr, alloc, 0);
+    }
+
+    /* verify that the packed storage size does not overflow. */
+    if (size > SIZE_MAX / sizeof(*numbers))
+    {
+        retval = ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* attempt to allocate memory for this array instance. */
+    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear instance. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcjson_array_resource_release);
+
+    /* set initial values; values are boxed on demand. */
+    tmp->alloc = alloc;
+    tmp->elems = size;
+    tmp->capacity = size;
+    tmp->cache.alloc = alloc;
+    tmp->cache.shares = &tmp->shares;
+
+    /* attempt to allocate memory for the packed numbers. */
+    retval =
+        allocator_allocate(
+            alloc, (void**)&tmp->numbers, size * sizeof(*numbers));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* copy the numbers. */
+    memcpy(tmp->numbers, numbers, size * sizeof(*numbers));
+
+    /* success. */
+    *arr = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_tmp:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
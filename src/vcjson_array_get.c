@@ -11,11 +11,17 @@
 
 #include "vcjson_internal.h"
 
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
 /**
  * \brief Get the value of the \ref vcjson_array instance at the given offset.
  *
  * \note On success, the value at the given offset of the array is returned.
- * This value remains owned by this array instance.
+ * This value remains owned by this array instance. An element of a packed
+ * number array is boxed into a value the first time it is requested, so this
+ * can allocate even though it does not modify the array. Boxing is safe when
+ * the array is read on several threads at once.
  *
  * \param value         Pointer to the value pointer to receive this value. Note
  *                      that this value is owned by the array instance.
@@ -24,18 +30,92 @@
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is past the end
+ *        of this array.
+ *      - ERROR_GENERAL_OUT_OF_MEMORY if boxing an element of a packed number
+ *        array fails to allocate.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
 vcjson_array_get(vcjson_value** value, vcjson_array* arr, size_t offset)
 {
+    status retval;
+    vcjson_value** boxed;
+    vcjson_value** expected_table = NULL;
+    vcjson_value* number;
+    vcjson_value* expected_number = NULL;
+
     /* array bounds check. */
     if (offset >= arr->elems)
     {
         return ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS;
     }
 
+    /* an array of values holds its elements directly. */
+    if (NULL == arr->numbers)
+    {
+        *value = arr->arr[offset];
+        return STATUS_SUCCESS;
+    }
+
+    /* A packed array boxes its numbers on demand. Since a shared array may be
+     * read on several threads at once, the table of boxed values and each
+     * boxed value are installed with a compare and swap, and a thread that
+     * loses the race releases its own. */
+    boxed = __atomic_load_n(&arr->arr, __ATOMIC_ACQUIRE);
+    if (NULL == boxed)
+    {
+        retval =
+            allocator_allocate(
+                arr->alloc, (void**)&boxed, arr->elems * sizeof(*boxed));
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        memset(boxed, 0, arr->elems * sizeof(*boxed));
+
+        if (!__atomic_compare_exchange_n(
+                &arr->arr, &expected_table, boxed, false, __ATOMIC_ACQ_REL,
+                __ATOMIC_ACQUIRE))
+        {
+            retval = allocator_reclaim(arr->alloc, boxed);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            boxed = expected_table;
+        }
+    }
+
+    /* box this number if it has not been boxed yet. */
+    number = __atomic_load_n(&boxed[offset], __ATOMIC_ACQUIRE);
+    if (NULL == number)
+    {
+        retval =
+            vcjson_value_create_number(
+                &number, arr->alloc, arr->numbers[offset]);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        if (!__atomic_compare_exchange_n(
+                &boxed[offset], &expected_number, number, false,
+                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            retval = resource_release(vcjson_value_resource_handle(number));
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            number = expected_number;
+        }
+    }
+
     /* return the value at the given offset. */
-    *value = arr->arr[offset];
+    *value = number;
     return STATUS_SUCCESS;
 }
@@ -0,0 +1,39 @@
+/**
+ * \file vcjson_array_get_doubles.c
+ *
+ * \brief Get the numbers of a packed array.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the numbers of a packed \ref vcjson_array.
+ *
+ * \note On success, the numbers pointer refers to the storage of this array,
+ * holding \ref vcjson_array_size numbers. It remains valid until the array is
+ * modified or released.
+ *
+ * \param numbers       Pointer to receive the numbers of this array.
+ * \param arr           The array instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ARRAY_NOT_PACKED if this array is not a packed number
+ *        array.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_get_doubles(const double** numbers, const vcjson_array* arr)
+{
+    /* only a packed array has contiguous numbers. */
+    if (NULL == arr->numbers)
+    {
+        return ERROR_VCJSON_ARRAY_NOT_PACKED;
+    }
+
+    *numbers = arr->numbers;
+    return STATUS_SUCCESS;
+}
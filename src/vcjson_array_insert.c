@@ -0,0 +1,81 @@
+/**
+ * \file vcjson_array_insert.c
+ *
+ * \brief Insert a value into an array at the given index.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Insert a value into the given \ref vcjson_array at the given offset.
+ *
+ * Elements at and after \p offset move up by one. An offset equal to the size
+ * of the array appends the value.
+ *
+ * \note On success, this array instance takes ownership of the given \ref
+ * vcjson_value instance. On failure, the value remains owned by the caller.
+ *
+ * \param arr           The array instance for this operation.
+ * \param offset        The offset at which this value should be inserted.
+ * \param value         The value to insert.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is greater than
+ *        the size of the array.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_insert(vcjson_array* arr, size_t offset, vcjson_value* value)
+{
+    status retval;
+
+    /* a shared array, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* array bounds check; inserting at the end is an append. */
+    if (offset > arr->elems)
+    {
+        return ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS;
+    }
+
+    /* make room for the new element. */
+    retval = vcjson_array_reserve(arr, arr->elems + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the emitted form of this array and its parents is now stale. */
+    retval = vcjson_emit_cache_invalidate(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* move the following elements up. */
+    memmove(
+        arr->arr + offset + 1, arr->arr + offset,
+        (arr->elems - offset) * sizeof(*arr->arr));
+
+    /* set this array element to value. */
+    arr->arr[offset] = value;
+    ++arr->elems;
+
+    /* link the value's emit cache to this array. */
+    vcjson_emit_cache_adopt(&arr->cache, value);
+
+    return STATUS_SUCCESS;
+}
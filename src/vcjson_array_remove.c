@@ -0,0 +1,77 @@
+/**
+ * \file vcjson_array_remove.c
+ *
+ * \brief Remove the value at the given index from an array.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Remove the value at the given offset from the given
+ * \ref vcjson_array.
+ *
+ * The removed value is released using \ref resource_release, and elements
+ * after \p offset move down by one.
+ *
+ * \param arr           The array instance for this operation.
+ * \param offset        The offset of the value to remove.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is not less than
+ *        the size of the array.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_remove(vcjson_array* arr, size_t offset)
+{
+    status retval;
+    vcjson_value* oldvalue;
+
+    /* a shared array, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* array bounds check. */
+    if (offset >= arr->elems)
+    {
+        return ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS;
+    }
+
+    /* a packed array is unpacked before it is modified. */
+    retval = vcjson_array_unpack(arr);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the emitted form of this array and its parents is now stale. */
+    retval = vcjson_emit_cache_invalidate(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* move the following elements down. */
+    oldvalue = arr->arr[offset];
+    memmove(
+        arr->arr + offset, arr->arr + offset + 1,
+        (arr->elems - offset - 1) * sizeof(*arr->arr));
+    --arr->elems;
+
+    /* release the removed value. */
+    return resource_release(&oldvalue->hdr);
+}
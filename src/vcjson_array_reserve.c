@@ -0,0 +1,92 @@
+/**
+ * \file vcjson_array_reserve.c
+ *
+ * \brief Reserve room for elements in an array.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stdint.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Ensure that the given \ref vcjson_array can hold at least the given
+ * number of elements without growing.
+ *
+ * \note Capacity grows geometrically, so calling this before each append keeps
+ * building an array amortized constant time per element. The size of the
+ * array is not changed, but a packed number array is unpacked.
+ *
+ * \param arr           The array instance for this operation.
+ * \param capacity      The number of elements required.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_reserve(vcjson_array* arr, size_t capacity)
+{
+    status retval;
+    size_t new_capacity;
+
+    /* a shared array, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* a packed array is unpacked before it is modified. */
+    retval = vcjson_array_unpack(arr);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* if there is already enough room, there is nothing to do. */
+    if (capacity <= arr->capacity)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* grow geometrically, so appending stays amortized constant time. */
+    new_capacity =
+        arr->capacity > 0 ? arr->capacity : VCJSON_ARRAY_MINIMUM_CAPACITY;
+    while (new_capacity < capacity)
+    {
+        if (new_capacity > SIZE_MAX / 2)
+        {
+            new_capacity = capacity;
+            break;
+        }
+
+        new_capacity *= 2;
+    }
+
+    /* verify that the element storage size does not overflow. */
+    if (new_capacity > SIZE_MAX / sizeof(*arr->arr))
+    {
+        return ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* grow the element storage. */
+    retval =
+        allocator_reallocate(
+            arr->alloc, (void**)&arr->arr, new_capacity * sizeof(*arr->arr));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    arr->capacity = new_capacity;
+
+    return STATUS_SUCCESS;
+}
@@ -26,6 +26,12 @@ vcjson_array_resource_release(RCPR_SYM(resource)* r)
     status retval = STATUS_SUCCESS;
     vcjson_array* arr = (vcjson_array*)r;
 
+    /* a shared array is only released by the last value sharing it. */
+    if (__atomic_fetch_sub(&arr->shares, 1, __ATOMIC_ACQ_REL) > 0)
+    {
+        return STATUS_SUCCESS;
+    }
+
     /* cache allocator. */
     allocator* alloc = arr->alloc;
 
@@ -34,12 +40,42 @@ vcjson_array_resource_release(RCPR_SYM(resource)* r)
     {
         for (size_t i = 0; i < arr->elems; ++i)
         {
+            /* packed numbers that were never boxed have no value. */
+            if (NULL == arr->arr[i])
+            {
+                continue;
+            }
+
             retval = resource_release(&arr->arr[i]->hdr);
             if (STATUS_SUCCESS != retval)
             {
                 error_retval = retval;
             }
         }
+
+        /* reclaim the element storage. */
+        retval = allocator_reclaim(alloc, arr->arr);
+        if (STATUS_SUCCESS != retval)
+        {
+            error_retval = retval;
+        }
+    }
+
+    /* reclaim packed storage. */
+    if (NULL != arr->numbers)
+    {
+        retval = allocator_reclaim(alloc, arr->numbers);
+        if (STATUS_SUCCESS != retval)
+        {
+            error_retval = retval;
+        }
+    }
+
+    /* release the emit cache. */
+    retval = vcjson_emit_cache_reset(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        error_retval = retval;
     }
 
     /* clear structure. */
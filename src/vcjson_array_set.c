@@ -26,6 +26,8 @@ RCPR_IMPORT_resource;
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this array is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
@@ -33,12 +35,34 @@ vcjson_array_set(vcjson_array* arr, size_t offset, vcjson_value* value)
 {
     status retval;
 
+    /* a shared array, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
     /* array bounds check. */
     if (offset >= arr->elems)
     {
         return ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS;
     }
 
+    /* a packed array is unpacked before it is modified. */
+    retval = vcjson_array_unpack(arr);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the emitted form of this array and its parents is now stale. */
+    retval = vcjson_emit_cache_invalidate(&arr->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
     /* release the previous value. */
     retval = resource_release(&(arr->arr[offset]->hdr));
     if (STATUS_SUCCESS != retval)
@@ -48,5 +72,9 @@ vcjson_array_set(vcjson_array* arr, size_t offset, vcjson_value* value)
 
     /* set this array element to value. */
     arr->arr[offset] = value;
+
+    /* link the value's emit cache to this array. */
+    vcjson_emit_cache_adopt(&arr->cache, value);
+
     return STATUS_SUCCESS;
 }
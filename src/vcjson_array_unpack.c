@@ -0,0 +1,55 @@
+/**
+ * \file vcjson_array_unpack.c
+ *
+ * \brief Convert a packed number array to an array of values.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Convert a packed number array to an array of values, so that it can
+ * be modified.
+ *
+ * \note If the array is not packed, this does nothing.
+ *
+ * \param arr           The array instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_unpack(vcjson_array* arr)
+{
+    status retval;
+    vcjson_value* value;
+
+    /* if the array is not packed, there is nothing to do. */
+    if (NULL == arr->numbers)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* box every number that has not been boxed yet. */
+    for (size_t i = 0; i < arr->elems; ++i)
+    {
+        retval = vcjson_array_get(&value, arr, i);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* the boxed values are now the elements. */
+    retval = allocator_reclaim(arr->alloc, arr->numbers);
+    arr->numbers = NULL;
+    arr->capacity = arr->elems;
+
+    return retval;
+}
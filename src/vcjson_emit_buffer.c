@@ -0,0 +1,118 @@
+/**
+ * \file vcjson_emit_buffer.c
+ *
+ * \brief Emit a JSON value into a caller-provided buffer.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static status vcjson_emit_to_buffer(
+    void* context, const void* val, size_t size);
+
+typedef struct vcjson_emit_buffer_context vcjson_emit_buffer_context;
+struct vcjson_emit_buffer_context
+{
+    char* outbuf;
+    size_t offset;
+    size_t maxlen;
+};
+
+/**
+ * \brief Emit a JSON value into a caller-provided buffer.
+ *
+ * This function performs no allocation. The emitted JSON text is written
+ * directly to the given buffer, which is not ASCII zero terminated. The number
+ * of bytes required to hold the emitted value is always written to \p needed,
+ * so a caller can query the required size by passing a NULL buffer with a zero
+ * length.
+ *
+ * \note If the buffer is too small, then the contents of the buffer are
+ * unspecified, and this function returns \ref ERROR_VCJSON_EMIT_BUFFER_OVERRUN.
+ *
+ * \param value         The JSON value to emit.
+ * \param buf           The buffer to receive the JSON text. May be NULL if
+ *                      \p buflen is 0.
+ * \param buflen        The size of this buffer.
+ * \param needed        Pointer to receive the size of the emitted JSON text.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_BUFFER_OVERRUN if the buffer is too small.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_buffer(
+    vcjson_value* value, char* buf, size_t buflen, size_t* needed)
+{
+    status retval;
+    vcjson_emit_buffer_context ctx;
+    vcjson_emitter emitter;
+
+    /* set up the buffer emitter context. */
+    ctx.outbuf = buf;
+    ctx.offset = 0;
+    ctx.maxlen = buflen;
+
+    /* set up the buffer emitter. */
+    emitter.emit = &vcjson_emit_to_buffer;
+    emitter.emit_reference = NULL;
+    emitter.context = &ctx;
+    emitter.sensitive = NULL;
+
+    /* emit the value to the buffer, counting all bytes. */
+    retval = vcjson_emit_value(&emitter, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the offset holds the total size of the emitted value. */
+    *needed = ctx.offset;
+
+    /* verify that the emitted value fit in the buffer. */
+    if (ctx.offset > ctx.maxlen)
+    {
+        return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+    }
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write to the caller-provided buffer.
+ *
+ * Writes that do not fit in the buffer are dropped, but are still counted, so
+ * that the total size can be reported to the caller after a single pass.
+ *
+ * \param context       Opaque pointer to the buffer context.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_buffer(
+    void* context, const void* val, size_t size)
+{
+    vcjson_emit_buffer_context* ctx = (vcjson_emit_buffer_context*)context;
+
+    /* only write data that fits in the buffer. */
+    if (ctx->offset <= ctx->maxlen && size <= ctx->maxlen - ctx->offset)
+    {
+        memcpy(ctx->outbuf + ctx->offset, val, size);
+    }
+
+    /* increment offset. */
+    ctx->offset += size;
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
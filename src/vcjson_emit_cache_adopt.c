@@ -0,0 +1,41 @@
+/**
+ * \file vcjson_emit_cache_adopt.c
+ *
+ * \brief Link a child container's emit cache to its parent.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Link the cache of a child container to its parent's cache.
+ *
+ * \note If the child value is not an object or array, this does nothing. A
+ * shared child keeps its existing link unless the child value holds it.
+ *
+ * \param parent        The cache of the container adopting this value.
+ * \param child         The value being added to the container.
+ */
+void vcjson_emit_cache_adopt(vcjson_emit_cache* parent, vcjson_value* child)
+{
+    switch (child->type)
+    {
+        case VCJSON_VALUE_TYPE_OBJECT:
+            child->parent = parent;
+            vcjson_emit_cache_link(
+                &((vcjson_object*)child->value)->cache, child);
+            break;
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            child->parent = parent;
+            vcjson_emit_cache_link(
+                &((vcjson_array*)child->value)->cache, child);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,44 @@
+/**
+ * \file vcjson_emit_cache_check_exclusive.c
+ *
+ * \brief Check that a container and every container holding it are owned by
+ * a single value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Check that the container holding the given cache, and every
+ * container along its parent chain, may be modified.
+ *
+ * A container nested under a shared container is reachable from every value
+ * sharing it, so it is treated as shared as well. An unlinked container is
+ * refused too, since its ancestors are unknown until its value unshares it.
+ *
+ * \param cache         The cache of the container to check, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if no container along the chain is shared.
+ *      - ERROR_VCJSON_VALUE_SHARED if any container along the chain is
+ *        shared with a copy of its value, or is unlinked.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_check_exclusive(const vcjson_emit_cache* cache)
+{
+    for (; NULL != cache; cache = cache->parent)
+    {
+        /* the share count is read first, so that an unlinking by the last
+         * other value to release this container is seen here. */
+        if (__atomic_load_n(cache->shares, __ATOMIC_ACQUIRE) > 0
+            || cache->unlinked)
+        {
+            return ERROR_VCJSON_VALUE_SHARED;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/**
+ * \file vcjson_emit_cache_invalidate.c
+ *
+ * \brief Invalidate the memoized emitted form of a container and its parents.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Invalidate the given cache and every cache along its parent chain.
+ *
+ * This must be called before a container is modified.
+ *
+ * \param cache         The cache of the container being modified.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_invalidate(vcjson_emit_cache* cache)
+{
+    status retval;
+
+    /* A cached container only holds cached containers, since caches are
+     * populated bottom-up. So, the walk can stop at the first empty cache. */
+    while (NULL != cache && NULL != cache->data)
+    {
+        retval = vcjson_emit_cache_reset(cache);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        cache = cache->parent;
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,31 @@
+/**
+ * \file vcjson_emit_cache_link.c
+ *
+ * \brief Link a container's emit cache to the parent of the value holding it.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Link the cache of a container to the parent of the given value.
+ *
+ * The cache is linked if this value already holds its link, or if the value is
+ * the only one holding the container. A container shared with other values
+ * keeps its existing link.
+ *
+ * \param cache         The cache of the container held by \p value.
+ * \param value         The value holding the container.
+ */
+void vcjson_emit_cache_link(vcjson_emit_cache* cache, vcjson_value* value)
+{
+    if (value->linked || 0 == __atomic_load_n(cache->shares, __ATOMIC_ACQUIRE))
+    {
+        cache->parent = value->parent;
+        cache->unlinked = false;
+        value->linked = true;
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * \file vcjson_emit_cache_reset.c
+ *
+ * \brief Release the memoized emitted form of a container.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Release the memoized emitted form held by the given cache.
+ *
+ * \note Only this cache is reset; parent caches are not touched.
+ *
+ * \param cache         The cache to reset.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_reset(vcjson_emit_cache* cache)
+{
+    char* data = cache->data;
+
+    /* if there is no cached data, there is nothing to do. */
+    if (NULL == data)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* wipe the cached data if it holds a sensitive string. */
+    if (cache->sensitive)
+    {
+        memset(data, 0, cache->size);
+    }
+
+    cache->data = NULL;
+    cache->size = 0;
+    cache->sensitive = false;
+
+    /* reclaim memory. */
+    return
+        allocator_reclaim(cache->alloc, data);
+}
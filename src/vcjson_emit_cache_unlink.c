@@ -0,0 +1,32 @@
+/**
+ * \file vcjson_emit_cache_unlink.c
+ *
+ * \brief Drop the link between a container's emit cache and a value's parent.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Drop the link from the cache of a container to the parent of the
+ * given value, before the value drops its share of the container.
+ *
+ * If this value holds the link, the cache is marked as unlinked, since any
+ * remaining value holding the container has a parent of its own. That value
+ * must relink the cache by unsharing the container before modifying it.
+ *
+ * \param cache         The cache of the container held by \p value.
+ * \param value         The value holding the container.
+ */
+void vcjson_emit_cache_unlink(vcjson_emit_cache* cache, vcjson_value* value)
+{
+    if (value->linked)
+    {
+        cache->parent = NULL;
+        cache->unlinked = true;
+        value->linked = false;
+    }
+}
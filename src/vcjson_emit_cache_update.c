@@ -0,0 +1,288 @@
+/**
+ * \file vcjson_emit_cache_update.c
+ *
+ * \brief Memoize the emitted form of the containers in a JSON value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/* forward decls. */
+static status vcjson_emit_cache_update_object(
+    vcjson_value* value, vcjson_object* obj);
+static status vcjson_emit_cache_update_array(
+    vcjson_value* value, vcjson_array* arr);
+static status vcjson_emit_cache_fill(
+    vcjson_emit_cache* cache, vcjson_value* value);
+static status vcjson_emit_to_counter(
+    void* context, const void* val, size_t size);
+static status vcjson_emit_to_cache(
+    void* context, const void* val, size_t size);
+
+typedef struct vcjson_emit_cache_context vcjson_emit_cache_context;
+struct vcjson_emit_cache_context
+{
+    char* outbuf;
+    size_t offset;
+    size_t maxlen;
+};
+
+/**
+ * \brief Memoize the emitted form of every object and array in a JSON value.
+ *
+ * After this call, the emit functions copy the memoized bytes of each
+ * container instead of formatting it again. Modifying a container with
+ * \ref vcjson_object_put, \ref vcjson_object_remove, \ref vcjson_object_clear,
+ * or \ref vcjson_array_set invalidates the memoized form of that container and
+ * of every container above it. Containers that are still memoized are skipped
+ * by this function, so updating a document after a change only formats the
+ * containers along the changed path.
+ *
+ * \note Memoized bytes are allocated using the allocator of each container and
+ * are released along with it.
+ *
+ * \param value         The JSON value to update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_update(vcjson_value* value)
+{
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return
+                vcjson_emit_cache_update_object(
+                    value, (vcjson_object*)value->value);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return
+                vcjson_emit_cache_update_array(
+                    value, (vcjson_array*)value->value);
+
+        /* scalar values are not memoized. */
+        default:
+            return STATUS_SUCCESS;
+    }
+}
+
+/**
+ * \brief Memoize the emitted form of an object and its members.
+ *
+ * \param value         The value wrapping this object.
+ * \param obj           The object to update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cache_update_object(
+    vcjson_value* value, vcjson_object* obj)
+{
+    status retval;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* member;
+
+    /* if this object is memoized, so are all of its members; a compact copy
+     * is never memoized, since it is not released member by member. */
+    if (NULL != obj->cache.data || obj->compact)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* update all members first. */
+    vcjson_object_cursor_begin(&iter, obj);
+    while (vcjson_object_cursor_member(&key, &member, obj, &iter))
+    {
+        retval = vcjson_emit_cache_update(member);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        vcjson_object_cursor_next(&iter, obj);
+    }
+
+    /* memoize this object. */
+    return vcjson_emit_cache_fill(&obj->cache, value);
+}
+
+/**
+ * \brief Memoize the emitted form of an array and its elements.
+ *
+ * \param value         The value wrapping this array.
+ * \param arr           The array to update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cache_update_array(
+    vcjson_value* value, vcjson_array* arr)
+{
+    status retval;
+
+    /* if this array is memoized, so are all of its elements; a compact copy
+     * is never memoized, since it is not released element by element. */
+    if (NULL != arr->cache.data || arr->compact)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* update all elements first; packed numbers have no caches. */
+    for (size_t i = 0; NULL == arr->numbers && i < arr->elems; ++i)
+    {
+        retval = vcjson_emit_cache_update(arr->arr[i]);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* memoize this array. */
+    return vcjson_emit_cache_fill(&arr->cache, value);
+}
+
+/**
+ * \brief Emit a container into its cache.
+ *
+ * \param cache         The cache for this container.
+ * \param value         The value wrapping this container.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cache_fill(
+    vcjson_emit_cache* cache, vcjson_value* value)
+{
+    status retval, release_retval;
+    size_t size = 0;
+    bool sensitive = false;
+    vcjson_emit_cache_context ctx;
+    vcjson_emitter emitter;
+    char* data;
+
+    /* set up the counting emitter. */
+    emitter.emit = &vcjson_emit_to_counter;
+    emitter.emit_reference = NULL;
+    emitter.context = &size;
+    emitter.sensitive = &sensitive;
+
+    /* get the size of the emitted value. */
+    retval = vcjson_emit_value(&emitter, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* allocate memory for the cached data. */
+    retval = allocator_allocate(cache->alloc, (void**)&data, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* set up the cache emitter context. */
+    ctx.outbuf = data;
+    ctx.offset = 0;
+    ctx.maxlen = size;
+
+    /* set up the cache emitter. */
+    emitter.emit = &vcjson_emit_to_cache;
+    emitter.emit_reference = NULL;
+    emitter.context = &ctx;
+    emitter.sensitive = NULL;
+
+    /* emit the value to the cached data. */
+    retval = vcjson_emit_value(&emitter, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_data;
+    }
+
+    /* success. Set the cached data. */
+    cache->data = data;
+    cache->size = size;
+    cache->sensitive = sensitive;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_data:
+    /* only sensitive data is wiped. */
+    if (sensitive)
+    {
+        memset(data, 0, size);
+    }
+
+    release_retval = allocator_reclaim(cache->alloc, data);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Accumulate writes to a total size.
+ *
+ * \param context       Opaque pointer to the counter for this operation.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_counter(
+    void* context, const void* /*val*/, size_t size)
+{
+    size_t* count = (size_t*)context;
+
+    *count += size;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write to the cached data.
+ *
+ * \param context       Opaque pointer to the cache context.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_cache(
+    void* context, const void* val, size_t size)
+{
+    vcjson_emit_cache_context* ctx = (vcjson_emit_cache_context*)context;
+
+    /* verify that we can write to this buffer. */
+    if (ctx->offset + size > ctx->maxlen)
+    {
+        return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+    }
+
+    /* write the data to the buffer. */
+    memcpy(ctx->outbuf + ctx->offset, val, size);
+
+    /* increment offset. */
+    ctx->offset += size;
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,852 @@
+/**
+ * \file vcjson_emit_canonical.c
+ *
+ * \brief Emit a JSON value in RFC 8785 canonical form to a sink.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/* size of the output buffer in front of the sink. */
+#define VCJSON_EMIT_CANONICAL_BUFFER_SIZE                                 4096
+
+typedef struct vcjson_emit_canonical_context vcjson_emit_canonical_context;
+struct vcjson_emit_canonical_context
+{
+    vcjson_emit_sink_fn sink;
+    void* sink_context;
+    size_t offset;
+    /* set when the buffer has held a sensitive string. */
+    bool sensitive;
+    char buffer[VCJSON_EMIT_CANONICAL_BUFFER_SIZE];
+};
+
+/* a member collected for sorting. */
+typedef struct vcjson_emit_canonical_member_ref
+    vcjson_emit_canonical_member_ref;
+struct vcjson_emit_canonical_member_ref
+{
+    const vcjson_string* key;
+    vcjson_value* value;
+};
+
+/* forward decls. */
+static status vcjson_emit_canonical_value(
+    vcjson_emit_canonical_context* ctx, vcjson_value* value);
+static status vcjson_emit_canonical_number(
+    vcjson_emit_canonical_context* ctx, double number);
+static status vcjson_emit_canonical_string(
+    vcjson_emit_canonical_context* ctx, const vcjson_string* stringval);
+static status vcjson_emit_canonical_object(
+    vcjson_emit_canonical_context* ctx, vcjson_object* obj);
+static status vcjson_emit_canonical_object_sorted(
+    vcjson_emit_canonical_context* ctx, vcjson_object* obj);
+static status vcjson_emit_canonical_member(
+    vcjson_emit_canonical_context* ctx, const vcjson_string* key,
+    vcjson_value* value, bool emit_comma);
+static status vcjson_emit_canonical_array(
+    vcjson_emit_canonical_context* ctx, vcjson_array* arr);
+static bool vcjson_emit_canonical_key_has_surrogates(
+    const vcjson_string* key);
+static int vcjson_emit_canonical_utf16_compare(
+    const void* lhs, const void* rhs);
+static bool vcjson_emit_canonical_next_unit(
+    const vcjson_string* str, size_t* offset, uint16_t* pending,
+    uint16_t* unit);
+static status vcjson_emit_canonical_write(
+    vcjson_emit_canonical_context* ctx, const void* val, size_t size);
+static status vcjson_emit_canonical_flush(vcjson_emit_canonical_context* ctx);
+
+/**
+ * \brief Emit a JSON value in RFC 8785 (JCS) canonical form to a sink.
+ *
+ * Numbers are formatted using the shortest round-trip ECMAScript form, strings
+ * use the minimal JCS escapes, and object members are ordered by the UTF-16
+ * code units of their keys. The emitted text is passed to \p sink in pieces of
+ * up to a few kilobytes and is never held in memory as a whole.
+ *
+ * \note Memoized forms created by \ref vcjson_emit_cache_update are not used,
+ * since they are not canonical.
+ *
+ * \param value         The JSON value to emit.
+ * \param sink          The sink function to receive the emitted text.
+ * \param context       The user context to pass to the sink function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_NUMBER_FORMAT if a number is not finite.
+ *      - a non-zero error code on failure, including any error returned by the
+ *        sink function.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_canonical(
+    vcjson_value* value, vcjson_emit_sink_fn sink, void* context)
+{
+    status retval;
+    vcjson_emit_canonical_context ctx;
+
+    /* set up the canonical context. */
+    ctx.sink = sink;
+    ctx.sink_context = context;
+    ctx.offset = 0;
+    ctx.sensitive = false;
+
+    /* emit the value. */
+    retval = vcjson_emit_canonical_value(&ctx, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_ctx;
+    }
+
+    /* flush the remaining output. */
+    retval = vcjson_emit_canonical_flush(&ctx);
+    goto cleanup_ctx;
+
+cleanup_ctx:
+    /* only a buffer that has held a sensitive string is wiped. */
+    if (ctx.sensitive)
+    {
+        memset(&ctx, 0, sizeof(ctx));
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Emit a JSON value in canonical form.
+ *
+ * \param ctx           The canonical context.
+ * \param value         The value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_value(
+    vcjson_emit_canonical_context* ctx, vcjson_value* value)
+{
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_NULL:
+            return vcjson_emit_canonical_write(ctx, "null", 4);
+
+        case VCJSON_VALUE_TYPE_BOOL:
+            if (VCJSON_TRUE == (vcjson_bool*)value->value)
+            {
+                return vcjson_emit_canonical_write(ctx, "true", 4);
+            }
+            else
+            {
+                return vcjson_emit_canonical_write(ctx, "false", 5);
+            }
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            return
+                vcjson_emit_canonical_number(
+                    ctx, vcjson_number_value((vcjson_number*)value->value));
+
+        case VCJSON_VALUE_TYPE_STRING:
+            return
+                vcjson_emit_canonical_string(
+                    ctx, (const vcjson_string*)value->value);
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return
+                vcjson_emit_canonical_object(
+                    ctx, (vcjson_object*)value->value);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return
+                vcjson_emit_canonical_array(ctx, (vcjson_array*)value->value);
+
+        default:
+            return ERROR_VCJSON_EMIT_UNKNOWN_VALUE_TYPE;
+    }
+}
+
+/**
+ * \brief Emit a number using the ECMAScript Number.prototype.toString form.
+ *
+ * The shortest decimal digit string that round-trips to the same double is
+ * found by increasing the precision of the exponent form until it does.
+ *
+ * \param ctx           The canonical context.
+ * \param number        The number to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_number(
+    vcjson_emit_canonical_context* ctx, double number)
+{
+    char buffer[32];
+    char digits[20];
+    char out[48];
+    size_t digit_count = 0;
+    size_t out_size = 0;
+    const char* iter;
+    long exponent;
+    long n;
+
+    /* NaN and infinity have no JSON representation. */
+    if (!isfinite(number))
+    {
+        return ERROR_VCJSON_EMIT_NUMBER_FORMAT;
+    }
+
+    /* both zeroes are emitted as 0. */
+    if (0.0 == number)
+    {
+        return vcjson_emit_canonical_write(ctx, "0", 1);
+    }
+
+    /* handle the sign. */
+    if (number < 0)
+    {
+        out[out_size++] = '-';
+        number = -number;
+    }
+
+    /* find the shortest precision that round-trips. */
+    for (int precision = 1; precision <= 17; ++precision)
+    {
+        snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, number);
+        if (strtod(buffer, NULL) == number)
+        {
+            break;
+        }
+    }
+
+    /* collect the significant digits. */
+    for (iter = buffer; 'e' != *iter; ++iter)
+    {
+        if ('.' != *iter)
+        {
+            digits[digit_count++] = *iter;
+        }
+    }
+
+    /* drop trailing zeroes. */
+    while (digit_count > 1 && '0' == digits[digit_count - 1])
+    {
+        --digit_count;
+    }
+
+    /* the value is 0.digits * 10^n. */
+    exponent = strtol(iter + 1, NULL, 10);
+    n = exponent + 1;
+
+    /* integers up to 21 digits are written out in full. */
+    if ((long)digit_count <= n && n <= 21)
+    {
+        memcpy(out + out_size, digits, digit_count);
+        out_size += digit_count;
+        for (long i = digit_count; i < n; ++i)
+        {
+            out[out_size++] = '0';
+        }
+    }
+    /* the decimal point falls within the digits. */
+    else if (0 < n && n <= 21)
+    {
+        memcpy(out + out_size, digits, n);
+        out_size += n;
+        out[out_size++] = '.';
+        memcpy(out + out_size, digits + n, digit_count - n);
+        out_size += digit_count - n;
+    }
+    /* small fractions are written with leading zeroes. */
+    else if (-6 < n && n <= 0)
+    {
+        out[out_size++] = '0';
+        out[out_size++] = '.';
+        for (long i = n; i < 0; ++i)
+        {
+            out[out_size++] = '0';
+        }
+        memcpy(out + out_size, digits, digit_count);
+        out_size += digit_count;
+    }
+    /* everything else uses the exponent form. */
+    else
+    {
+        out[out_size++] = digits[0];
+        if (digit_count > 1)
+        {
+            out[out_size++] = '.';
+            memcpy(out + out_size, digits + 1, digit_count - 1);
+            out_size += digit_count - 1;
+        }
+
+        out_size +=
+            snprintf(
+                out + out_size, sizeof(out) - out_size, "e%c%ld",
+                (n - 1 < 0) ? '-' : '+', labs(n - 1));
+    }
+
+    return vcjson_emit_canonical_write(ctx, out, out_size);
+}
+
+/**
+ * \brief Emit a string using the JCS escape rules.
+ *
+ * \param ctx           The canonical context.
+ * \param stringval     The string to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_string(
+    vcjson_emit_canonical_context* ctx, const vcjson_string* stringval)
+{
+    status retval;
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char* str = (const unsigned char*)stringval->value;
+    size_t length = stringval->length;
+    size_t run_start = 0;
+    char escape[6];
+    size_t escape_size;
+
+    /* note that the buffer holds a sensitive string. */
+    if (stringval->sensitive)
+    {
+        ctx->sensitive = true;
+    }
+
+    /* emit the open quote. */
+    retval = vcjson_emit_canonical_write(ctx, "\"", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        escape[0] = '\\';
+        escape_size = 2;
+
+        switch (str[i])
+        {
+            case '\b':
+                escape[1] = 'b';
+                break;
+
+            case '\f':
+                escape[1] = 'f';
+                break;
+
+            case '\n':
+                escape[1] = 'n';
+                break;
+
+            case '\r':
+                escape[1] = 'r';
+                break;
+
+            case '\t':
+                escape[1] = 't';
+                break;
+
+            case '\\':
+                escape[1] = '\\';
+                break;
+
+            case '"':
+                escape[1] = '"';
+                break;
+
+            default:
+                /* all other bytes except control characters are literal. */
+                if (str[i] >= 0x20)
+                {
+                    continue;
+                }
+
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = hex[str[i] >> 4];
+                escape[5] = hex[str[i] & 0x0f];
+                escape_size = 6;
+                break;
+        }
+
+        /* emit the run of bytes preceding this escape. */
+        retval =
+            vcjson_emit_canonical_write(ctx, str + run_start, i - run_start);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* emit the escape. */
+        retval = vcjson_emit_canonical_write(ctx, escape, escape_size);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        run_start = i + 1;
+    }
+
+    /* emit the final run of bytes. */
+    retval =
+        vcjson_emit_canonical_write(ctx, str + run_start, length - run_start);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* emit the close quote. */
+    return vcjson_emit_canonical_write(ctx, "\"", 1);
+}
+
+/**
+ * \brief Emit an object with its members in UTF-16 key order.
+ *
+ * Objects order keys by UTF-8 bytes, which matches the UTF-16 order
+ * unless a key contains a character outside of the basic multilingual plane.
+ * Only objects with such keys, and objects kept in insertion order, are
+ * sorted again.
+ *
+ * \param ctx           The canonical context.
+ * \param obj           The object to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_object(
+    vcjson_emit_canonical_context* ctx, vcjson_object* obj)
+{
+    status retval;
+    vcjson_object_cursor first;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* value;
+    bool emit_comma = false;
+
+    /* insertion order is never canonical. */
+    if (obj->insertion_order)
+    {
+        return vcjson_emit_canonical_object_sorted(ctx, obj);
+    }
+
+    /* get the first member of this object. */
+    vcjson_object_cursor_begin(&first, obj);
+
+    /* if any key would be encoded with surrogates, sort the members. */
+    for (iter = first; vcjson_object_cursor_member(&key, &value, obj, &iter);
+         vcjson_object_cursor_next(&iter, obj))
+    {
+        if (vcjson_emit_canonical_key_has_surrogates(key))
+        {
+            return vcjson_emit_canonical_object_sorted(ctx, obj);
+        }
+    }
+
+    /* emit the open brace. */
+    retval = vcjson_emit_canonical_write(ctx, "{", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* otherwise, the sorted key order is canonical. */
+    for (iter = first; vcjson_object_cursor_member(&key, &value, obj, &iter);
+         vcjson_object_cursor_next(&iter, obj))
+    {
+        retval = vcjson_emit_canonical_member(ctx, key, value, emit_comma);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        emit_comma = true;
+    }
+
+    /* emit the close brace. */
+    return vcjson_emit_canonical_write(ctx, "}", 1);
+}
+
+/**
+ * \brief Emit an object after sorting its members by UTF-16 key order.
+ *
+ * \param ctx           The canonical context.
+ * \param obj           The object to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_object_sorted(
+    vcjson_emit_canonical_context* ctx, vcjson_object* obj)
+{
+    status retval, reclaim_retval;
+    vcjson_emit_canonical_member_ref* members;
+    size_t count = vcjson_object_elements(obj);
+    size_t members_size = count * sizeof(*members);
+    vcjson_object_cursor iter;
+    size_t i = 0;
+
+    /* allocate memory for the member list. */
+    retval = allocator_allocate(obj->alloc, (void**)&members, members_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* collect the members. */
+    vcjson_object_cursor_begin(&iter, obj);
+    while (vcjson_object_cursor_member(
+                &members[i].key, &members[i].value, obj, &iter))
+    {
+        ++i;
+        vcjson_object_cursor_next(&iter, obj);
+    }
+
+    /* sort the members by UTF-16 key order. */
+    qsort(
+        members, count, sizeof(*members),
+        &vcjson_emit_canonical_utf16_compare);
+
+    /* emit the open brace. */
+    retval = vcjson_emit_canonical_write(ctx, "{", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_members;
+    }
+
+    /* emit the members. */
+    for (i = 0; i < count; ++i)
+    {
+        retval =
+            vcjson_emit_canonical_member(
+                ctx, members[i].key, members[i].value, 0 != i);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_members;
+        }
+    }
+
+    /* emit the close brace. */
+    retval = vcjson_emit_canonical_write(ctx, "}", 1);
+    goto cleanup_members;
+
+cleanup_members:
+    memset(members, 0, members_size);
+    reclaim_retval = allocator_reclaim(obj->alloc, members);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Emit a single object member.
+ *
+ * \param ctx           The canonical context.
+ * \param key           The key of the member to emit.
+ * \param value         The value of the member to emit.
+ * \param emit_comma    Set to true if a comma precedes this member.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_member(
+    vcjson_emit_canonical_context* ctx, const vcjson_string* key,
+    vcjson_value* value, bool emit_comma)
+{
+    status retval;
+
+    if (emit_comma)
+    {
+        retval = vcjson_emit_canonical_write(ctx, ",", 1);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    retval = vcjson_emit_canonical_string(ctx, key);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = vcjson_emit_canonical_write(ctx, ":", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return vcjson_emit_canonical_value(ctx, value);
+}
+
+/**
+ * \brief Emit an array in canonical form.
+ *
+ * \param ctx           The canonical context.
+ * \param arr           The array to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_array(
+    vcjson_emit_canonical_context* ctx, vcjson_array* arr)
+{
+    status retval;
+
+    /* emit the open bracket. */
+    retval = vcjson_emit_canonical_write(ctx, "[", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    for (size_t i = 0; i < arr->elems; ++i)
+    {
+        if (0 != i)
+        {
+            retval = vcjson_emit_canonical_write(ctx, ",", 1);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+        }
+
+        /* packed numbers are emitted without boxing them. */
+        if (NULL != arr->numbers)
+        {
+            retval = vcjson_emit_canonical_number(ctx, arr->numbers[i]);
+        }
+        else
+        {
+            retval = vcjson_emit_canonical_value(ctx, arr->arr[i]);
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* emit the close bracket. */
+    return vcjson_emit_canonical_write(ctx, "]", 1);
+}
+
+/**
+ * \brief Check whether a key has characters that UTF-16 encodes as surrogate
+ * pairs.
+ *
+ * \param key           The key to check.
+ *
+ * \returns true if this key has a four byte UTF-8 sequence.
+ */
+static bool vcjson_emit_canonical_key_has_surrogates(
+    const vcjson_string* key)
+{
+    const unsigned char* str = (const unsigned char*)key->value;
+
+    for (size_t i = 0; i < key->length; ++i)
+    {
+        if (str[i] >= 0xf0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * \brief Compare two object members by the UTF-16 code units of their keys.
+ *
+ * \param lhs           Pointer to the left-hand-side member.
+ * \param rhs           Pointer to the right-hand-side member.
+ *
+ * \returns a negative, zero, or positive value, as per qsort.
+ */
+static int vcjson_emit_canonical_utf16_compare(
+    const void* lhs, const void* rhs)
+{
+    const vcjson_string* l =
+        ((const vcjson_emit_canonical_member_ref*)lhs)->key;
+    const vcjson_string* r =
+        ((const vcjson_emit_canonical_member_ref*)rhs)->key;
+    size_t l_offset = 0, r_offset = 0;
+    uint16_t l_pending = 0, r_pending = 0;
+    uint16_t l_unit, r_unit;
+    bool l_more, r_more;
+
+    for (;;)
+    {
+        l_more =
+            vcjson_emit_canonical_next_unit(l, &l_offset, &l_pending, &l_unit);
+        r_more =
+            vcjson_emit_canonical_next_unit(r, &r_offset, &r_pending, &r_unit);
+
+        if (!l_more || !r_more)
+        {
+            return (int)l_more - (int)r_more;
+        }
+        else if (l_unit != r_unit)
+        {
+            return (int)l_unit - (int)r_unit;
+        }
+    }
+}
+
+/**
+ * \brief Decode the next UTF-16 code unit from a UTF-8 string.
+ *
+ * \param str           The string to decode.
+ * \param offset        Pointer to the byte offset, updated on success.
+ * \param pending       Pointer to a pending low surrogate, or 0.
+ * \param unit          Pointer to receive the code unit.
+ *
+ * \returns true if a code unit was decoded, or false at the end of the string.
+ */
+static bool vcjson_emit_canonical_next_unit(
+    const vcjson_string* str, size_t* offset, uint16_t* pending,
+    uint16_t* unit)
+{
+    const unsigned char* in = (const unsigned char*)str->value;
+    uint32_t codepoint;
+    size_t size;
+
+    /* emit the low half of a surrogate pair. */
+    if (0 != *pending)
+    {
+        *unit = *pending;
+        *pending = 0;
+        return true;
+    }
+
+    if (*offset >= str->length)
+    {
+        return false;
+    }
+
+    /* decode the lead byte. */
+    if (in[*offset] < 0x80)
+    {
+        codepoint = in[*offset];
+        size = 1;
+    }
+    else if (in[*offset] < 0xe0)
+    {
+        codepoint = in[*offset] & 0x1f;
+        size = 2;
+    }
+    else if (in[*offset] < 0xf0)
+    {
+        codepoint = in[*offset] & 0x0f;
+        size = 3;
+    }
+    else
+    {
+        codepoint = in[*offset] & 0x07;
+        size = 4;
+    }
+
+    /* decode the continuation bytes. */
+    for (size_t i = 1; i < size && *offset + i < str->length; ++i)
+    {
+        codepoint = (codepoint << 6) | (in[*offset + i] & 0x3f);
+    }
+
+    *offset += size;
+
+    /* split supplementary characters into a surrogate pair. */
+    if (codepoint >= 0x10000)
+    {
+        codepoint -= 0x10000;
+        *unit = (uint16_t)(0xd800 + (codepoint >> 10));
+        *pending = (uint16_t)(0xdc00 + (codepoint & 0x3ff));
+    }
+    else
+    {
+        *unit = (uint16_t)codepoint;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Write data to the output buffer, flushing to the sink as needed.
+ *
+ * \param ctx           The canonical context.
+ * \param val           The data to write.
+ * \param size          The size of this data.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_write(
+    vcjson_emit_canonical_context* ctx, const void* val, size_t size)
+{
+    status retval;
+
+    /* flush the buffer if this data does not fit. */
+    if (ctx->offset + size > sizeof(ctx->buffer))
+    {
+        retval = vcjson_emit_canonical_flush(ctx);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* pass large writes directly to the sink. */
+        if (size > sizeof(ctx->buffer))
+        {
+            return ctx->sink(ctx->sink_context, val, size);
+        }
+    }
+
+    memcpy(ctx->buffer + ctx->offset, val, size);
+    ctx->offset += size;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Flush the output buffer to the sink.
+ *
+ * \param ctx           The canonical context.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_canonical_flush(vcjson_emit_canonical_context* ctx)
+{
+    status retval;
+
+    if (0 == ctx->offset)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    retval = ctx->sink(ctx->sink_context, ctx->buffer, ctx->offset);
+    ctx->offset = 0;
+
+    return retval;
+}
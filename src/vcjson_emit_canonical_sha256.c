@@ -0,0 +1,73 @@
+/**
+ * \file vcjson_emit_canonical_sha256.c
+ *
+ * \brief Compute the SHA-256 digest of the canonical form of a JSON value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static status vcjson_emit_to_sha256(
+    void* context, const void* val, size_t size);
+
+/**
+ * \brief Compute the SHA-256 digest of the RFC 8785 canonical form of a JSON
+ * value.
+ *
+ * The canonical text is fed to the digest as it is emitted, so it is never
+ * held in memory as a whole.
+ *
+ * \param digest        Buffer to receive the \ref VCJSON_SHA256_DIGEST_SIZE
+ *                      byte digest.
+ * \param value         The JSON value to digest.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_canonical_sha256(uint8_t* digest, vcjson_value* value)
+{
+    status retval;
+    vcjson_sha256_context ctx;
+
+    /* initialize the digest. */
+    vcjson_sha256_init(&ctx);
+
+    /* emit the canonical form to the digest. */
+    retval = vcjson_emit_canonical(value, &vcjson_emit_to_sha256, &ctx);
+    if (STATUS_SUCCESS != retval)
+    {
+        memset(&ctx, 0, sizeof(ctx));
+        return retval;
+    }
+
+    /* finish the digest. */
+    vcjson_sha256_final(&ctx, digest);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Add emitted data to the digest.
+ *
+ * \param context       Opaque pointer to the SHA-256 context.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_sha256(
+    void* context, const void* val, size_t size)
+{
+    vcjson_sha256_update((vcjson_sha256_context*)context, val, size);
+
+    return STATUS_SUCCESS;
+}
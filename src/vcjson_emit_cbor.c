@@ -0,0 +1,512 @@
+/**
+ * \file vcjson_emit_cbor.c
+ *
+ * \brief Emit a JSON value as RFC 8949 CBOR to a sink.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* size of the output buffer in front of the sink. */
+#define VCJSON_EMIT_CBOR_BUFFER_SIZE                                      4096
+
+typedef struct vcjson_emit_cbor_context vcjson_emit_cbor_context;
+struct vcjson_emit_cbor_context
+{
+    vcjson_emit_sink_fn sink;
+    void* sink_context;
+    size_t offset;
+    /* set when the buffer has held a sensitive string. */
+    bool sensitive;
+    uint8_t buffer[VCJSON_EMIT_CBOR_BUFFER_SIZE];
+};
+
+/* forward decls. */
+static status vcjson_emit_cbor_value(
+    vcjson_emit_cbor_context* ctx, vcjson_value* value);
+static status vcjson_emit_cbor_number(
+    vcjson_emit_cbor_context* ctx, double number);
+static bool vcjson_emit_cbor_half(uint16_t* half, double number);
+static status vcjson_emit_cbor_string(
+    vcjson_emit_cbor_context* ctx, const vcjson_string* stringval);
+static status vcjson_emit_cbor_object(
+    vcjson_emit_cbor_context* ctx, vcjson_object* obj);
+static status vcjson_emit_cbor_array(
+    vcjson_emit_cbor_context* ctx, const vcjson_array* arr);
+static status vcjson_emit_cbor_head(
+    vcjson_emit_cbor_context* ctx, uint8_t major, uint64_t argument);
+static status vcjson_emit_cbor_write(
+    vcjson_emit_cbor_context* ctx, const void* val, size_t size);
+static status vcjson_emit_cbor_flush(vcjson_emit_cbor_context* ctx);
+
+/**
+ * \brief Emit a JSON value as RFC 8949 CBOR to a sink.
+ *
+ * Every container is emitted with a definite length, and each number uses
+ * the preferred serialization: integral numbers within the 64-bit range are
+ * emitted as CBOR integers, and other numbers use the shortest of the half,
+ * single, and double precision forms that holds them exactly. Object members
+ * are emitted in the order in which the object walks them. The emitted bytes
+ * are passed to \p sink in pieces of up to a few kilobytes and are never held
+ * in memory as a whole.
+ *
+ * \param value         The JSON value to emit.
+ * \param sink          The sink function to receive the emitted bytes.
+ * \param context       The user context to pass to the sink function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_NUMBER_FORMAT if a number is not finite.
+ *      - a non-zero error code on failure, including any error returned by the
+ *        sink function.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cbor(
+    vcjson_value* value, vcjson_emit_sink_fn sink, void* context)
+{
+    status retval;
+    vcjson_emit_cbor_context ctx;
+
+    /* set up the CBOR context. */
+    ctx.sink = sink;
+    ctx.sink_context = context;
+    ctx.offset = 0;
+    ctx.sensitive = false;
+
+    /* emit the value. */
+    retval = vcjson_emit_cbor_value(&ctx, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_ctx;
+    }
+
+    /* flush the remaining output. */
+    retval = vcjson_emit_cbor_flush(&ctx);
+    goto cleanup_ctx;
+
+cleanup_ctx:
+    /* only a buffer that has held a sensitive string is wiped. */
+    if (ctx.sensitive)
+    {
+        memset(&ctx, 0, sizeof(ctx));
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Emit a JSON value as CBOR.
+ *
+ * \param ctx           The CBOR context.
+ * \param value         The value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_value(
+    vcjson_emit_cbor_context* ctx, vcjson_value* value)
+{
+    uint8_t simple;
+
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_NULL:
+            simple = 0xf6;
+            return vcjson_emit_cbor_write(ctx, &simple, 1);
+
+        case VCJSON_VALUE_TYPE_BOOL:
+            simple = ((const vcjson_bool*)value->value)->value ? 0xf5 : 0xf4;
+            return vcjson_emit_cbor_write(ctx, &simple, 1);
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            return
+                vcjson_emit_cbor_number(
+                    ctx, ((const vcjson_number*)value->value)->value);
+
+        case VCJSON_VALUE_TYPE_STRING:
+            return
+                vcjson_emit_cbor_string(
+                    ctx, (const vcjson_string*)value->value);
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return
+                vcjson_emit_cbor_object(ctx, (vcjson_object*)value->value);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return
+                vcjson_emit_cbor_array(
+                    ctx, (const vcjson_array*)value->value);
+
+        default:
+            return ERROR_VCJSON_EMIT_UNKNOWN_VALUE_TYPE;
+    }
+}
+
+/**
+ * \brief Emit a number using its preferred serialization.
+ *
+ * \param ctx           The CBOR context.
+ * \param number        The number to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_EMIT_NUMBER_FORMAT if this number is not finite.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_number(
+    vcjson_emit_cbor_context* ctx, double number)
+{
+    uint8_t head[9];
+    uint64_t bits;
+    uint32_t single_bits;
+    uint16_t half;
+    float single;
+
+    /* CBOR can hold these, but JSON cannot. */
+    if (!isfinite(number))
+    {
+        return ERROR_VCJSON_EMIT_NUMBER_FORMAT;
+    }
+
+    /* integral numbers, other than -0, are emitted as integers. */
+    if (floor(number) == number && !(0.0 == number && signbit(number)))
+    {
+        if (number >= 0.0 && number < 18446744073709551616.0)
+        {
+            return vcjson_emit_cbor_head(ctx, 0, (uint64_t)number);
+        }
+
+        if (number < 0.0 && number > -18446744073709551616.0)
+        {
+            return vcjson_emit_cbor_head(ctx, 1, (uint64_t)(-number) - 1);
+        }
+    }
+
+    /* use half precision if it holds this number exactly. */
+    if (vcjson_emit_cbor_half(&half, number))
+    {
+        head[0] = 0xf9;
+        head[1] = (uint8_t)(half >> 8);
+        head[2] = (uint8_t)half;
+
+        return vcjson_emit_cbor_write(ctx, head, 3);
+    }
+
+    /* use single precision if it holds this number exactly. */
+    single = (fabs(number) <= FLT_MAX) ? (float)number : 0.0f;
+    if ((double)single == number)
+    {
+        memcpy(&single_bits, &single, sizeof(single_bits));
+        head[0] = 0xfa;
+        for (int i = 0; i < 4; ++i)
+        {
+            head[1 + i] = (uint8_t)(single_bits >> (24 - 8 * i));
+        }
+
+        return vcjson_emit_cbor_write(ctx, head, 5);
+    }
+
+    /* otherwise, use double precision. */
+    memcpy(&bits, &number, sizeof(bits));
+    head[0] = 0xfb;
+    for (int i = 0; i < 8; ++i)
+    {
+        head[1 + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+
+    return vcjson_emit_cbor_write(ctx, head, 9);
+}
+
+/**
+ * \brief Convert a number to half precision, if it can be held exactly.
+ *
+ * \param half          Pointer to receive the half precision bits.
+ * \param number        The finite number to convert.
+ *
+ * \returns true if this number is held exactly in half precision.
+ */
+static bool vcjson_emit_cbor_half(uint16_t* half, double number)
+{
+    uint16_t sign = signbit(number) ? 0x8000 : 0;
+    double magnitude = fabs(number);
+    double mantissa;
+    int exponent;
+
+    /* zero has no exponent. */
+    if (0.0 == magnitude)
+    {
+        *half = sign;
+        return true;
+    }
+
+    /* magnitude = mantissa * 2^exponent, with mantissa in [0.5, 1). */
+    mantissa = frexp(magnitude, &exponent);
+
+    /* normal halves hold 11 significant bits, with exponents -14 to 15. */
+    if (exponent >= -13 && exponent <= 16)
+    {
+        mantissa = ldexp(mantissa, 11);
+        if (floor(mantissa) != mantissa)
+        {
+            return false;
+        }
+
+        *half =
+            sign | (uint16_t)((exponent + 14) << 10)
+                 | ((uint16_t)mantissa & 0x3ff);
+        return true;
+    }
+
+    /* subnormal halves are multiples of 2^-24. */
+    if (exponent < -13 && exponent >= -23)
+    {
+        mantissa = ldexp(magnitude, 24);
+        if (floor(mantissa) != mantissa)
+        {
+            return false;
+        }
+
+        *half = sign | (uint16_t)mantissa;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * \brief Emit a string as a CBOR text string.
+ *
+ * \param ctx           The CBOR context.
+ * \param stringval     The string to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_string(
+    vcjson_emit_cbor_context* ctx, const vcjson_string* stringval)
+{
+    status retval;
+
+    retval = vcjson_emit_cbor_head(ctx, 3, stringval->length);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the buffer must be wiped if it holds this string. */
+    if (stringval->sensitive)
+    {
+        ctx->sensitive = true;
+    }
+
+    return vcjson_emit_cbor_write(ctx, stringval->value, stringval->length);
+}
+
+/**
+ * \brief Emit an object as a CBOR map.
+ *
+ * \param ctx           The CBOR context.
+ * \param obj           The object to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_object(
+    vcjson_emit_cbor_context* ctx, vcjson_object* obj)
+{
+    status retval;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* value;
+
+    retval = vcjson_emit_cbor_head(ctx, 5, vcjson_object_elements(obj));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    vcjson_object_cursor_begin(&iter, obj);
+    while (vcjson_object_cursor_member(&key, &value, obj, &iter))
+    {
+        retval = vcjson_emit_cbor_string(ctx, key);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = vcjson_emit_cbor_value(ctx, value);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        vcjson_object_cursor_next(&iter, obj);
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Emit an array as a CBOR array.
+ *
+ * \param ctx           The CBOR context.
+ * \param arr           The array to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_array(
+    vcjson_emit_cbor_context* ctx, const vcjson_array* arr)
+{
+    status retval;
+
+    retval = vcjson_emit_cbor_head(ctx, 4, arr->elems);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    for (size_t i = 0; i < arr->elems; ++i)
+    {
+        /* packed numbers are emitted without boxing them. */
+        if (NULL != arr->numbers)
+        {
+            retval = vcjson_emit_cbor_number(ctx, arr->numbers[i]);
+        }
+        else
+        {
+            retval = vcjson_emit_cbor_value(ctx, arr->arr[i]);
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Emit the head of a data item, using the shortest argument encoding.
+ *
+ * \param ctx           The CBOR context.
+ * \param major         The major type of this data item.
+ * \param argument      The argument of this data item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_head(
+    vcjson_emit_cbor_context* ctx, uint8_t major, uint64_t argument)
+{
+    uint8_t head[9];
+    size_t bytes;
+
+    if (argument < 24)
+    {
+        head[0] = (uint8_t)((major << 5) | argument);
+        return vcjson_emit_cbor_write(ctx, head, 1);
+    }
+    else if (argument <= UINT8_MAX)
+    {
+        head[0] = (uint8_t)((major << 5) | 24);
+        bytes = 1;
+    }
+    else if (argument <= UINT16_MAX)
+    {
+        head[0] = (uint8_t)((major << 5) | 25);
+        bytes = 2;
+    }
+    else if (argument <= UINT32_MAX)
+    {
+        head[0] = (uint8_t)((major << 5) | 26);
+        bytes = 4;
+    }
+    else
+    {
+        head[0] = (uint8_t)((major << 5) | 27);
+        bytes = 8;
+    }
+
+    /* the argument follows in network byte order. */
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        head[1 + i] = (uint8_t)(argument >> (8 * (bytes - 1 - i)));
+    }
+
+    return vcjson_emit_cbor_write(ctx, head, 1 + bytes);
+}
+
+/**
+ * \brief Write data through the output buffer.
+ *
+ * \param ctx           The CBOR context.
+ * \param val           The data to write.
+ * \param size          The size of this data.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_write(
+    vcjson_emit_cbor_context* ctx, const void* val, size_t size)
+{
+    status retval;
+
+    /* flush the buffer if this data does not fit. */
+    if (ctx->offset + size > sizeof(ctx->buffer))
+    {
+        retval = vcjson_emit_cbor_flush(ctx);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* pass large writes directly to the sink. */
+        if (size > sizeof(ctx->buffer))
+        {
+            return ctx->sink(ctx->sink_context, val, size);
+        }
+    }
+
+    memcpy(ctx->buffer + ctx->offset, val, size);
+    ctx->offset += size;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Flush the output buffer to the sink.
+ *
+ * \param ctx           The CBOR context.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_cbor_flush(vcjson_emit_cbor_context* ctx)
+{
+    status retval;
+
+    if (0 == ctx->offset)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    retval = ctx->sink(ctx->sink_context, ctx->buffer, ctx->offset);
+    ctx->offset = 0;
+
+    return retval;
+}
@@ -0,0 +1,238 @@
+/**
+ * \file vcjson_emit_iovec.c
+ *
+ * \brief Emit a JSON value as a scatter/gather list.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <sys/uio.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/* forward decls. */
+static status vcjson_emit_to_scratch(
+    void* context, const void* val, size_t size);
+static status vcjson_emit_to_reference(
+    void* context, const void* val, size_t size);
+
+typedef struct vcjson_emit_iovec_context vcjson_emit_iovec_context;
+struct vcjson_emit_iovec_context
+{
+    struct iovec* iov;
+    size_t count;
+    size_t maxcount;
+    char* scratch;
+    size_t offset;
+    size_t maxlen;
+    bool scratch_open;
+};
+
+/**
+ * \brief Emit a JSON value as a scatter/gather list.
+ *
+ * Punctuation, escapes, numbers, and short string runs are copied into a
+ * scratch area owned by the list. Unescaped runs of string data that are at
+ * least \ref VCJSON_EMIT_IOVEC_REFERENCE_MINIMUM bytes long are not copied;
+ * instead, their iovec entries point directly at the storage of the
+ * \ref vcjson_string instances in \p value. The resulting vector can be passed
+ * to writev or sendmsg.
+ *
+ * \note On success, this function creates a list that is owned by the caller.
+ * This list is a resource that must be released when no longer in use. Since
+ * the list refers to string storage in \p value, the list is only valid until
+ * \p value is modified or released.
+ *
+ * \param list          Pointer to the list pointer to hold the iovec list.
+ * \param alloc         The allocator to use for this operation.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_iovec(
+    vcjson_iovec_list** list, RCPR_SYM(allocator)* alloc, vcjson_value* value)
+{
+    status retval, release_retval;
+    vcjson_emit_iovec_context ctx;
+    vcjson_emitter emitter;
+    vcjson_iovec_list* tmp;
+    size_t size;
+    bool sensitive = false;
+
+    /* set up the emitter. */
+    emitter.emit = &vcjson_emit_to_scratch;
+    emitter.emit_reference = &vcjson_emit_to_reference;
+    emitter.context = &ctx;
+    emitter.sensitive = &sensitive;
+
+    /* with no vector, the first pass only counts entries and scratch bytes. */
+    memset(&ctx, 0, sizeof(ctx));
+    retval = vcjson_emit_value(&emitter, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the list header, vector, and scratch area share one allocation. */
+    size = sizeof(*tmp) + ctx.count * sizeof(struct iovec) + ctx.offset;
+
+    /* allocate memory for the list. */
+    retval = allocator_allocate(alloc, (void**)&tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear list memory. */
+    memset(tmp, 0, size);
+
+    /* init resource. */
+    resource_init(&tmp->hdr, &vcjson_iovec_list_resource_release);
+
+    /* set the list values. */
+    tmp->alloc = alloc;
+    tmp->iov = (struct iovec*)(tmp + 1);
+    tmp->size = size;
+    tmp->sensitive = sensitive;
+
+    /* set up the second pass to fill the vector and scratch area. */
+    ctx.iov = tmp->iov;
+    ctx.maxcount = ctx.count;
+    ctx.count = 0;
+    ctx.scratch = (char*)(tmp->iov + ctx.maxcount);
+    ctx.maxlen = ctx.offset;
+    ctx.offset = 0;
+    ctx.scratch_open = false;
+
+    /* emit the value to the list. */
+    retval = vcjson_emit_value(&emitter, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* set the entry count. */
+    tmp->count = ctx.count;
+
+    /* success. Set list. */
+    *list = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_tmp:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Copy data to the scratch area.
+ *
+ * Consecutive copies are coalesced into a single iovec entry.
+ *
+ * \param context       Opaque pointer to the iovec context.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_scratch(
+    void* context, const void* val, size_t size)
+{
+    vcjson_emit_iovec_context* ctx = (vcjson_emit_iovec_context*)context;
+
+    /* start a new scratch entry if the last entry is not in scratch. */
+    if (!ctx->scratch_open)
+    {
+        if (NULL != ctx->iov)
+        {
+            /* verify that we can add an entry. */
+            if (ctx->count >= ctx->maxcount)
+            {
+                return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+            }
+
+            ctx->iov[ctx->count].iov_base = ctx->scratch + ctx->offset;
+            ctx->iov[ctx->count].iov_len = 0;
+        }
+
+        ++ctx->count;
+        ctx->scratch_open = true;
+    }
+
+    if (NULL != ctx->iov)
+    {
+        /* verify that we can write to the scratch area. */
+        if (ctx->offset + size > ctx->maxlen)
+        {
+            return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+        }
+
+        /* write the data, extending the current entry. */
+        memcpy(ctx->scratch + ctx->offset, val, size);
+        ctx->iov[ctx->count - 1].iov_len += size;
+    }
+
+    /* increment offset. */
+    ctx->offset += size;
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Add an iovec entry that refers to data owned by the value.
+ *
+ * \param context       Opaque pointer to the iovec context.
+ * \param val           The buffer to reference.
+ * \param size          The size of this buffer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_reference(
+    void* context, const void* val, size_t size)
+{
+    vcjson_emit_iovec_context* ctx = (vcjson_emit_iovec_context*)context;
+
+    /* short runs are cheaper to copy. */
+    if (size < VCJSON_EMIT_IOVEC_REFERENCE_MINIMUM)
+    {
+        return vcjson_emit_to_scratch(context, val, size);
+    }
+
+    if (NULL != ctx->iov)
+    {
+        /* verify that we can add an entry. */
+        if (ctx->count >= ctx->maxcount)
+        {
+            return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+        }
+
+        ctx->iov[ctx->count].iov_base = (void*)val;
+        ctx->iov[ctx->count].iov_len = size;
+    }
+
+    /* the next copy starts a new scratch entry. */
+    ++ctx->count;
+    ctx->scratch_open = false;
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,816 @@
+/**
+ * \file vcjson_emit_string_parallel.c
+ *
+ * \brief Emit a JSON value as a string using multiple threads.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/* work unit kinds. */
+#define VCJSON_EMIT_PARALLEL_UNIT_LITERAL                                    0
+#define VCJSON_EMIT_PARALLEL_UNIT_KEY                                        1
+#define VCJSON_EMIT_PARALLEL_UNIT_VALUE                                      2
+#define VCJSON_EMIT_PARALLEL_UNIT_OBJECT_MEMBERS                             3
+#define VCJSON_EMIT_PARALLEL_UNIT_ARRAY_ELEMENTS                             4
+
+/* passes over the work units. */
+#define VCJSON_EMIT_PARALLEL_PASS_SIZE                                       0
+#define VCJSON_EMIT_PARALLEL_PASS_WRITE                                      1
+#define VCJSON_EMIT_PARALLEL_PASS_DONE                                       2
+
+/**
+ * \brief A contiguous piece of the emitted output.
+ */
+typedef struct vcjson_emit_parallel_unit vcjson_emit_parallel_unit;
+
+struct vcjson_emit_parallel_unit
+{
+    int kind;
+    const char* literal;
+    const vcjson_string* key;
+    vcjson_value* value;
+    vcjson_object* obj;
+    vcjson_object_cursor start;
+    vcjson_array* arr;
+    size_t begin;
+    size_t count;
+    bool leading_comma;
+    size_t offset;
+    size_t size;
+    bool sensitive;
+    status retval;
+};
+
+typedef struct vcjson_emit_parallel_context vcjson_emit_parallel_context;
+struct vcjson_emit_parallel_context
+{
+    vcjson_emit_parallel_unit* units;
+    size_t count;
+    /* number of units that are chunks of a large container. */
+    size_t chunks;
+    atomic_size_t next;
+    char* outbuf;
+    /* the workers wait on cond between passes. */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int pass;
+    /* number of workers that have finished the current pass. */
+    size_t finished;
+};
+
+typedef struct vcjson_emit_parallel_buffer vcjson_emit_parallel_buffer;
+struct vcjson_emit_parallel_buffer
+{
+    char* outbuf;
+    size_t offset;
+    size_t maxlen;
+};
+
+/* forward decls. */
+static void vcjson_emit_parallel_expand(
+    vcjson_emit_parallel_context* ctx, vcjson_value* value, size_t depth);
+static void vcjson_emit_parallel_add(
+    vcjson_emit_parallel_context* ctx, const vcjson_emit_parallel_unit* unit);
+static void vcjson_emit_parallel_add_literal(
+    vcjson_emit_parallel_context* ctx, const char* literal, size_t size);
+static status vcjson_emit_parallel_start(
+    vcjson_emit_parallel_context* ctx, RCPR_SYM(allocator)* alloc,
+    size_t threads, pthread_t** handles, size_t* started);
+static void vcjson_emit_parallel_begin_pass(
+    vcjson_emit_parallel_context* ctx, int pass);
+static status vcjson_emit_parallel_finish_pass(
+    vcjson_emit_parallel_context* ctx, size_t started);
+static status vcjson_emit_parallel_stop(
+    vcjson_emit_parallel_context* ctx, RCPR_SYM(allocator)* alloc,
+    pthread_t* handles, size_t started);
+static void* vcjson_emit_parallel_worker(void* context);
+static void vcjson_emit_parallel_work(vcjson_emit_parallel_context* ctx);
+static status vcjson_emit_parallel_unit_emit(
+    const vcjson_emitter* emitter, const vcjson_emit_parallel_unit* unit);
+static status vcjson_emit_to_counter(
+    void* context, const void* val, size_t size);
+static status vcjson_emit_to_string(
+    void* context, const void* val, size_t size);
+
+/**
+ * \brief Emit a JSON value as a string using multiple threads.
+ *
+ * Objects and arrays with more than \ref VCJSON_EMIT_PARALLEL_CHUNK_SIZE
+ * members are split into chunks, and smaller containers within
+ * \ref VCJSON_EMIT_PARALLEL_MAXIMUM_DEPTH levels of the root are descended into
+ * so that large nested containers are found. The worker threads are started
+ * once. They compute the size of each chunk in parallel, then write each chunk
+ * in parallel directly to its offset in the output string. The output is
+ * identical to \ref vcjson_emit_string. A value with no container large enough
+ * to split, or a request for a single thread, is emitted on the calling thread
+ * by \ref vcjson_emit_string instead.
+ *
+ * \note On success, this function creates a string that is owned by the caller.
+ * This string is a resource that must be released when no longer in use. The
+ * allocator is only used from the calling thread. The value must not be
+ * modified while this function runs.
+ *
+ * \param string        Pointer to the string pointer to hold the JSON string.
+ * \param alloc         The allocator to use for this operation.
+ * \param value         The JSON value to emit.
+ * \param threads       The number of threads to use, including the calling
+ *                      thread. If 0, one thread per online CPU is used.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_string_parallel(
+    vcjson_string** string, RCPR_SYM(allocator)* alloc, vcjson_value* value,
+    size_t threads)
+{
+    status retval, release_retval;
+    vcjson_emit_parallel_context ctx;
+    size_t size = 0;
+    size_t units_size;
+    bool sensitive = false;
+    vcjson_string* tmp;
+    pthread_t* handles = NULL;
+    size_t started = 0;
+
+    /* use one thread per online CPU by default. */
+    if (0 == threads)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t)cpus : 1;
+    }
+
+    /* with no unit array, the first expansion only counts units. */
+    memset(&ctx, 0, sizeof(ctx));
+    vcjson_emit_parallel_expand(&ctx, value, 0);
+
+    /* without a container to split, threads only add overhead. */
+    if (threads < 2 || 0 == ctx.chunks)
+    {
+        return vcjson_emit_string(string, alloc, value);
+    }
+
+    /* allocate memory for the work units. */
+    units_size = ctx.count * sizeof(vcjson_emit_parallel_unit);
+    retval = allocator_allocate(alloc, (void**)&ctx.units, units_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear the work units. */
+    memset(ctx.units, 0, units_size);
+
+    /* fill the work units. */
+    ctx.count = 0;
+    ctx.chunks = 0;
+    vcjson_emit_parallel_expand(&ctx, value, 0);
+
+    /* start the workers, which begin by computing the size of each unit. */
+    retval =
+        vcjson_emit_parallel_start(&ctx, alloc, threads, &handles, &started);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_units;
+    }
+
+    retval = vcjson_emit_parallel_finish_pass(&ctx, started);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_workers;
+    }
+
+    /* compute the offset of each work unit. */
+    for (size_t i = 0; i < ctx.count; ++i)
+    {
+        ctx.units[i].offset = size;
+        size += ctx.units[i].size;
+        sensitive = sensitive || ctx.units[i].sensitive;
+    }
+
+    /* allocate memory for the string instance and its characters. */
+    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp) + size + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_workers;
+    }
+
+    /* clear structure. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* init resource. */
+    resource_init(&tmp->hdr, &vcjson_string_resource_release);
+
+    /* set the string allocator. */
+    tmp->alloc = alloc;
+
+    /* the string is sensitive if it holds a sensitive string. */
+    tmp->sensitive = sensitive;
+
+    /* the characters follow the instance. */
+    tmp->value = (char*)(tmp + 1);
+
+    /* clear string buffer. */
+    memset(tmp->value, 0, size + 1);
+
+    /* set the string length. */
+    tmp->length = size;
+
+    /* the same workers write each work unit to its offset. */
+    ctx.outbuf = tmp->value;
+    vcjson_emit_parallel_begin_pass(&ctx, VCJSON_EMIT_PARALLEL_PASS_WRITE);
+    retval = vcjson_emit_parallel_finish_pass(&ctx, started);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* success. Set string. */
+    *string = tmp;
+    retval = STATUS_SUCCESS;
+    goto cleanup_workers;
+
+cleanup_tmp:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_workers:
+    release_retval = vcjson_emit_parallel_stop(&ctx, alloc, handles, started);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_units:
+    memset(ctx.units, 0, units_size);
+    release_retval = allocator_reclaim(alloc, ctx.units);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Split a value into work units.
+ *
+ * \note If the context has no unit array, units are only counted.
+ *
+ * \param ctx           The parallel emit context.
+ * \param value         The value to split.
+ * \param depth         The depth of this value in the document.
+ */
+static void vcjson_emit_parallel_expand(
+    vcjson_emit_parallel_context* ctx, vcjson_value* value, size_t depth)
+{
+    vcjson_emit_parallel_unit unit;
+    vcjson_object* obj;
+    vcjson_array* arr;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* member;
+    size_t elements;
+
+    memset(&unit, 0, sizeof(unit));
+
+    if (VCJSON_VALUE_TYPE_OBJECT == value->type)
+    {
+        obj = (vcjson_object*)value->value;
+        elements = vcjson_object_elements(obj);
+
+        /* memoized, empty, and deep objects are emitted as a single unit. */
+        if (NULL != obj->cache.data || 0 == elements
+         || (elements <= VCJSON_EMIT_PARALLEL_CHUNK_SIZE
+                && depth >= VCJSON_EMIT_PARALLEL_MAXIMUM_DEPTH))
+        {
+            goto single_unit;
+        }
+
+        vcjson_emit_parallel_add_literal(ctx, "{", 1);
+
+        /* sort hash storage here, before any worker walks this object. */
+        vcjson_object_cursor_begin(&iter, obj);
+
+        /* split large objects into chunks of members. */
+        if (elements > VCJSON_EMIT_PARALLEL_CHUNK_SIZE)
+        {
+            unit.kind = VCJSON_EMIT_PARALLEL_UNIT_OBJECT_MEMBERS;
+            unit.obj = obj;
+            unit.count = VCJSON_EMIT_PARALLEL_CHUNK_SIZE;
+
+            for (size_t i = 0;
+                 vcjson_object_cursor_member(&key, &member, obj, &iter); ++i)
+            {
+                if (0 == i % VCJSON_EMIT_PARALLEL_CHUNK_SIZE)
+                {
+                    unit.start = iter;
+                    unit.leading_comma = (0 != i);
+                    vcjson_emit_parallel_add(ctx, &unit);
+                    ++ctx->chunks;
+                }
+
+                vcjson_object_cursor_next(&iter, obj);
+            }
+        }
+        /* descend into the members of small objects. */
+        else
+        {
+            unit.kind = VCJSON_EMIT_PARALLEL_UNIT_KEY;
+
+            for (size_t i = 0;
+                 vcjson_object_cursor_member(&key, &member, obj, &iter); ++i)
+            {
+                unit.key = key;
+                unit.leading_comma = (0 != i);
+                vcjson_emit_parallel_add(ctx, &unit);
+
+                vcjson_emit_parallel_expand(ctx, member, depth + 1);
+
+                vcjson_object_cursor_next(&iter, obj);
+            }
+        }
+
+        vcjson_emit_parallel_add_literal(ctx, "}", 1);
+        return;
+    }
+    else if (VCJSON_VALUE_TYPE_ARRAY == value->type)
+    {
+        arr = (vcjson_array*)value->value;
+        elements = vcjson_array_size(arr);
+
+        /* memoized, empty, deep, and small packed arrays are emitted as a
+         * single unit. */
+        if (NULL != arr->cache.data || 0 == elements
+         || (elements <= VCJSON_EMIT_PARALLEL_CHUNK_SIZE
+                && (depth >= VCJSON_EMIT_PARALLEL_MAXIMUM_DEPTH
+                    || NULL != arr->numbers)))
+        {
+            goto single_unit;
+        }
+
+        vcjson_emit_parallel_add_literal(ctx, "[", 1);
+
+        /* split large arrays into chunks of elements. */
+        if (elements > VCJSON_EMIT_PARALLEL_CHUNK_SIZE)
+        {
+            unit.kind = VCJSON_EMIT_PARALLEL_UNIT_ARRAY_ELEMENTS;
+            unit.arr = arr;
+
+            for (size_t i = 0; i < elements;
+                 i += VCJSON_EMIT_PARALLEL_CHUNK_SIZE)
+            {
+                unit.begin = i;
+                unit.count = elements - i;
+                if (unit.count > VCJSON_EMIT_PARALLEL_CHUNK_SIZE)
+                {
+                    unit.count = VCJSON_EMIT_PARALLEL_CHUNK_SIZE;
+                }
+
+                unit.leading_comma = (0 != i);
+                vcjson_emit_parallel_add(ctx, &unit);
+                ++ctx->chunks;
+            }
+        }
+        /* descend into the elements of small arrays. */
+        else
+        {
+            for (size_t i = 0; i < elements; ++i)
+            {
+                if (0 != i)
+                {
+                    vcjson_emit_parallel_add_literal(ctx, ",", 1);
+                }
+
+                vcjson_emit_parallel_expand(ctx, arr->arr[i], depth + 1);
+            }
+        }
+
+        vcjson_emit_parallel_add_literal(ctx, "]", 1);
+        return;
+    }
+
+single_unit:
+    unit.kind = VCJSON_EMIT_PARALLEL_UNIT_VALUE;
+    unit.value = value;
+    vcjson_emit_parallel_add(ctx, &unit);
+}
+
+/**
+ * \brief Add a work unit to the context.
+ *
+ * \param ctx           The parallel emit context.
+ * \param unit          The unit to add.
+ */
+static void vcjson_emit_parallel_add(
+    vcjson_emit_parallel_context* ctx, const vcjson_emit_parallel_unit* unit)
+{
+    if (NULL != ctx->units)
+    {
+        memcpy(&ctx->units[ctx->count], unit, sizeof(*unit));
+    }
+
+    ++ctx->count;
+}
+
+/**
+ * \brief Add a literal work unit to the context.
+ *
+ * \param ctx           The parallel emit context.
+ * \param literal       The literal to emit.
+ * \param size          The size of this literal.
+ */
+static void vcjson_emit_parallel_add_literal(
+    vcjson_emit_parallel_context* ctx, const char* literal, size_t size)
+{
+    vcjson_emit_parallel_unit unit;
+
+    memset(&unit, 0, sizeof(unit));
+    unit.kind = VCJSON_EMIT_PARALLEL_UNIT_LITERAL;
+    unit.literal = literal;
+    unit.count = size;
+
+    vcjson_emit_parallel_add(ctx, &unit);
+}
+
+/**
+ * \brief Start the worker threads for the size pass.
+ *
+ * \note If a worker thread can't be started, the remaining threads pick up
+ * its share of the work. The calling thread works as well, so at most
+ * \p threads - 1 workers are started.
+ *
+ * \param ctx           The parallel emit context.
+ * \param alloc         The allocator to use for thread handles.
+ * \param threads       The number of threads to use.
+ * \param handles       Pointer to receive the worker thread handles.
+ * \param started       Pointer to receive the number of workers started.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_parallel_start(
+    vcjson_emit_parallel_context* ctx, RCPR_SYM(allocator)* alloc,
+    size_t threads, pthread_t** handles, size_t* started)
+{
+    status retval;
+
+    *handles = NULL;
+    *started = 0;
+
+    /* there is no point in starting more threads than there are units. */
+    if (threads > ctx->count)
+    {
+        threads = ctx->count;
+    }
+
+    /* the first pass computes sizes, starting at the first unit. */
+    ctx->outbuf = NULL;
+    ctx->pass = VCJSON_EMIT_PARALLEL_PASS_SIZE;
+    ctx->finished = 0;
+    atomic_store(&ctx->next, 0);
+
+    if (0 != pthread_mutex_init(&ctx->lock, NULL))
+    {
+        return ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    if (0 != pthread_cond_init(&ctx->cond, NULL))
+    {
+        pthread_mutex_destroy(&ctx->lock);
+        return ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* start the worker threads. */
+    if (threads > 1)
+    {
+        retval =
+            allocator_allocate(
+                alloc, (void**)handles, (threads - 1) * sizeof(pthread_t));
+        if (STATUS_SUCCESS != retval)
+        {
+            pthread_cond_destroy(&ctx->cond);
+            pthread_mutex_destroy(&ctx->lock);
+            return retval;
+        }
+
+        for (; *started < threads - 1; ++*started)
+        {
+            if (0 !=
+                    pthread_create(
+                        &(*handles)[*started], NULL,
+                        &vcjson_emit_parallel_worker, ctx))
+            {
+                break;
+            }
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Start the next pass over the work units, waking the workers.
+ *
+ * \note The workers must all have finished the current pass.
+ *
+ * \param ctx           The parallel emit context.
+ * \param pass          The pass to start.
+ */
+static void vcjson_emit_parallel_begin_pass(
+    vcjson_emit_parallel_context* ctx, int pass)
+{
+    pthread_mutex_lock(&ctx->lock);
+    ctx->finished = 0;
+    atomic_store(&ctx->next, 0);
+    ctx->pass = pass;
+    pthread_cond_broadcast(&ctx->cond);
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+/**
+ * \brief Work on the current pass from the calling thread, then wait for the
+ * workers to finish it.
+ *
+ * If the context has no output buffer, the size of each unit is computed.
+ * Otherwise, each unit is written to its offset in the output buffer.
+ *
+ * \param ctx           The parallel emit context.
+ * \param started       The number of workers started.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_parallel_finish_pass(
+    vcjson_emit_parallel_context* ctx, size_t started)
+{
+    /* the calling thread works too. */
+    vcjson_emit_parallel_work(ctx);
+
+    /* wait for the workers. */
+    pthread_mutex_lock(&ctx->lock);
+    while (ctx->finished < started)
+    {
+        pthread_cond_wait(&ctx->cond, &ctx->lock);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    /* report the first unit error. */
+    for (size_t i = 0; i < ctx->count; ++i)
+    {
+        if (STATUS_SUCCESS != ctx->units[i].retval)
+        {
+            return ctx->units[i].retval;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Stop the worker threads and release their resources.
+ *
+ * \note The workers must all have finished the current pass.
+ *
+ * \param ctx           The parallel emit context.
+ * \param alloc         The allocator used for thread handles.
+ * \param handles       The worker thread handles.
+ * \param started       The number of workers started.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_parallel_stop(
+    vcjson_emit_parallel_context* ctx, RCPR_SYM(allocator)* alloc,
+    pthread_t* handles, size_t started)
+{
+    status retval = STATUS_SUCCESS;
+
+    /* wake the workers so that they exit, and wait for them. */
+    vcjson_emit_parallel_begin_pass(ctx, VCJSON_EMIT_PARALLEL_PASS_DONE);
+    for (size_t i = 0; i < started; ++i)
+    {
+        pthread_join(handles[i], NULL);
+    }
+
+    pthread_cond_destroy(&ctx->cond);
+    pthread_mutex_destroy(&ctx->lock);
+
+    /* reclaim thread handles. */
+    if (NULL != handles)
+    {
+        retval = allocator_reclaim(alloc, handles);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Work on each pass until the workers are stopped.
+ *
+ * \param context       Opaque pointer to the parallel emit context.
+ *
+ * \returns NULL.
+ */
+static void* vcjson_emit_parallel_worker(void* context)
+{
+    vcjson_emit_parallel_context* ctx = (vcjson_emit_parallel_context*)context;
+    int pass = VCJSON_EMIT_PARALLEL_PASS_SIZE;
+
+    while (VCJSON_EMIT_PARALLEL_PASS_DONE != pass)
+    {
+        vcjson_emit_parallel_work(ctx);
+
+        /* report this pass as finished, and wait for the next one. */
+        pthread_mutex_lock(&ctx->lock);
+        ++ctx->finished;
+        pthread_cond_broadcast(&ctx->cond);
+        while (ctx->pass == pass)
+        {
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+        }
+        pass = ctx->pass;
+        pthread_mutex_unlock(&ctx->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Process work units of the current pass until none remain.
+ *
+ * \param ctx           The parallel emit context.
+ */
+static void vcjson_emit_parallel_work(vcjson_emit_parallel_context* ctx)
+{
+    vcjson_emit_parallel_unit* unit;
+    vcjson_emit_parallel_buffer buffer;
+    vcjson_emitter emitter;
+    size_t i;
+
+    for (;;)
+    {
+        /* claim the next unit. */
+        i = atomic_fetch_add(&ctx->next, 1);
+        if (i >= ctx->count)
+        {
+            break;
+        }
+
+        unit = &ctx->units[i];
+
+        /* with no output buffer, count the size of this unit. */
+        if (NULL == ctx->outbuf)
+        {
+            unit->size = 0;
+            unit->sensitive = false;
+            emitter.emit = &vcjson_emit_to_counter;
+            emitter.emit_reference = NULL;
+            emitter.context = &unit->size;
+            emitter.sensitive = &unit->sensitive;
+        }
+        /* otherwise, write this unit to its offset. */
+        else
+        {
+            buffer.outbuf = ctx->outbuf + unit->offset;
+            buffer.offset = 0;
+            buffer.maxlen = unit->size;
+            emitter.emit = &vcjson_emit_to_string;
+            emitter.emit_reference = NULL;
+            emitter.context = &buffer;
+            emitter.sensitive = NULL;
+        }
+
+        unit->retval = vcjson_emit_parallel_unit_emit(&emitter, unit);
+    }
+}
+
+/**
+ * \brief Emit a single work unit.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param unit          The unit to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_parallel_unit_emit(
+    const vcjson_emitter* emitter, const vcjson_emit_parallel_unit* unit)
+{
+    status retval;
+
+    switch (unit->kind)
+    {
+        case VCJSON_EMIT_PARALLEL_UNIT_LITERAL:
+            return emitter->emit(emitter->context, unit->literal, unit->count);
+
+        case VCJSON_EMIT_PARALLEL_UNIT_KEY:
+            if (unit->leading_comma)
+            {
+                retval = emitter->emit(emitter->context, ",", 1);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+            }
+
+            retval = vcjson_emit_decoded_string(emitter, unit->key);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            return emitter->emit(emitter->context, ":", 1);
+
+        case VCJSON_EMIT_PARALLEL_UNIT_VALUE:
+            return vcjson_emit_value(emitter, unit->value);
+
+        case VCJSON_EMIT_PARALLEL_UNIT_OBJECT_MEMBERS:
+            return
+                vcjson_emit_object_members(
+                    emitter, unit->obj, &unit->start, unit->count,
+                    unit->leading_comma);
+
+        case VCJSON_EMIT_PARALLEL_UNIT_ARRAY_ELEMENTS:
+            return
+                vcjson_emit_array_elements(
+                    emitter, unit->arr, unit->begin, unit->begin + unit->count,
+                    unit->leading_comma);
+
+        default:
+            return ERROR_VCJSON_EMIT_UNKNOWN_VALUE_TYPE;
+    }
+}
+
+/**
+ * \brief Accumulate writes to a total size.
+ *
+ * \param context       Opaque pointer to the counter for this operation.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_counter(
+    void* context, const void* /*val*/, size_t size)
+{
+    size_t* count = (size_t*)context;
+
+    *count += size;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write to the output buffer.
+ *
+ * \param context       Opaque pointer to the output buffer.
+ * \param val           The buffer to write.
+ * \param size          The size to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_to_string(
+    void* context, const void* val, size_t size)
+{
+    vcjson_emit_parallel_buffer* ctx = (vcjson_emit_parallel_buffer*)context;
+
+    /* verify that we can write to this buffer. */
+    if (ctx->offset + size > ctx->maxlen)
+    {
+        return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+    }
+
+    /* write the data to the buffer. */
+    memcpy(ctx->outbuf + ctx->offset, val, size);
+
+    /* increment offset. */
+    ctx->offset += size;
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
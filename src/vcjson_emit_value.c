@@ -0,0 +1,643 @@
+/**
+ * \file vcjson_emit_value.c
+ *
+ * \brief Emit a JSON value using an emitter function.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static status vcjson_emit_value_bool(
+    const vcjson_emitter* emitter, vcjson_value* value);
+static status vcjson_emit_value_number(
+    const vcjson_emitter* emitter, vcjson_value* value);
+static status vcjson_emit_value_string(
+    const vcjson_emitter* emitter, vcjson_value* value);
+static status vcjson_emit_reference(
+    const vcjson_emitter* emitter, const void* val, size_t size);
+static status vcjson_emit_value_string_simple_escape(
+    const vcjson_emitter* emitter, char escape);
+static status vcjson_emit_value_object(
+    const vcjson_emitter* emitter, vcjson_value* value);
+static status vcjson_emit_value_array(
+    const vcjson_emitter* emitter, vcjson_value* value);
+
+/**
+ * \brief Emit a JSON value using the given emitter.
+ *
+ * \note This function does not allocate memory. All output is passed to the
+ * emitter function, which is responsible for any buffering. Bytes passed to
+ * the emitter's reference function remain valid until \p value is modified or
+ * released.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_value(const vcjson_emitter* emitter, vcjson_value* value)
+{
+    switch (vcjson_value_type(value))
+    {
+        case VCJSON_VALUE_TYPE_NULL:
+            return emitter->emit(emitter->context, "null", 4);
+
+        case VCJSON_VALUE_TYPE_BOOL:
+            return vcjson_emit_value_bool(emitter, value);
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            return vcjson_emit_value_number(emitter, value);
+
+        case VCJSON_VALUE_TYPE_STRING:
+            return vcjson_emit_value_string(emitter, value);
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return vcjson_emit_value_object(emitter, value);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return vcjson_emit_value_array(emitter, value);
+
+        default:
+            return ERROR_VCJSON_EMIT_UNKNOWN_VALUE_TYPE;
+    }
+}
+
+/**
+ * \brief Emit a JSON boolean using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_value_bool(
+    const vcjson_emitter* emitter, vcjson_value* value)
+{
+    status retval;
+    vcjson_bool* boolval;
+
+    /* get the boolean value. */
+    retval = vcjson_value_get_bool(&boolval, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* if the value is true, emit true. */
+    if (VCJSON_TRUE == boolval)
+    {
+        return emitter->emit(emitter->context, "true", 4);
+    }
+    /* otherwise, emit false. */
+    else
+    {
+        return emitter->emit(emitter->context, "false", 5);
+    }
+}
+
+/**
+ * \brief Emit a JSON number using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_value_number(
+    const vcjson_emitter* emitter, vcjson_value* value)
+{
+    status retval;
+    vcjson_number* numberval;
+
+    /* get the number value. */
+    retval = vcjson_value_get_number(&numberval, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return vcjson_emit_number(emitter, vcjson_number_value(numberval));
+}
+
+/**
+ * \brief Emit a JSON number from its double value using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param number        The number to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_number(const vcjson_emitter* emitter, double number)
+{
+    status retval;
+    char buffer[1024];
+    size_t buffersize = sizeof(buffer);
+    int maxsize;
+
+    /* format the number. */
+    maxsize = snprintf(buffer, buffersize, "%f", number);
+    if (maxsize < 0)
+    {
+        retval = ERROR_VCJSON_EMIT_NUMBER_FORMAT;
+        goto cleanup_buffer;
+    }
+    else if ((size_t)maxsize > buffersize)
+    {
+        maxsize = buffersize-1;
+    }
+
+    /* emit the value. */
+    retval = emitter->emit(emitter->context, buffer, maxsize);
+    goto cleanup_buffer;
+
+cleanup_buffer:
+    /* clear only the formatted text, instead of the whole buffer. */
+    if (maxsize > 0)
+    {
+        memset(buffer, 0, maxsize);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Emit a JSON string using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_value_string(
+    const vcjson_emitter* emitter, vcjson_value* value)
+{
+    status retval;
+    vcjson_string* stringval;
+
+    /* get the string value. */
+    retval = vcjson_value_get_string(&stringval, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* emit the decoded string value. */
+    return vcjson_emit_decoded_string(emitter, stringval);
+}
+
+/**
+ * \brief Emit a decoded JSON string using the given emitter.
+ *
+ * Runs of bytes that do not require escaping are passed to the emitter in a
+ * single call. These runs point directly into the string's storage.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param stringval     The JSON string to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_decoded_string(
+    const vcjson_emitter* emitter, const vcjson_string* stringval)
+{
+    status retval;
+    const char* str;
+    size_t length;
+    size_t run_start = 0;
+    char escape;
+
+    /* get the string. */
+    str = vcjson_string_value(stringval, &length);
+
+    /* note that the output holds a sensitive string. */
+    if (stringval->sensitive && NULL != emitter->sensitive)
+    {
+        *emitter->sensitive = true;
+    }
+
+    /* emit the open quote. */
+    retval = emitter->emit(emitter->context, "\"", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* iterate over all string bytes. */
+    for (size_t i = 0; i < length; ++i)
+    {
+        switch (str[i])
+        {
+            case '\b':
+                escape = 'b';
+                break;
+
+            case '\f':
+                escape = 'f';
+                break;
+
+            case '\n':
+                escape = 'n';
+                break;
+
+            case '\r':
+                escape = 'r';
+                break;
+
+            case '\t':
+                escape = 't';
+                break;
+
+            case '\\':
+                escape = '\\';
+                break;
+
+            case '/':
+                escape = '/';
+                break;
+
+            case '"':
+                escape = '"';
+                break;
+
+            /* TODO - handle other control chars once \u support is added. */
+
+            /* all other bytes are part of the current run. */
+            default:
+                continue;
+        }
+
+        /* emit the run of bytes preceding this escape. */
+        if (i > run_start)
+        {
+            retval =
+                vcjson_emit_reference(emitter, str + run_start, i - run_start);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+        }
+
+        /* emit the escape. */
+        retval =
+            vcjson_emit_value_string_simple_escape(emitter, escape);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* the next run starts after this byte. */
+        run_start = i + 1;
+    }
+
+    /* emit the final run of bytes. */
+    if (length > run_start)
+    {
+        retval =
+            vcjson_emit_reference(
+                emitter, str + run_start, length - run_start);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
+    /* emit the close quote. */
+    retval = emitter->emit(emitter->context, "\"", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Emit bytes owned by the value being emitted.
+ *
+ * If the emitter has a reference function, then these bytes are passed to it
+ * instead of the emit function, so that it can refer to them without copying.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param val           Pointer to the bytes to emit.
+ * \param size          The number of bytes to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_reference(
+    const vcjson_emitter* emitter, const void* val, size_t size)
+{
+    if (NULL != emitter->emit_reference)
+    {
+        return emitter->emit_reference(emitter->context, val, size);
+    }
+    else
+    {
+        return emitter->emit(emitter->context, val, size);
+    }
+}
+
+/**
+ * \brief Emit a simple escape sequence using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param escape        The escape to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_value_string_simple_escape(
+    const vcjson_emitter* emitter, char escape)
+{
+    const char buffer[2] = { '\\', escape };
+
+    return emitter->emit(emitter->context, buffer, sizeof(buffer));
+}
+
+/**
+ * \brief Emit a JSON object using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_value_object(
+    const vcjson_emitter* emitter, vcjson_value* value)
+{
+    status retval;
+    vcjson_object* objval;
+    vcjson_object_cursor start;
+
+    /* read the object directly, so that emitting never copies a shared one. */
+    objval = (vcjson_object*)value->value;
+
+    /* if this object's emitted form is memoized, emit it as-is. */
+    if (NULL != objval->cache.data)
+    {
+        if (objval->cache.sensitive && NULL != emitter->sensitive)
+        {
+            *emitter->sensitive = true;
+        }
+
+        retval =
+            vcjson_emit_reference(
+                emitter, objval->cache.data, objval->cache.size);
+        goto done;
+    }
+
+    /* emit the open brace. */
+    retval = emitter->emit(emitter->context, "{", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* emit all members. */
+    vcjson_object_cursor_begin(&start, objval);
+    retval =
+        vcjson_emit_object_members(
+            emitter, objval, &start, vcjson_object_elements(objval), false);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* emit the close brace. */
+    retval = emitter->emit(emitter->context, "}", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Emit a run of JSON object members using the given emitter.
+ *
+ * \note Members are visited with a cursor, so no iterator is allocated.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param obj           The object holding these members.
+ * \param start         The cursor of the first member to emit.
+ * \param count         The maximum number of members to emit.
+ * \param leading_comma Set to true if a comma precedes the first member.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_object_members(
+    const vcjson_emitter* emitter, vcjson_object* obj,
+    const vcjson_object_cursor* start, size_t count, bool leading_comma)
+{
+    status retval = STATUS_SUCCESS;
+    vcjson_object_cursor iter = *start;
+    const vcjson_string* key;
+    vcjson_value* value;
+    bool emit_comma = leading_comma;
+
+    /* iterate through these members. */
+    for (size_t i = 0;
+         i < count && vcjson_object_cursor_member(&key, &value, obj, &iter);
+         ++i)
+    {
+        /* should we emit a comma? */
+        if (emit_comma)
+        {
+            retval = emitter->emit(emitter->context, ",", 1);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+        }
+
+        /* emit the key string. */
+        retval = vcjson_emit_decoded_string(emitter, key);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* emit the colon. */
+        retval = emitter->emit(emitter->context, ":", 1);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* emit the value. */
+        retval = vcjson_emit_value(emitter, value);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* emit a comma for each subsequent member. */
+        emit_comma = true;
+
+        /* get the next member in this object. */
+        vcjson_object_cursor_next(&iter, obj);
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Emit a JSON array using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_emit_value_array(
+    const vcjson_emitter* emitter, vcjson_value* value)
+{
+    status retval;
+    vcjson_array* arrayval;
+
+    /* read the array directly, so that emitting never copies a shared one. */
+    arrayval = (vcjson_array*)value->value;
+
+    /* if this array's emitted form is memoized, emit it as-is. */
+    if (NULL != arrayval->cache.data)
+    {
+        if (arrayval->cache.sensitive && NULL != emitter->sensitive)
+        {
+            *emitter->sensitive = true;
+        }
+
+        retval =
+            vcjson_emit_reference(
+                emitter, arrayval->cache.data, arrayval->cache.size);
+        goto done;
+    }
+
+    /* emit the open bracket. */
+    retval = emitter->emit(emitter->context, "[", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* emit all array elements. */
+    retval =
+        vcjson_emit_array_elements(
+            emitter, arrayval, 0, vcjson_array_size(arrayval), false);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* emit the close bracket. */
+    retval = emitter->emit(emitter->context, "]", 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Emit a run of JSON array elements using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param arr           The array holding these elements.
+ * \param begin         The offset of the first element to emit.
+ * \param end           The offset one past the last element to emit.
+ * \param leading_comma Set to true if a comma precedes the first element.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_array_elements(
+    const vcjson_emitter* emitter, vcjson_array* arr, size_t begin,
+    size_t end, bool leading_comma)
+{
+    status retval = STATUS_SUCCESS;
+    vcjson_value* val;
+    bool emit_comma = leading_comma;
+
+    /* iterate through these array elements. */
+    for (size_t i = begin; i < end; ++i)
+    {
+        /* should we emit a comma? */
+        if (emit_comma)
+        {
+            retval = emitter->emit(emitter->context, ",", 1);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+        }
+
+        /* packed numbers are emitted without boxing them. */
+        if (NULL != arr->numbers)
+        {
+            retval = vcjson_emit_number(emitter, arr->numbers[i]);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+
+            emit_comma = true;
+            continue;
+        }
+
+        /* get the array value at this offset. */
+        retval = vcjson_array_get(&val, arr, i);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* emit the value. */
+        retval = vcjson_emit_value(emitter, val);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* we need to emit a comma for all subsequent elements. */
+        emit_comma = true;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,48 @@
+/**
+ * \file vcjson_frozen_array_get.c
+ *
+ * \brief Get an element of a frozen array.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the value at the given offset of the \ref vcjson_frozen_array
+ * instance.
+ *
+ * \note The returned value is owned by the frozen instance holding this array,
+ * and shares its lifetime.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param arr           The array instance for this operation.
+ * \param offset        The offset of the element to get.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS if \p offset is past the end of
+ *        this array.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_array_get(
+    const vcjson_frozen_value** value, const vcjson_frozen_array* arr,
+    size_t offset)
+{
+    const vcjson_frozen_value* elements;
+
+    if (offset >= arr->value.count)
+    {
+        return ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS;
+    }
+
+    /* the elements are found relative to this entry. */
+    elements =
+        (const vcjson_frozen_value*)
+            ((const uint8_t*)arr + arr->value.payload.offset);
+
+    *value = &elements[offset];
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,24 @@
+/**
+ * \file vcjson_frozen_array_size.c
+ *
+ * \brief Get the number of elements in a frozen array.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the number of elements in the given \ref vcjson_frozen_array
+ * instance.
+ *
+ * \param arr           The array instance for this operation.
+ *
+ * \returns the number of elements in this array.
+ */
+size_t vcjson_frozen_array_size(const vcjson_frozen_array* arr)
+{
+    return arr->value.count;
+}
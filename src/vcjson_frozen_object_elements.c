@@ -0,0 +1,24 @@
+/**
+ * \file vcjson_frozen_object_elements.c
+ *
+ * \brief Get the number of members in a frozen object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the number of members in the given \ref vcjson_frozen_object
+ * instance.
+ *
+ * \param obj           The object instance for this operation.
+ *
+ * \returns the number of members in this object.
+ */
+size_t vcjson_frozen_object_elements(const vcjson_frozen_object* obj)
+{
+    return obj->value.count;
+}
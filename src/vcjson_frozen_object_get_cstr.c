@@ -0,0 +1,36 @@
+/**
+ * \file vcjson_frozen_object_get_cstr.c
+ *
+ * \brief Get a value from a frozen object by C string key.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get a value from the \ref vcjson_frozen_object instance using the
+ * given C string key.
+ *
+ * \note The returned value is owned by the frozen instance holding this
+ * object, and shares its lifetime.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The NUL-terminated key for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_object_get_cstr(
+    const vcjson_frozen_value** value, const vcjson_frozen_object* obj,
+    const char* key)
+{
+    return
+        vcjson_frozen_object_get_raw(value, obj, key, strlen(key));
+}
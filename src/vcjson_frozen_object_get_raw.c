@@ -0,0 +1,80 @@
+/**
+ * \file vcjson_frozen_object_get_raw.c
+ *
+ * \brief Get a value from a frozen object by key.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get a value from the \ref vcjson_frozen_object instance using the
+ * given key bytes.
+ *
+ * Members are stored in sorted key order, so the key is found by binary
+ * search.
+ *
+ * \note The returned value is owned by the frozen instance holding this
+ * object, and shares its lifetime.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The key bytes for this operation.
+ * \param length        The length of the key, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_object_get_raw(
+    const vcjson_frozen_value** value, const vcjson_frozen_object* obj,
+    const char* key, size_t length)
+{
+    const vcjson_frozen_value* members =
+        (const vcjson_frozen_value*)
+            ((const uint8_t*)obj + obj->value.payload.offset);
+    const vcjson_frozen_value* keyentry;
+    size_t low = 0, high = obj->value.count, mid, min_length;
+    int res;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        keyentry = &members[2 * mid];
+
+        /* compare keys in the same order as an object's tree. */
+        min_length = length < keyentry->count ? length : keyentry->count;
+        res =
+            memcmp(
+                key, (const char*)keyentry + keyentry->payload.offset,
+                min_length);
+        if (0 == res)
+        {
+            res =
+                (length < keyentry->count)
+                    ? -1
+                    : (length > keyentry->count) ? 1 : 0;
+        }
+
+        if (res < 0)
+        {
+            high = mid;
+        }
+        else if (res > 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            *value = keyentry + 1;
+            return STATUS_SUCCESS;
+        }
+    }
+
+    return ERROR_VCJSON_KEY_NOT_FOUND;
+}
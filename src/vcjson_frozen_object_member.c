@@ -0,0 +1,57 @@
+/**
+ * \file vcjson_frozen_object_member.c
+ *
+ * \brief Get a member of a frozen object by position.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the member at the given position of the
+ * \ref vcjson_frozen_object instance.
+ *
+ * Members are stored in sorted key order, so walking the positions from zero
+ * visits the members in the order in which an object emits them.
+ *
+ * \note The returned key and value are owned by the frozen instance holding
+ * this object, and share its lifetime.
+ *
+ * \param key           Pointer to receive the ASCIIZ key on success.
+ * \param length        Pointer to receive the length of the key on success.
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param offset        The position of the member to get.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_ITERATOR_END if \p offset is past the last member.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_object_member(
+    const char** key, size_t* length, const vcjson_frozen_value** value,
+    const vcjson_frozen_object* obj, size_t offset)
+{
+    const vcjson_frozen_value* members;
+    const vcjson_frozen_value* keyentry;
+
+    if (offset >= obj->value.count)
+    {
+        return ERROR_VCJSON_ITERATOR_END;
+    }
+
+    /* each member is a key entry followed by a value entry. */
+    members =
+        (const vcjson_frozen_value*)
+            ((const uint8_t*)obj + obj->value.payload.offset);
+    keyentry = &members[2 * offset];
+
+    *key = (const char*)keyentry + keyentry->payload.offset;
+    *length = keyentry->count;
+    *value = keyentry + 1;
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file vcjson_frozen_resource_handle.c
+ *
+ * \brief Get the resource handle for a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the resource handle for the given \ref vcjson_frozen instance.
+ *
+ * \param frozen        The instance for this accessor.
+ *
+ * \returns the resource handle for this instance.
+ */
+RCPR_SYM(resource)* vcjson_frozen_resource_handle(vcjson_frozen* frozen)
+{
+    return &frozen->hdr;
+}
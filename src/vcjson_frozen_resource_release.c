@@ -0,0 +1,50 @@
+/**
+ * \file vcjson_frozen_resource_release.c
+ *
+ * \brief Release a frozen value resource.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <sys/mman.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Release a \ref vcjson_frozen.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_resource_release(RCPR_SYM(resource)* r)
+{
+    vcjson_frozen* frozen = (vcjson_frozen*)r;
+
+    /* cache allocator. */
+    allocator* alloc = frozen->alloc;
+
+    /* unmap the snapshot holding the tape. */
+    if (NULL != frozen->mapping)
+    {
+        munmap(frozen->mapping, frozen->mapping_size);
+    }
+
+    /* clear the tape if it holds sensitive strings. */
+    if (frozen->sensitive)
+    {
+        memset(frozen, 0, frozen->size);
+    }
+    /* otherwise, only clear the header. */
+    else
+    {
+        memset(frozen, 0, sizeof(*frozen));
+    }
+
+    /* reclaim memory. */
+    return
+        allocator_reclaim(alloc, frozen);
+}
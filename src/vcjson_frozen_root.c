@@ -0,0 +1,25 @@
+/**
+ * \file vcjson_frozen_root.c
+ *
+ * \brief Get the root value of a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the root value of the given \ref vcjson_frozen instance.
+ *
+ * \note The returned value is owned by this instance and shares its lifetime.
+ *
+ * \param frozen        The frozen instance for this operation.
+ *
+ * \returns the root value of this instance.
+ */
+const vcjson_frozen_value* vcjson_frozen_root(const vcjson_frozen* frozen)
+{
+    return frozen->tape;
+}
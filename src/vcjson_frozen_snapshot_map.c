@@ -0,0 +1,326 @@
+/**
+ * \file vcjson_frozen_snapshot_map.c
+ *
+ * \brief Map a snapshot file as a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/* forward decls. */
+static status vcjson_frozen_snapshot_validate(
+    RCPR_SYM(allocator)* alloc, const uint8_t* mapping, size_t size,
+    uint32_t flags);
+static status vcjson_frozen_snapshot_validate_tape(
+    RCPR_SYM(allocator)* alloc, const uint8_t* tape, size_t size);
+
+/**
+ * \brief Map a snapshot written by \ref vcjson_frozen_snapshot_write as a
+ * \ref vcjson_frozen instance.
+ *
+ * The file is mapped read-only, and its header is validated: its magic,
+ * version, byte order, size, and checksum must all match. Unless
+ * \ref VCJSON_SNAPSHOT_FLAG_NO_VERIFY is given, the checksum of the tape is
+ * verified as well. The structure of the tape is always checked in one pass
+ * over its entries: every type tag must be known, every object key must be a
+ * string, and every member, element, and string must lie inside the tape.
+ * The tape is then read in place through the mapping, so no part of the
+ * snapshot is parsed or copied.
+ *
+ * \note On success, this function creates a \ref vcjson_frozen instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle, which unmaps the file. Checksums detect a corrupt or truncated
+ * file, and the structural checks keep a tape that passes them from being read
+ * outside of the mapping.
+ *
+ * \param frozen        Pointer to the frozen pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param path          The path of the snapshot file.
+ * \param flags         Any combination of \ref vcjson_snapshot_flags.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_SNAPSHOT_IO if the file could not be opened or mapped.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_HEADER if the file is not a snapshot of
+ *        this version and byte order, or is truncated.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_CHECKSUM if the tape is corrupt.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_TAPE if the tape is not laid out as a
+ *        frozen value.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_snapshot_map(
+    vcjson_frozen** frozen, RCPR_SYM(allocator)* alloc, const char* path,
+    uint32_t flags)
+{
+    status retval;
+    int fd;
+    struct stat st;
+    void* mapping;
+    size_t size;
+    vcjson_frozen* tmp;
+
+    /* open the file. */
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        retval = ERROR_VCJSON_SNAPSHOT_IO;
+        goto done;
+    }
+
+    /* a file too short to hold a header is not a snapshot. */
+    if (0 != fstat(fd, &st))
+    {
+        retval = ERROR_VCJSON_SNAPSHOT_IO;
+        goto cleanup_fd;
+    }
+
+    size = (size_t)st.st_size;
+    if (size < sizeof(vcjson_snapshot_header) + sizeof(vcjson_frozen_value))
+    {
+        retval = ERROR_VCJSON_SNAPSHOT_BAD_HEADER;
+        goto cleanup_fd;
+    }
+
+    /* map the file; the mapping outlives the descriptor. */
+    mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == mapping)
+    {
+        retval = ERROR_VCJSON_SNAPSHOT_IO;
+        goto cleanup_fd;
+    }
+
+    /* validate the snapshot. */
+    retval =
+        vcjson_frozen_snapshot_validate(
+            alloc, (const uint8_t*)mapping, size, flags);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mapping;
+    }
+
+    /* allocate the frozen instance. */
+    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mapping;
+    }
+
+    /* the tape follows the header in the mapping. */
+    memset(tmp, 0, sizeof(*tmp));
+    resource_init(&tmp->hdr, &vcjson_frozen_resource_release);
+    tmp->alloc = alloc;
+    tmp->tape =
+        (vcjson_frozen_value*)
+            ((uint8_t*)mapping + sizeof(vcjson_snapshot_header));
+    tmp->tape_size = size - sizeof(vcjson_snapshot_header);
+    tmp->size = sizeof(*tmp);
+    tmp->mapping = mapping;
+    tmp->mapping_size = size;
+
+    /* success. */
+    *frozen = tmp;
+    retval = STATUS_SUCCESS;
+    goto cleanup_fd;
+
+cleanup_mapping:
+    munmap(mapping, size);
+
+cleanup_fd:
+    close(fd);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Validate the header and tape of a mapped snapshot.
+ *
+ * \param alloc         The allocator to use for this operation.
+ * \param mapping       The mapped snapshot.
+ * \param size          The size of the snapshot, in bytes.
+ * \param flags         Any combination of \ref vcjson_snapshot_flags.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_HEADER if the header is invalid.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_CHECKSUM if the tape is corrupt.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_TAPE if the tape is not laid out as a
+ *        frozen value.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_frozen_snapshot_validate(
+    RCPR_SYM(allocator)* alloc, const uint8_t* mapping, size_t size,
+    uint32_t flags)
+{
+    const vcjson_snapshot_header* header =
+        (const vcjson_snapshot_header*)mapping;
+    const uint8_t* tape = mapping + sizeof(*header);
+
+    /* the header must be intact, and written by a compatible host. */
+    if (0 != memcmp(header->magic, VCJSON_SNAPSHOT_MAGIC, sizeof(header->magic))
+     || VCJSON_SNAPSHOT_VERSION != header->version
+     || VCJSON_SNAPSHOT_BYTE_ORDER != header->byte_order
+     || header->header_checksum
+            != vcjson_snapshot_checksum(
+                    header, offsetof(vcjson_snapshot_header, header_checksum)))
+    {
+        return ERROR_VCJSON_SNAPSHOT_BAD_HEADER;
+    }
+
+    /* the tape must fill the rest of the file. */
+    if (header->tape_size != size - sizeof(*header))
+    {
+        return ERROR_VCJSON_SNAPSHOT_BAD_HEADER;
+    }
+
+    /* the tape must match its checksum, unless that is skipped. */
+    if (!(flags & VCJSON_SNAPSHOT_FLAG_NO_VERIFY)
+     && header->tape_checksum
+            != vcjson_snapshot_checksum(tape, header->tape_size))
+    {
+        return ERROR_VCJSON_SNAPSHOT_BAD_CHECKSUM;
+    }
+
+    /* the accessors trust the tape, so its structure is always checked. */
+    return
+        vcjson_frozen_snapshot_validate_tape(alloc, tape, header->tape_size);
+}
+
+/**
+ * \brief Check that a tape is laid out as a frozen value, so that reading it
+ * never strays outside of the tape.
+ *
+ * Entries are checked in order, starting with the root and continuing through
+ * the last entry that any container refers to. Every entry must have a known
+ * type; the characters of a string and their terminator must lie inside the
+ * tape; and the members or elements of a container must be whole entries
+ * after it and inside the tape, with a string for every object key. Each
+ * entry may belong to at most one container, which keeps the tape a tree and
+ * the check linear in its size.
+ *
+ * \param alloc         The allocator to use for this operation.
+ * \param tape          The tape to check.
+ * \param size          The size of the tape, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_SNAPSHOT_BAD_TAPE if the tape is not laid out as a
+ *        frozen value.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_frozen_snapshot_validate_tape(
+    RCPR_SYM(allocator)* alloc, const uint8_t* tape, size_t size)
+{
+    status retval, release_retval;
+    const vcjson_frozen_value* entries = (const vcjson_frozen_value*)tape;
+    size_t capacity = size / sizeof(*entries);
+    size_t end = 1, at, first, count;
+    uint64_t offset;
+    uint8_t* claimed;
+
+    /* one bit per entry records whether a container has claimed it. */
+    retval = allocator_allocate(alloc, (void**)&claimed, capacity / 8 + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(claimed, 0, capacity / 8 + 1);
+
+    for (size_t i = 0; i < end; ++i)
+    {
+        at = i * sizeof(*entries);
+        offset = entries[i].payload.offset;
+
+        switch (entries[i].type)
+        {
+            case VCJSON_VALUE_TYPE_NULL:
+            case VCJSON_VALUE_TYPE_BOOL:
+            case VCJSON_VALUE_TYPE_NUMBER:
+                break;
+
+            case VCJSON_VALUE_TYPE_STRING:
+                /* the characters and their terminator are inside the tape. */
+                if (offset > size - at
+                 || (uint64_t)entries[i].count >= size - at - offset
+                 || 0 != tape[at + offset + entries[i].count])
+                {
+                    retval = ERROR_VCJSON_SNAPSHOT_BAD_TAPE;
+                    goto cleanup_claimed;
+                }
+                break;
+
+            case VCJSON_VALUE_TYPE_OBJECT:
+            case VCJSON_VALUE_TYPE_ARRAY:
+                count = entries[i].count;
+                if (VCJSON_VALUE_TYPE_OBJECT == entries[i].type)
+                {
+                    count *= 2;
+                }
+
+                /* the children are whole entries after this one. */
+                if (0 == offset || 0 != offset % sizeof(*entries)
+                 || offset / sizeof(*entries) > capacity - i
+                 || count > capacity - i - offset / sizeof(*entries))
+                {
+                    retval = ERROR_VCJSON_SNAPSHOT_BAD_TAPE;
+                    goto cleanup_claimed;
+                }
+
+                first = i + offset / sizeof(*entries);
+                for (size_t j = first; j < first + count; ++j)
+                {
+                    /* no two containers share a child, and keys are
+                     * strings. */
+                    if ((claimed[j / 8] & (1 << (j % 8)))
+                     || (VCJSON_VALUE_TYPE_OBJECT == entries[i].type
+                      && 0 == (j - first) % 2
+                      && VCJSON_VALUE_TYPE_STRING != entries[j].type))
+                    {
+                        retval = ERROR_VCJSON_SNAPSHOT_BAD_TAPE;
+                        goto cleanup_claimed;
+                    }
+
+                    claimed[j / 8] |= (uint8_t)(1 << (j % 8));
+                }
+
+                /* the children are checked in turn. */
+                if (first + count > end)
+                {
+                    end = first + count;
+                }
+                break;
+
+            default:
+                retval = ERROR_VCJSON_SNAPSHOT_BAD_TAPE;
+                goto cleanup_claimed;
+        }
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_claimed;
+
+cleanup_claimed:
+    release_retval = allocator_reclaim(alloc, claimed);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
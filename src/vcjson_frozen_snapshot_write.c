@@ -0,0 +1,69 @@
+/**
+ * \file vcjson_frozen_snapshot_write.c
+ *
+ * \brief Write a frozen value as a snapshot.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Write the given \ref vcjson_frozen instance to a sink as a snapshot.
+ *
+ * A snapshot is a versioned header followed by the tape, as it is held in
+ * memory. The header holds checksums of itself and of the tape. A snapshot can
+ * later be mapped with \ref vcjson_frozen_snapshot_map and read in place,
+ * without parsing. Snapshots are specific to the byte order of the host that
+ * wrote them.
+ *
+ * \param frozen        The frozen instance to write.
+ * \param sink          The sink that receives the snapshot.
+ * \param context       The user context for this sink.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_SNAPSHOT_SENSITIVE if the tape holds a sensitive string,
+ *        which must not be written out.
+ *      - a non-zero error code on failure, including any error returned by the
+ *        sink function.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_snapshot_write(
+    const vcjson_frozen* frozen, vcjson_emit_sink_fn sink, void* context)
+{
+    status retval;
+    vcjson_snapshot_header header;
+
+    /* sensitive strings are never persisted. */
+    if (frozen->sensitive)
+    {
+        return ERROR_VCJSON_SNAPSHOT_SENSITIVE;
+    }
+
+    /* build the header. */
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, VCJSON_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = VCJSON_SNAPSHOT_VERSION;
+    header.byte_order = VCJSON_SNAPSHOT_BYTE_ORDER;
+    header.tape_size = frozen->tape_size;
+    header.tape_checksum =
+        vcjson_snapshot_checksum(frozen->tape, frozen->tape_size);
+    header.header_checksum =
+        vcjson_snapshot_checksum(
+            &header, offsetof(vcjson_snapshot_header, header_checksum));
+
+    /* write the header. */
+    retval = sink(context, &header, sizeof(header));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* write the tape. */
+    return sink(context, frozen->tape, frozen->tape_size);
+}
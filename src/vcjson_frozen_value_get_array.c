@@ -0,0 +1,43 @@
+/**
+ * \file vcjson_frozen_value_get_array.c
+ *
+ * \brief Get the array held by a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the array value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \note On success, this function sets the array pointer to the array held by
+ * this value. This pointer is owned by the frozen instance holding this value,
+ * and shares its lifetime.
+ *
+ * \param arr           Pointer to the array pointer to hold the array on
+ *                      success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an array.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_array(
+    const vcjson_frozen_array** arr, const vcjson_frozen_value* value)
+{
+    /* verify that this is an array type. */
+    if (VCJSON_VALUE_TYPE_ARRAY != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* the array is this entry. */
+    *arr = (const vcjson_frozen_array*)value;
+
+    return STATUS_SUCCESS;
+}
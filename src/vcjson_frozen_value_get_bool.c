@@ -0,0 +1,38 @@
+/**
+ * \file vcjson_frozen_value_get_bool.c
+ *
+ * \brief Get the boolean held by a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the boolean value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \param boolean       Pointer to receive the boolean on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not a boolean.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_bool(
+    bool* boolean, const vcjson_frozen_value* value)
+{
+    /* verify that this is a boolean type. */
+    if (VCJSON_VALUE_TYPE_BOOL != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* return the boolean. */
+    *boolean = (0 != value->payload.boolean);
+
+    return STATUS_SUCCESS;
+}
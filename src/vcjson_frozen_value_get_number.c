@@ -0,0 +1,38 @@
+/**
+ * \file vcjson_frozen_value_get_number.c
+ *
+ * \brief Get the number held by a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the number value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \param number        Pointer to receive the number on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not a number.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_number(
+    double* number, const vcjson_frozen_value* value)
+{
+    /* verify that this is a number type. */
+    if (VCJSON_VALUE_TYPE_NUMBER != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* return the number. */
+    *number = value->payload.number;
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/**
+ * \file vcjson_frozen_value_get_object.c
+ *
+ * \brief Get the object held by a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the object value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \note On success, this function sets the object pointer to the object held by
+ * this value. This pointer is owned by the frozen instance holding this value,
+ * and shares its lifetime.
+ *
+ * \param obj           Pointer to the object pointer to hold the object
+ *                      on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an object.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_object(
+    const vcjson_frozen_object** obj, const vcjson_frozen_value* value)
+{
+    /* verify that this is an object type. */
+    if (VCJSON_VALUE_TYPE_OBJECT != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* the object is this entry. */
+    *obj = (const vcjson_frozen_object*)value;
+
+    return STATUS_SUCCESS;
+}
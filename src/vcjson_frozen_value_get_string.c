@@ -0,0 +1,45 @@
+/**
+ * \file vcjson_frozen_value_get_string.c
+ *
+ * \brief Get the string held by a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the string value of this \ref vcjson_frozen_value
+ * instance.
+ *
+ * \note On success, this function sets the string pointer to the ASCIIZ
+ * characters of this string. They are owned by the frozen instance holding
+ * this value, and share its lifetime.
+ *
+ * \param str           Pointer to receive the characters on success.
+ * \param length        Pointer to receive the length of the string, excluding
+ *                      its terminating NUL, on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not a string.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_value_get_string(
+    const char** str, size_t* length, const vcjson_frozen_value* value)
+{
+    /* verify that this is a string type. */
+    if (VCJSON_VALUE_TYPE_STRING != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* the characters are found relative to this entry. */
+    *str = (const char*)value + value->payload.offset;
+    *length = value->count;
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file vcjson_frozen_value_type.c
+ *
+ * \brief Get the type of a frozen value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the value type of this \ref vcjson_frozen_value instance.
+ *
+ * \param value         The value instance for this operation.
+ *
+ * \returns the value type for this instance.
+ */
+int vcjson_frozen_value_type(const vcjson_frozen_value* value)
+{
+    return (int)value->type;
+}
@@ -12,15 +12,43 @@
 #include <rcpr/resource/protected.h>
 #include <rcpr/status.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #if defined(__cplusplus)
 extern "C" {
 #endif /* defined(__cplusplus) */
 
+/**
+ * \brief The number of values sharing a container beyond the first.
+ *
+ * This is a plain integer, so that C and C++ sources see the same layout. It
+ * is only accessed through the __atomic builtins, so that values sharing a
+ * container can be copied and released on different threads.
+ */
+typedef size_t vcjson_share_count;
+
+/**
+ * \brief The number of nodes taken from a pool and not yet returned.
+ *
+ * Like \ref vcjson_share_count, this is only accessed through the __atomic
+ * builtins.
+ */
+typedef size_t vcjson_pool_count;
+
+/**
+ * \brief A list of free pool nodes that any thread may push onto.
+ *
+ * Like \ref vcjson_share_count, this is only accessed through the __atomic
+ * builtins.
+ */
+typedef void* vcjson_pool_list;
+
 struct vcjson_number
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
+    /* pool that this number was taken from, or NULL. */
+    struct vcjson_pool* pool;
     double value;
 };
 
@@ -28,8 +56,16 @@ struct vcjson_string
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
+    /* pool that this string was taken from, or NULL. */
+    struct vcjson_pool* pool;
+    /* ASCIIZ characters, allocated along with this string. */
     char* value;
     size_t length;
+    /* hash of value, computed at creation; only valid if hashed is set. */
+    uint64_t hash;
+    bool hashed;
+    /* set when value must be wiped before it is reclaimed. */
+    bool sensitive;
 };
 
 struct vcjson_null
@@ -47,15 +83,127 @@ struct vcjson_value
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
+    /* pool that this value was taken from, or NULL. */
+    struct vcjson_pool* pool;
     int type;
+    /* set when the cache of this value's container is linked to parent. */
+    bool linked;
     void* value;
+    /* emit cache of the container holding this object or array value. */
+    struct vcjson_emit_cache* parent;
+};
+
+/**
+ * \brief A number value allocated in a single block with its number.
+ */
+typedef struct vcjson_value_number_block vcjson_value_number_block;
+
+struct vcjson_value_number_block
+{
+    vcjson_value value;
+    vcjson_number number;
+};
+
+/**
+ * \brief A string value allocated in a single block with its string.
+ *
+ * The characters of the string immediately follow this block.
+ */
+typedef struct vcjson_value_string_block vcjson_value_string_block;
+
+struct vcjson_value_string_block
+{
+    vcjson_value value;
+    vcjson_string string;
+};
+
+/**
+ * \brief The root of a compact copy, which owns the block holding the copy.
+ *
+ * The rest of the copy follows this header in depth-first order.
+ */
+typedef struct vcjson_value_compact vcjson_value_compact;
+
+struct vcjson_value_compact
+{
+    vcjson_value value;
+    /* size of the block, including this header. */
+    size_t size;
+    /* set when the block holds a sensitive string. */
+    bool sensitive;
+};
+
+/**
+ * \brief Memoized emitted form of an object or array.
+ */
+typedef struct vcjson_emit_cache vcjson_emit_cache;
+
+struct vcjson_emit_cache
+{
+    RCPR_SYM(allocator)* alloc;
+    vcjson_emit_cache* parent;
+    /* share count of the container holding this cache. */
+    const vcjson_share_count* shares;
+    char* data;
+    size_t size;
+    /* set when data holds a sensitive string. */
+    bool sensitive;
+    /* set when the value linking parent was released while the container was
+     * still shared, so parent no longer belongs to the remaining value. */
+    bool unlinked;
+};
+
+/**
+ * \brief A key-value pair in a flat or hash-backed JSON object.
+ */
+typedef struct vcjson_object_entry vcjson_object_entry;
+
+struct vcjson_object_entry
+{
+    vcjson_string* key;
+    vcjson_value* value;
+    uint64_t hash;
 };
 
 struct vcjson_object
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
+    int storage;
+    /* tree storage. */
     RCPR_SYM(rbtree)* elements;
+    /* flat and hash storage; entries are kept in insertion order while the
+     * object walks in insertion order, and in no order otherwise. */
+    vcjson_object_entry* entries;
+    size_t count;
+    size_t capacity;
+    /* set when the entries were allocated along with this object. */
+    bool entries_inline;
+    /* hash storage; each index slot holds an entry offset plus one. */
+    uint32_t* index;
+    size_t index_size;
+    /* entries sorted by key, valid once order_state is sorted. */
+    vcjson_object_entry** order;
+    /* state of order, accessed only through the __atomic builtins. */
+    int order_state;
+    /* set when members are walked in insertion order instead of key order. */
+    bool insertion_order;
+    /* number of values sharing this object beyond the first. */
+    vcjson_share_count shares;
+    /* set when this object is part of a compact copy, and is read-only. */
+    bool compact;
+    vcjson_emit_cache cache;
+};
+
+/**
+ * \brief Position of a walk through the members of an object.
+ */
+typedef struct vcjson_object_cursor vcjson_object_cursor;
+
+struct vcjson_object_cursor
+{
+    RCPR_SYM(rbtree_node)* node;
+    size_t offset;
 };
 
 /**
@@ -67,6 +215,8 @@ struct vcjson_object_element
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
+    /* pool that this element was taken from, or NULL. */
+    struct vcjson_pool* pool;
     vcjson_string* key;
     vcjson_value* value;
     bool owns_key;
@@ -76,9 +226,10 @@ struct vcjson_object_iterator
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
-    RCPR_SYM(rbtree)* tree;
-    RCPR_SYM(rbtree_node)* nil;
-    RCPR_SYM(rbtree_node)* curr;
+    /* pool that this iterator was taken from, or NULL. */
+    struct vcjson_pool* pool;
+    vcjson_object* obj;
+    vcjson_object_cursor cursor;
 };
 
 struct vcjson_array
@@ -87,6 +238,173 @@ struct vcjson_array
     RCPR_SYM(allocator)* alloc;
     vcjson_value** arr;
     size_t elems;
+    size_t capacity;
+    /* packed storage; when set, the elements are these numbers, and arr holds
+     * values boxed on demand, or NULL where none has been boxed yet. */
+    double* numbers;
+    /* number of values sharing this array beyond the first. */
+    vcjson_share_count shares;
+    /* set when this array is part of a compact copy, and is read-only. */
+    bool compact;
+    vcjson_emit_cache cache;
+};
+
+struct vcjson_iovec_list
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    struct iovec* iov;
+    size_t count;
+    size_t size;
+    /* set when the vector holds a sensitive string. */
+    bool sensitive;
+};
+
+/**
+ * \brief The sorted order of a flat or hash-backed object is stale.
+ */
+#define VCJSON_OBJECT_ORDER_STALE 0
+
+/**
+ * \brief The sorted order of a flat or hash-backed object is being rebuilt.
+ */
+#define VCJSON_OBJECT_ORDER_SORTING 1
+
+/**
+ * \brief The sorted order of a flat or hash-backed object is up to date.
+ */
+#define VCJSON_OBJECT_ORDER_SORTED 2
+
+/**
+ * \brief Granularity of the node sizes served by a pool.
+ */
+#define VCJSON_POOL_CLASS_SIZE 16
+
+/**
+ * \brief Number of node size classes served by a pool.
+ *
+ * Larger nodes are allocated directly from the allocator.
+ */
+#define VCJSON_POOL_CLASSES 12
+
+struct vcjson_pool
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    /* free nodes of each size class, linked through their first word; only
+     * the thread that this pool is attached to uses these. */
+    void* free[VCJSON_POOL_CLASSES];
+    /* nodes of each size class released by other threads, which the attached
+     * thread takes over once its own free list runs out. */
+    vcjson_pool_list remote[VCJSON_POOL_CLASSES];
+    /* number of nodes taken from this pool and not yet returned. */
+    vcjson_pool_count live;
+    /* slabs allocated for this pool, linked through their first word. */
+    void* slabs;
+};
+
+/**
+ * \brief An entry in a frozen tape.
+ *
+ * Each entry refers to its characters, members, or elements by their distance
+ * from the entry itself, so that a tape can be moved or mapped as a whole.
+ */
+struct vcjson_frozen_value
+{
+    /* the value type. */
+    uint32_t type;
+    /* string length, object member count, or array element count. */
+    uint32_t count;
+    union
+    {
+        double number;
+        uint64_t boolean;
+        /* distance in bytes from this entry to what it refers to. */
+        uint64_t offset;
+    } payload;
+};
+
+/**
+ * \brief An object in a frozen tape.
+ *
+ * Its members follow as key and value entry pairs, sorted by key.
+ */
+struct vcjson_frozen_object
+{
+    vcjson_frozen_value value;
+};
+
+/**
+ * \brief An array in a frozen tape.
+ *
+ * Its elements follow as consecutive entries.
+ */
+struct vcjson_frozen_array
+{
+    vcjson_frozen_value value;
+};
+
+struct vcjson_frozen
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    /* the tape; its first entry is the root value. */
+    vcjson_frozen_value* tape;
+    size_t tape_size;
+    /* size of the block holding this instance and its tape. */
+    size_t size;
+    /* set when the tape holds a sensitive string. */
+    bool sensitive;
+    /* the snapshot mapping holding the tape, or NULL. */
+    void* mapping;
+    size_t mapping_size;
+};
+
+/**
+ * \brief Magic bytes at the start of a snapshot.
+ */
+#define VCJSON_SNAPSHOT_MAGIC "VCJSNAP"
+
+/**
+ * \brief Byte order marker, as written by the host that wrote a snapshot.
+ */
+#define VCJSON_SNAPSHOT_BYTE_ORDER 0x01020304
+
+/**
+ * \brief The header of a snapshot, which is followed by the tape.
+ */
+typedef struct vcjson_snapshot_header vcjson_snapshot_header;
+
+struct vcjson_snapshot_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t tape_size;
+    uint64_t tape_checksum;
+    uint64_t reserved;
+    /* checksum of the header fields above. */
+    uint64_t header_checksum;
+};
+
+#if !defined(__cplusplus)
+/**
+ * \brief The pool attached to the calling thread, or NULL.
+ */
+extern _Thread_local struct vcjson_pool* vcjson_pool_thread_attached;
+#endif /* !defined(__cplusplus) */
+
+/**
+ * \brief Incremental SHA-256 context.
+ */
+typedef struct vcjson_sha256_context vcjson_sha256_context;
+
+struct vcjson_sha256_context
+{
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t block[64];
+    size_t block_size;
 };
 
 /**
@@ -103,10 +421,31 @@ struct vcjson_parser_context
     size_t size;
     size_t* offset;
     size_t recursion_depth;
+    uint32_t flags;
+    const char* const* sensitive_keys;
+    size_t sensitive_key_count;
+    /* set while reading a value that is sensitive. */
+    bool sensitive;
 };
 
 typedef status (*vcjson_emit_fn)(void* context, const void* val, size_t size);
 
+/**
+ * \brief Emitter used to emit a JSON value.
+ */
+typedef struct vcjson_emitter vcjson_emitter;
+
+struct vcjson_emitter
+{
+    /* receives all transient output, such as punctuation and escapes. */
+    vcjson_emit_fn emit;
+    /* optional; receives bytes owned by the value being emitted. */
+    vcjson_emit_fn emit_reference;
+    void* context;
+    /* optional; set when a sensitive string is emitted. */
+    bool* sensitive;
+};
+
 extern vcjson_null VCJSON_NULL_IMPL;
 extern vcjson_bool VCJSON_BOOL_TRUE_IMPL;
 extern vcjson_bool VCJSON_BOOL_FALSE_IMPL;
@@ -206,6 +545,205 @@ RCPR_SYM(rcpr_comparison_result) vcjson_object_element_compare(
 const void* vcjson_object_element_key(
     void* context, const RCPR_SYM(resource)* r);
 
+/**
+ * \brief Minimum number of entries allocated for a hash-backed object.
+ */
+#define VCJSON_OBJECT_HASH_MINIMUM_CAPACITY 8
+
+/**
+ * \brief Minimum number of elements allocated when an array grows.
+ */
+#define VCJSON_ARRAY_MINIMUM_CAPACITY 8
+
+/**
+ * \brief Convert a packed number array to an array of values, so that it can
+ * be modified.
+ *
+ * \note If the array is not packed, this does nothing.
+ *
+ * \param arr           The array instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_unpack(vcjson_array* arr);
+
+/**
+ * \brief Number of entries allocated along with a flat object.
+ */
+#define VCJSON_OBJECT_FLAT_INLINE_CAPACITY 4
+
+/**
+ * \brief Compute the hash of an object key.
+ *
+ * This is SipHash-1-3, keyed with a random seed chosen once per process, so
+ * that keys colliding in an object's index cannot be crafted ahead of time.
+ * Hashes therefore differ between processes, and must not be persisted.
+ *
+ * \param key           The key bytes to hash.
+ * \param length        The length of this key, in bytes.
+ *
+ * \returns the 64-bit keyed hash of this key.
+ */
+uint64_t vcjson_object_key_hash(const char* key, size_t length);
+
+/**
+ * \brief Get the hash of a string, for use as an object key.
+ *
+ * \note Strings created from values carry a precomputed hash. Emitted strings
+ * do not, and are hashed on demand.
+ *
+ * \param str           The string to hash.
+ *
+ * \returns the hash of this string, as per \ref vcjson_object_key_hash.
+ */
+uint64_t vcjson_string_hash(const vcjson_string* str);
+
+/**
+ * \brief Ensure that a flat or hash-backed object can hold the given number of
+ * entries.
+ *
+ * \note If the entries are moved, an up to date sorted order is rebased and the
+ * index is rebuilt. A hash-backed object without an index, such as a flat
+ * object being promoted, is always given one.
+ *
+ * \param obj           The object instance for this operation.
+ * \param capacity      The number of entries required.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_hash_reserve(vcjson_object* obj, size_t capacity);
+
+/**
+ * \brief Add the entry at the given offset to the index of a hash-backed
+ * object.
+ *
+ * \param obj           The object instance for this operation.
+ * \param offset        The offset of the entry to add.
+ */
+void vcjson_object_hash_link(vcjson_object* obj, size_t offset);
+
+/**
+ * \brief Find the index slot holding the entry at the given offset in a
+ * hash-backed object.
+ *
+ * \note The entry must be linked in the index.
+ *
+ * \param obj           The object instance for this operation.
+ * \param offset        The offset of the entry to find.
+ *
+ * \returns the index slot holding this entry.
+ */
+size_t vcjson_object_hash_slot(const vcjson_object* obj, size_t offset);
+
+/**
+ * \brief Empty the given slot in the index of a hash-backed object.
+ *
+ * Later entries in the same probe run are shifted back over the gap, so that
+ * every remaining entry is still reached from its home slot without leaving
+ * tombstones behind.
+ *
+ * \param obj           The object instance for this operation.
+ * \param slot          The index slot to empty.
+ */
+void vcjson_object_hash_unlink(vcjson_object* obj, size_t slot);
+
+/**
+ * \brief Find the entry for the given key in a flat or hash-backed object.
+ *
+ * \param obj           The object instance for this operation.
+ * \param key           The key bytes to find.
+ * \param length        The length of this key, in bytes.
+ * \param hash          The hash of this key.
+ * \param slot          Optional pointer to receive, if the key is not found,
+ *                      the empty index slot where it belongs, or SIZE_MAX if
+ *                      the object has no index.
+ *
+ * \returns the entry for this key, or NULL if it is not found.
+ */
+vcjson_object_entry* vcjson_object_hash_find(
+    const vcjson_object* obj, const char* key, size_t length, uint64_t hash,
+    size_t* slot);
+
+/**
+ * \brief Sort the entries of a flat or hash-backed object by key.
+ *
+ * \note This rebuilds the sorted order from scratch, but does not mark it as up
+ * to date. Objects being read use \ref vcjson_object_hash_order instead.
+ *
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_hash_sort(vcjson_object* obj);
+
+/**
+ * \brief Bring the sorted order of a flat or hash-backed object up to date.
+ *
+ * \note Adding or removing a member only marks the sorted order as stale, so
+ * that building an object takes O(n) time, and the order is sorted once, here,
+ * when it is next needed. This does not change the members of the object, and
+ * may be called by several threads reading the object at once: one of them
+ * sorts the order while the others wait for it.
+ *
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_hash_order(const vcjson_object* obj);
+
+/**
+ * \brief Release all entries in a flat or hash-backed object.
+ *
+ * \note The entry storage itself is retained for reuse.
+ *
+ * \param obj           The object instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_hash_clear(vcjson_object* obj);
+
+/**
+ * \brief Set a cursor to the first member of an object.
+ *
+ * \note Members are visited in sorted key order regardless of storage, unless
+ * the object keeps insertion order. A stale sorted order is brought up to date
+ * with \ref vcjson_object_hash_order, and the members are not changed, so the
+ * object may be walked by several threads at once.
+ *
+ * \param cursor        The cursor to set.
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_cursor_begin(
+    vcjson_object_cursor* cursor, const vcjson_object* obj);
+
+/**
+ * \brief Get the member at the given cursor position.
+ *
+ * \param key           Pointer to receive the key at this position.
+ * \param value         Pointer to receive the value at this position.
+ * \param obj           The object instance for this operation.
+ * \param cursor        The cursor for this operation.
+ *
+ * \returns true if the cursor refers to a member, or false at the end.
+ */
+bool vcjson_object_cursor_member(
+    const vcjson_string** key, vcjson_value** value, const vcjson_object* obj,
+    const vcjson_object_cursor* cursor);
+
+/**
+ * \brief Advance a cursor to the next member of an object.
+ *
+ * \param cursor        The cursor to advance.
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_cursor_next(
+    vcjson_object_cursor* cursor, const vcjson_object* obj);
+
 /**
  * \brief Release a \ref vcjson_number resource.
  *
@@ -254,6 +792,68 @@ vcjson_value_singleton_resource_release(RCPR_SYM(resource)* r);
 status FN_DECL_MUST_CHECK
 vcjson_value_with_resource_release(RCPR_SYM(resource)* r);
 
+/**
+ * \brief Release a \ref vcjson_value allocated in a single block with its
+ * number or string.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_block_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Release the root \ref vcjson_value of a compact copy, along with the
+ * block holding the copy.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_compact_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Release a \ref vcjson_pool resource.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Allocate a node, taking it from the calling thread's pool if one is
+ * attached for the given allocator.
+ *
+ * \param pool          Pointer to receive the pool that the node was taken
+ *                      from, or NULL if it was allocated from \p alloc.
+ * \param alloc         The allocator to use for this operation.
+ * \param node          Pointer to receive the node.
+ * \param size          The size of the node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_node_allocate(
+    struct vcjson_pool** pool, RCPR_SYM(allocator)* alloc, void** node,
+    size_t size);
+
+/**
+ * \brief Reclaim a node allocated with \ref vcjson_pool_node_allocate.
+ *
+ * \param pool          The pool that the node was taken from, or NULL.
+ * \param alloc         The allocator that the node was allocated from.
+ * \param node          The node to reclaim.
+ * \param size          The size of the node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_node_reclaim(
+    struct vcjson_pool* pool, RCPR_SYM(allocator)* alloc, void* node,
+    size_t size);
+
 /**
  * \brief Release a \ref vcjson_object.
  *
@@ -286,6 +886,324 @@ vcjson_object_iterator_resource_release(RCPR_SYM(resource)* r);
 status FN_DECL_MUST_CHECK
 vcjson_array_resource_release(RCPR_SYM(resource)* r);
 
+/**
+ * \brief Release a \ref vcjson_iovec_list.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_iovec_list_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Release a \ref vcjson_frozen.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_frozen_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Compute the checksum of snapshot data.
+ *
+ * \param data          The data to checksum.
+ * \param size          The size of the data, in bytes.
+ *
+ * \returns the 64-bit checksum of this data.
+ */
+uint64_t vcjson_snapshot_checksum(const void* data, size_t size);
+
+/**
+ * \brief Release the memoized emitted form held by the given cache.
+ *
+ * \note Only this cache is reset; parent caches are not touched.
+ *
+ * \param cache         The cache to reset.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_reset(vcjson_emit_cache* cache);
+
+/**
+ * \brief Invalidate the given cache and every cache along its parent chain.
+ *
+ * This must be called before a container is modified.
+ *
+ * \param cache         The cache of the container being modified.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_invalidate(vcjson_emit_cache* cache);
+
+/**
+ * \brief Link the cache of a child container to its parent's cache.
+ *
+ * \note If the child value is not an object or array, this does nothing. A
+ * shared child keeps its existing link unless the child value holds it.
+ *
+ * \param parent        The cache of the container adopting this value.
+ * \param child         The value being added to the container.
+ */
+void vcjson_emit_cache_adopt(vcjson_emit_cache* parent, vcjson_value* child);
+
+/**
+ * \brief Link the cache of a container to the parent of the given value.
+ *
+ * The cache is linked if this value already holds its link, or if the value is
+ * the only one holding the container. A container shared with other values
+ * keeps its existing link.
+ *
+ * \param cache         The cache of the container held by \p value.
+ * \param value         The value holding the container.
+ */
+void vcjson_emit_cache_link(vcjson_emit_cache* cache, vcjson_value* value);
+
+/**
+ * \brief Drop the link from the cache of a container to the parent of the
+ * given value, before the value drops its share of the container.
+ *
+ * If this value holds the link, the cache is marked as unlinked, since any
+ * remaining value holding the container has a parent of its own. That value
+ * must relink the cache by unsharing the container before modifying it.
+ *
+ * \param cache         The cache of the container held by \p value.
+ * \param value         The value holding the container.
+ */
+void vcjson_emit_cache_unlink(vcjson_emit_cache* cache, vcjson_value* value);
+
+/**
+ * \brief Check that the container holding the given cache, and every
+ * container along its parent chain, may be modified.
+ *
+ * A container nested under a shared container is reachable from every value
+ * sharing it, so it is treated as shared as well. An unlinked container is
+ * refused too, since its ancestors are unknown until its value unshares it.
+ *
+ * \param cache         The cache of the container to check, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if no container along the chain is shared.
+ *      - ERROR_VCJSON_VALUE_SHARED if any container along the chain is
+ *        shared with a copy of its value, or is unlinked.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_cache_check_exclusive(const vcjson_emit_cache* cache);
+
+/**
+ * \brief Give the given value its own copy of a shared object or array.
+ *
+ * If the container held by this value is shared with other values, it is
+ * replaced with a copy whose members are in turn shared, so that it can be
+ * modified. If this value then holds the container alone, it is linked to the
+ * cache of the container holding this value.
+ *
+ * \param value         The value to unshare.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if a container holding this value is itself
+ *        shared, so that this value cannot be changed without changing every
+ *        copy.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_unshare(vcjson_value* value);
+
+/**
+ * \brief A function that copies a member value of an object or array.
+ */
+typedef status (*vcjson_value_copy_fn)(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, const vcjson_value* orig);
+
+/**
+ * \brief Create a deep copy of the given \ref vcjson_value instance.
+ *
+ * Unlike \ref vcjson_value_copy, objects and arrays are copied in full instead
+ * of shared.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. This
+ * value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param orig          The original value to copy.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_copy_deep(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, const vcjson_value* orig);
+
+/**
+ * \brief Make a copy of the given object, copying each member value with the
+ * given function.
+ *
+ * Keys are always duplicated. Whether member objects and arrays are copied or
+ * shared depends on \p copy.
+ *
+ * \note On success, this function creates a  \ref vcjson_object instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. The copy uses the same storage as the original.
+ *
+ * \param obj           Pointer to the object pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param orig          The original object to copy.
+ * \param copy          The function used to copy each member value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_copy_with(
+    vcjson_object** obj, RCPR_SYM(allocator)* alloc, const vcjson_object* orig,
+    vcjson_value_copy_fn copy);
+
+/**
+ * \brief Make a copy of the given \ref vcjson_array, copying each element with
+ * the given function.
+ *
+ * Packed numbers are always copied. Whether member objects and arrays are
+ * copied or shared depends on \p copy.
+ *
+ * \note On success, this function creates a  \ref vcjson_array instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle.
+ *
+ * \param arr           Pointer to the array pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param orig          The original array to copy.
+ * \param copy          The function used to copy each element.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_array_copy_with(
+    vcjson_array** arr, RCPR_SYM(allocator)* alloc, const vcjson_array* orig,
+    vcjson_value_copy_fn copy);
+
+/**
+ * \brief Emit a JSON value using the given emitter.
+ *
+ * \note This function does not allocate memory. All output is passed to the
+ * emitter function, which is responsible for any buffering. Bytes passed to
+ * the emitter's reference function remain valid until \p value is modified or
+ * released.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param value         The JSON value to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_value(const vcjson_emitter* emitter, vcjson_value* value);
+
+/**
+ * \brief Emit a JSON number from its double value using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param number        The number to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_number(const vcjson_emitter* emitter, double number);
+
+/**
+ * \brief Emit a decoded JSON string using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param stringval     The JSON string to emit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_decoded_string(
+    const vcjson_emitter* emitter, const vcjson_string* stringval);
+
+/**
+ * \brief Emit a run of JSON object members using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param obj           The object holding these members.
+ * \param start         The cursor of the first member to emit.
+ * \param count         The maximum number of members to emit.
+ * \param leading_comma Set to true if a comma precedes the first member.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_object_members(
+    const vcjson_emitter* emitter, vcjson_object* obj,
+    const vcjson_object_cursor* start, size_t count, bool leading_comma);
+
+/**
+ * \brief Emit a run of JSON array elements using the given emitter.
+ *
+ * \param emitter       The emitter to use to emit data.
+ * \param arr           The array holding these elements.
+ * \param begin         The offset of the first element to emit.
+ * \param end           The offset one past the last element to emit.
+ * \param leading_comma Set to true if a comma precedes the first element.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_emit_array_elements(
+    const vcjson_emitter* emitter, vcjson_array* arr, size_t begin,
+    size_t end, bool leading_comma);
+
+/**
+ * \brief Initialize a SHA-256 context.
+ *
+ * \param ctx           The context to initialize.
+ */
+void vcjson_sha256_init(vcjson_sha256_context* ctx);
+
+/**
+ * \brief Add data to a SHA-256 digest.
+ *
+ * \param ctx           The context for this digest.
+ * \param data          The data to add.
+ * \param size          The size of this data.
+ */
+void vcjson_sha256_update(
+    vcjson_sha256_context* ctx, const void* data, size_t size);
+
+/**
+ * \brief Finish a SHA-256 digest.
+ *
+ * \note The context is cleared by this operation.
+ *
+ * \param ctx           The context for this digest.
+ * \param digest        Buffer to receive the \ref VCJSON_SHA256_DIGEST_SIZE
+ *                      byte digest.
+ */
+void vcjson_sha256_final(vcjson_sha256_context* ctx, uint8_t* digest);
+
 /**
  * \brief Attempt to scan a buffer for the next primitive symbol.
  *
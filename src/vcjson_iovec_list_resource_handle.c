@@ -0,0 +1,25 @@
+/**
+ * \file vcjson_iovec_list_resource_handle.c
+ *
+ * \brief Get the resource handle of an iovec list.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the resource handle for the given \ref vcjson_iovec_list
+ * instance.
+ *
+ * \param list          The instance for this accessor.
+ *
+ * \returns the resource handle for this instance.
+ */
+RCPR_SYM(resource)* vcjson_iovec_list_resource_handle(vcjson_iovec_list* list)
+{
+    return &list->hdr;
+}
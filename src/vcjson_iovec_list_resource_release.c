@@ -0,0 +1,43 @@
+/**
+ * \file vcjson_iovec_list_resource_release.c
+ *
+ * \brief Release an iovec list resource.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Release a \ref vcjson_iovec_list.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_iovec_list_resource_release(RCPR_SYM(resource)* r)
+{
+    vcjson_iovec_list* list = (vcjson_iovec_list*)r;
+
+    /* cache allocator. */
+    allocator* alloc = list->alloc;
+
+    /* clear the vector and scratch area if they hold sensitive strings. */
+    if (list->sensitive)
+    {
+        memset(list, 0, list->size);
+    }
+    /* otherwise, only clear the list header. */
+    else
+    {
+        memset(list, 0, sizeof(*list));
+    }
+
+    /* reclaim memory. */
+    return
+        allocator_reclaim(alloc, list);
+}
@@ -0,0 +1,32 @@
+/**
+ * \file vcjson_iovec_list_vector.c
+ *
+ * \brief Get the iovec vector of an iovec list.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <sys/uio.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the iovec vector for the given \ref vcjson_iovec_list instance.
+ *
+ * \note The number of entries may exceed IOV_MAX for large documents, in which
+ * case the caller must write the vector in batches.
+ *
+ * \param list          The instance for this accessor.
+ * \param count         Pointer to receive the number of iovec entries.
+ *
+ * \returns the iovec vector for this instance.
+ */
+const struct iovec* vcjson_iovec_list_vector(
+    const vcjson_iovec_list* list, size_t* count)
+{
+    *count = list->count;
+
+    return list->iov;
+}
@@ -37,9 +37,11 @@ vcjson_number_create(
 {
     status retval;
     vcjson_number* tmp;
+    vcjson_pool* pool;
 
     /* allocate memory for this number instance. */
-    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    retval =
+        vcjson_pool_node_allocate(&pool, alloc, (void**)&tmp, sizeof(*tmp));
     if (STATUS_SUCCESS != retval)
     {
         goto done;
@@ -47,6 +49,7 @@ vcjson_number_create(
 
     /* clear out this structure. */
     memset(tmp, 0, sizeof(*tmp));
+    tmp->pool = pool;
 
     /* initialize resource. */
     resource_init(&tmp->hdr, &vcjson_number_resource_release);
@@ -23,13 +23,14 @@ vcjson_number_resource_release(RCPR_SYM(resource)* r)
 {
     vcjson_number* number = (vcjson_number*)r;
 
-    /* cache allocator. */
+    /* cache allocator and pool. */
     allocator* alloc = number->alloc;
+    vcjson_pool* pool = number->pool;
 
     /* clear structure. */
     memset(number, 0, sizeof(*number));
 
     /* reclaim memory. */
     return
-        allocator_reclaim(alloc, number);
+        vcjson_pool_node_reclaim(pool, alloc, number, sizeof(*number));
 }
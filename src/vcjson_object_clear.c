@@ -24,11 +24,35 @@ RCPR_IMPORT_rbtree;
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
 vcjson_object_clear(vcjson_object* obj)
 {
+    status retval;
+
+    /* a shared object, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the emitted form of this object and its parents is now stale. */
+    retval = vcjson_emit_cache_invalidate(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        return vcjson_object_hash_clear(obj);
+    }
+
     return
         rbtree_clear(obj->elements);
 }
@@ -0,0 +1,191 @@
+/**
+ * \file vcjson_object_copy_with.c
+ *
+ * \brief Copy an object instance with the given member copy function.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/* forward decls. */
+static status vcjson_object_copy_member(
+    vcjson_object* obj, RCPR_SYM(allocator)* alloc, const vcjson_string* key,
+    const vcjson_value* value, vcjson_value_copy_fn copy);
+
+/**
+ * \brief Make a copy of the given object, copying each member value with the
+ * given function.
+ *
+ * Keys are always duplicated. Whether member objects and arrays are copied or
+ * shared depends on \p copy.
+ *
+ * \note On success, this function creates a  \ref vcjson_object instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. The copy uses the same storage as the original.
+ *
+ * \param obj           Pointer to the object pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param orig          The original object to copy.
+ * \param copy          The function used to copy each member value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_copy_with(
+    vcjson_object** obj, RCPR_SYM(allocator)* alloc, const vcjson_object* orig,
+    vcjson_value_copy_fn copy)
+{
+    status retval, release_retval;
+    rbtree_node* nil;
+    rbtree_node* iter;
+    const vcjson_object_element* elem;
+    vcjson_object* tmp;
+
+    /* create an empty object instance to hold this copy. */
+    retval = vcjson_object_create_with_storage(&tmp, alloc, orig->storage);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the copy walks its members in the same order. */
+    tmp->insertion_order = orig->insertion_order;
+
+    if (VCJSON_OBJECT_STORAGE_TREE != orig->storage)
+    {
+        /* size the copy up front. */
+        retval = vcjson_object_hash_reserve(tmp, orig->count);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_tmp;
+        }
+
+        /* copy entries in insertion order. */
+        for (size_t i = 0; i < orig->count; ++i)
+        {
+            retval =
+                vcjson_object_copy_member(
+                    tmp, alloc, orig->entries[i].key, orig->entries[i].value,
+                    copy);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_tmp;
+            }
+        }
+    }
+    else
+    {
+        /* iterate through the original object tree. */
+        nil = rbtree_nil_node(orig->elements);
+        iter =
+            rbtree_minimum_node(
+                orig->elements, rbtree_root_node(orig->elements));
+        while (nil != iter)
+        {
+            /* get the element for this node. */
+            elem =
+                (const vcjson_object_element*)
+                    rbtree_node_value(orig->elements, iter);
+
+            retval =
+                vcjson_object_copy_member(
+                    tmp, alloc, elem->key, elem->value, copy);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_tmp;
+            }
+
+            /* get the next element in this object tree. */
+            iter = rbtree_successor_node(orig->elements, iter);
+        }
+    }
+
+    /* Success. Copy complete. */
+    *obj = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_tmp:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Copy a key-value pair into the given object.
+ *
+ * \param obj           The object receiving this copy.
+ * \param alloc         The allocator to use for this operation.
+ * \param key           The key to copy.
+ * \param value         The value to copy.
+ * \param copy          The function used to copy this value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_object_copy_member(
+    vcjson_object* obj, RCPR_SYM(allocator)* alloc, const vcjson_string* key,
+    const vcjson_value* value, vcjson_value_copy_fn copy)
+{
+    status retval, release_retval;
+    vcjson_string* keycopy;
+    vcjson_value* valuecopy;
+
+    /* duplicate the key, so that each object owns its own keys. */
+    retval = vcjson_string_copy(&keycopy, alloc, key);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* duplicate the value. */
+    retval = copy(&valuecopy, alloc, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_keycopy;
+    }
+
+    /* put this copy into the cloned object. */
+    retval = vcjson_object_put(obj, keycopy, valuecopy);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_valuecopy;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_valuecopy:
+    release_retval = resource_release(&valuecopy->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_keycopy:
+    release_retval = resource_release(&keycopy->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
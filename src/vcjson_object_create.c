@@ -6,15 +6,10 @@
  * \copyright 2022 Velo Payments, Inc.  All rights reserved.
  */
 
-#include <string.h>
 #include <vcjson/vcjson.h>
 
 #include "vcjson_internal.h"
 
-RCPR_IMPORT_allocator;
-RCPR_IMPORT_rbtree;
-RCPR_IMPORT_resource;
-
 /**
  * \brief Create an empty \ref vcjson_object using the given allocator.
  *
@@ -33,47 +28,7 @@ RCPR_IMPORT_resource;
 status FN_DECL_MUST_CHECK
 vcjson_object_create(vcjson_object** obj, RCPR_SYM(allocator)* alloc)
 {
-    status retval, release_retval;
-    vcjson_object* tmp;
-
-    /* allocate memory for the object instance. */
-    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-    /* clear instance. */
-    memset(tmp, 0, sizeof(*tmp));
-
-    /* initialize resource. */
-    resource_init(&tmp->hdr, &vcjson_object_resource_release);
-
-    /* set initial values. */
-    tmp->alloc = alloc;
-
-    /* create rbtree instance for this object. */
-    retval =
-        rbtree_create(
-            &tmp->elements, alloc, &vcjson_object_element_compare,
-            &vcjson_object_element_key, NULL);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_tmp;
-    }
-
-    /* success. */
-    *obj = tmp;
-    retval = STATUS_SUCCESS;
-    goto done;
-
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
+    return
+        vcjson_object_create_with_storage(
+            obj, alloc, VCJSON_OBJECT_STORAGE_TREE);
 }
@@ -0,0 +1,144 @@
+/**
+ * \file vcjson_object_create_from_members.c
+ *
+ * \brief Create an object instance from a set of members.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcjson_object holding the given members.
+ *
+ * This builds the object in a single pass instead of one
+ * \ref vcjson_object_put per member. Members whose keys are already in
+ * ascending order need no sorting; otherwise they are sorted once. Objects
+ * with at most \ref VCJSON_OBJECT_FLAT_MAXIMUM_SIZE members use
+ * \ref VCJSON_OBJECT_STORAGE_FLAT, and larger objects use
+ * \ref VCJSON_OBJECT_STORAGE_HASH.
+ *
+ * \note On success, this function creates a  \ref vcjson_object instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. On success, the object takes ownership of the given keys and
+ * values. On failure, they remain owned by the caller.
+ *
+ * \param obj           Pointer to the object pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param keys          The keys of the members.
+ * \param values        The values of the members, matching \p keys.
+ * \param count         The number of members.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_OBJECT_DUPLICATE_KEY if a key appears more than once.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_create_from_members(
+    vcjson_object** obj, RCPR_SYM(allocator)* alloc, vcjson_string** keys,
+    vcjson_value** values, size_t count)
+{
+    status retval, release_retval;
+    vcjson_object* tmp;
+    vcjson_object_entry* entry;
+    bool sorted = true;
+
+    /* small objects are flat, and larger objects are hashed. */
+    retval =
+        vcjson_object_create_with_storage(
+            &tmp, alloc,
+            count > VCJSON_OBJECT_FLAT_MAXIMUM_SIZE
+                ? VCJSON_OBJECT_STORAGE_HASH
+                : VCJSON_OBJECT_STORAGE_FLAT);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* allocate all of the entries at once. */
+    retval = vcjson_object_hash_reserve(tmp, count);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* fill the entries, noting whether the keys arrived in order. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        entry = &tmp->entries[i];
+        entry->key = keys[i];
+        entry->value = values[i];
+        entry->hash = vcjson_string_hash(keys[i]);
+        tmp->order[i] = entry;
+
+        if (sorted && i > 0
+         && RCPR_COMPARE_GT
+                != vcjson_object_element_compare(NULL, keys[i], keys[i - 1]))
+        {
+            sorted = false;
+        }
+    }
+
+    tmp->count = count;
+
+    /* unordered keys are sorted once, and may hold duplicates. */
+    if (!sorted)
+    {
+        vcjson_object_hash_sort(tmp);
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            if (RCPR_COMPARE_EQ
+                    == vcjson_object_element_compare(
+                            NULL, tmp->order[i - 1]->key, tmp->order[i]->key))
+            {
+                retval = ERROR_VCJSON_OBJECT_DUPLICATE_KEY;
+                goto cleanup_entries;
+            }
+        }
+    }
+
+    /* the order now holds every entry, sorted by key. */
+    __atomic_store_n(
+        &tmp->order_state, VCJSON_OBJECT_ORDER_SORTED, __ATOMIC_RELAXED);
+
+    /* index the entries of a hash-backed object. */
+    if (tmp->index_size > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            vcjson_object_hash_link(tmp, i);
+        }
+    }
+
+    /* link each value's emit cache to this object. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        vcjson_emit_cache_adopt(&tmp->cache, values[i]);
+    }
+
+    /* success. */
+    *obj = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_entries:
+    /* the caller still owns the keys and values. */
+    tmp->count = 0;
+
+cleanup_tmp:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,130 @@
+/**
+ * \file vcjson_object_create_with_storage.c
+ *
+ * \brief Create an object instance with the given storage.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create an empty \ref vcjson_object using the given storage.
+ *
+ * \ref VCJSON_OBJECT_STORAGE_TREE is what \ref vcjson_object_create uses.
+ * \ref VCJSON_OBJECT_STORAGE_HASH keeps members in an open-addressing hash
+ * table, giving constant time lookups on wide objects.
+ * \ref VCJSON_OBJECT_STORAGE_FLAT keeps a few members in a small array
+ * allocated along with the object, and becomes a hash-backed object once it
+ * holds more than \ref VCJSON_OBJECT_FLAT_MAXIMUM_SIZE members. All storage
+ * kinds iterate and emit members in the same sorted key order.
+ *
+ * \note On success, this function creates a  \ref vcjson_object instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle.
+ *
+ * \param obj           Pointer to the object pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param storage       The \ref vcjson_object_storage for this object.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_OBJECT_BAD_STORAGE if \p storage is unknown.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_create_with_storage(
+    vcjson_object** obj, RCPR_SYM(allocator)* alloc, int storage)
+{
+    status retval, release_retval;
+    vcjson_object* tmp;
+    size_t inline_capacity = 0;
+
+    /* verify the storage kind. */
+    switch (storage)
+    {
+        case VCJSON_OBJECT_STORAGE_TREE:
+        case VCJSON_OBJECT_STORAGE_HASH:
+            break;
+
+        /* flat objects carry their first few entries with them. */
+        case VCJSON_OBJECT_STORAGE_FLAT:
+            inline_capacity = VCJSON_OBJECT_FLAT_INLINE_CAPACITY;
+            break;
+
+        default:
+            retval = ERROR_VCJSON_OBJECT_BAD_STORAGE;
+            goto done;
+    }
+
+    /* allocate memory for the object instance and any inline entries. */
+    retval =
+        allocator_allocate(
+            alloc, (void**)&tmp,
+            sizeof(*tmp)
+                + inline_capacity
+                    * (sizeof(*tmp->entries) + sizeof(*tmp->order)));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear instance. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* inline entries follow the object, and their order follows them. */
+    if (inline_capacity > 0)
+    {
+        tmp->entries = (vcjson_object_entry*)(tmp + 1);
+        tmp->order = (vcjson_object_entry**)(tmp->entries + inline_capacity);
+        tmp->capacity = inline_capacity;
+        tmp->entries_inline = true;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcjson_object_resource_release);
+
+    /* set initial values. */
+    tmp->alloc = alloc;
+    tmp->cache.alloc = alloc;
+    tmp->cache.shares = &tmp->shares;
+    tmp->storage = storage;
+
+    /* hash storage is allocated on first insert. */
+
+    /* create rbtree instance for a tree-backed object. */
+    if (VCJSON_OBJECT_STORAGE_TREE == storage)
+    {
+        retval =
+            rbtree_create(
+                &tmp->elements, alloc, &vcjson_object_element_compare,
+                &vcjson_object_element_key, NULL);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_tmp;
+        }
+    }
+
+    /* success. */
+    *obj = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_tmp:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,42 @@
+/**
+ * \file vcjson_object_cursor_begin.c
+ *
+ * \brief Set a cursor to the first member of an object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_rbtree;
+
+/**
+ * \brief Set a cursor to the first member of an object.
+ *
+ * \note Members are visited in sorted key order regardless of storage, unless
+ * the object keeps insertion order. A stale sorted order is brought up to date
+ * with \ref vcjson_object_hash_order, and the members are not changed, so the
+ * object may be walked by several threads at once.
+ *
+ * \param cursor        The cursor to set.
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_cursor_begin(
+    vcjson_object_cursor* cursor, const vcjson_object* obj)
+{
+    cursor->node = NULL;
+    cursor->offset = 0;
+
+    /* flat and hash entries start at offset zero; trees at their minimum. */
+    if (VCJSON_OBJECT_STORAGE_TREE == obj->storage)
+    {
+        cursor->node =
+            rbtree_minimum_node(obj->elements, rbtree_root_node(obj->elements));
+    }
+    else if (!obj->insertion_order)
+    {
+        vcjson_object_hash_order(obj);
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * \file vcjson_object_cursor_member.c
+ *
+ * \brief Get the member at a cursor position.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_rbtree;
+
+/**
+ * \brief Get the member at the given cursor position.
+ *
+ * \param key           Pointer to receive the key at this position.
+ * \param value         Pointer to receive the value at this position.
+ * \param obj           The object instance for this operation.
+ * \param cursor        The cursor for this operation.
+ *
+ * \returns true if the cursor refers to a member, or false at the end.
+ */
+bool vcjson_object_cursor_member(
+    const vcjson_string** key, vcjson_value** value, const vcjson_object* obj,
+    const vcjson_object_cursor* cursor)
+{
+    const vcjson_object_entry* entry;
+    const vcjson_object_element* elem;
+
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        if (cursor->offset >= obj->count)
+        {
+            return false;
+        }
+
+        entry =
+            obj->insertion_order
+                ? &obj->entries[cursor->offset]
+                : obj->order[cursor->offset];
+        *key = entry->key;
+        *value = entry->value;
+    }
+    else
+    {
+        if (rbtree_nil_node(obj->elements) == cursor->node)
+        {
+            return false;
+        }
+
+        elem =
+            (const vcjson_object_element*)
+                rbtree_node_value(obj->elements, cursor->node);
+        *key = elem->key;
+        *value = elem->value;
+    }
+
+    return true;
+}
@@ -0,0 +1,32 @@
+/**
+ * \file vcjson_object_cursor_next.c
+ *
+ * \brief Advance a cursor to the next member of an object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_rbtree;
+
+/**
+ * \brief Advance a cursor to the next member of an object.
+ *
+ * \param cursor        The cursor to advance.
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_cursor_next(
+    vcjson_object_cursor* cursor, const vcjson_object* obj)
+{
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        ++cursor->offset;
+    }
+    else
+    {
+        cursor->node = rbtree_successor_node(obj->elements, cursor->node);
+    }
+}
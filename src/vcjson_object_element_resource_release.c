@@ -28,8 +28,9 @@ vcjson_object_element_resource_release(RCPR_SYM(resource)* r)
     status reclaim_retval = STATUS_SUCCESS;
     vcjson_object_element* elem = (vcjson_object_element*)r;
 
-    /* cache allocator. */
+    /* cache allocator and pool. */
     allocator* alloc = elem->alloc;
+    vcjson_pool* pool = elem->pool;
 
     /* if the key is set, reclaim it. */
     if (NULL != elem->key && elem->owns_key)
@@ -47,7 +48,7 @@ vcjson_object_element_resource_release(RCPR_SYM(resource)* r)
     memset(elem, 0, sizeof(*elem));
 
     /* reclaim elem. */
-    reclaim_retval = allocator_reclaim(alloc, elem);
+    reclaim_retval = vcjson_pool_node_reclaim(pool, alloc, elem, sizeof(*elem));
 
     /* decode return value. */
     if (STATUS_SUCCESS != key_release_retval)
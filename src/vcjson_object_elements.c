@@ -22,5 +22,10 @@ RCPR_IMPORT_rbtree;
  */
 size_t vcjson_object_elements(const vcjson_object* obj)
 {
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        return obj->count;
+    }
+
     return rbtree_count(obj->elements);
 }
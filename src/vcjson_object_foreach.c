@@ -0,0 +1,51 @@
+/**
+ * \file vcjson_object_foreach.c
+ *
+ * \brief Call a function for each member of an object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Call the given function for each member of an object.
+ *
+ * Members are visited in the same order as \ref vcjson_object_iterator_create
+ * would visit them. Unlike an iterator, this walk does not allocate.
+ *
+ * \note The callback must not add or remove members of this object.
+ *
+ * \param obj           The object instance for this operation.
+ * \param fn            The function to call for each member.
+ * \param context       The user context to pass to this function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code returned by \p fn, which stops the walk.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_foreach(
+    vcjson_object* obj, vcjson_object_foreach_fn fn, void* context)
+{
+    status retval;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* value;
+
+    /* walk the members with a cursor on the stack. */
+    for (vcjson_object_cursor_begin(&iter, obj);
+         vcjson_object_cursor_member(&key, &value, obj, &iter);
+         vcjson_object_cursor_next(&iter, obj))
+    {
+        retval = fn(context, key, value);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -11,9 +11,6 @@
 
 #include "vcjson_internal.h"
 
-RCPR_IMPORT_rbtree;
-RCPR_IMPORT_resource;
-
 /**
  * \brief Get a value from the object using the given key.
  *
@@ -35,21 +32,23 @@ status FN_DECL_MUST_CHECK
 vcjson_object_get(
     vcjson_value** value, vcjson_object* obj, const vcjson_string* key)
 {
-    status retval;
-    vcjson_object_element* elem;
+    const vcjson_object_entry* entry;
 
-    /* attempt to find a value by key in the object's rbtree. */
-    retval = rbtree_find((resource**)&elem, obj->elements, key);
-    if (ERROR_RBTREE_NOT_FOUND == retval)
-    {
-        return ERROR_VCJSON_KEY_NOT_FOUND;
-    }
-    else if (STATUS_SUCCESS != retval)
+    /* flat and hash storage reuse the key's precomputed hash. */
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
     {
-        return retval;
+        entry =
+            vcjson_object_hash_find(
+                obj, key->value, key->length, vcjson_string_hash(key), NULL);
+        if (NULL == entry)
+        {
+            return ERROR_VCJSON_KEY_NOT_FOUND;
+        }
+
+        *value = entry->value;
+        return STATUS_SUCCESS;
     }
 
-    /* set the value. */
-    *value = elem->value;
-    return STATUS_SUCCESS;
+    return
+        vcjson_object_get_raw(value, obj, key->value, key->length);
 }
@@ -0,0 +1,38 @@
+/**
+ * \file vcjson_object_get_cstr.c
+ *
+ * \brief Get a value from an object by C string key.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get a value from the object using the given C string key.
+ *
+ * On success, the value pointer is updated with the \ref vcjson_value instance
+ * associated with the given key in this object. The key is compared directly
+ * against the stored keys, so no \ref vcjson_string is created.
+ *
+ * \note Ownership of the returned value remains with the object.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The NUL-terminated key for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_get_cstr(
+    vcjson_value** value, vcjson_object* obj, const char* key)
+{
+    return
+        vcjson_object_get_raw(value, obj, key, strlen(key));
+}
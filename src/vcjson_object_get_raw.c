@@ -0,0 +1,79 @@
+/**
+ * \file vcjson_object_get_raw.c
+ *
+ * \brief Get a value from an object by raw key bytes.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Get a value from the object using the given key bytes.
+ *
+ * On success, the value pointer is updated with the \ref vcjson_value instance
+ * associated with the given key in this object. The key is compared directly
+ * against the stored keys, so no \ref vcjson_string is created.
+ *
+ * \note Ownership of the returned value remains with the object.
+ *
+ * \param value         Pointer to the value pointer to be updated on success.
+ * \param obj           The object instance for this operation.
+ * \param key           The key bytes for this operation.
+ * \param length        The length of this key, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_KEY_NOT_FOUND if the key is not associated with a value.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_get_raw(
+    vcjson_value** value, vcjson_object* obj, const char* key, size_t length)
+{
+    status retval;
+    vcjson_object_element* elem;
+    const vcjson_object_entry* entry;
+    vcjson_string tmp;
+
+    /* flat and hash storage search their entries directly. */
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        entry =
+            vcjson_object_hash_find(
+                obj, key, length, vcjson_object_key_hash(key, length), NULL);
+        if (NULL == entry)
+        {
+            return ERROR_VCJSON_KEY_NOT_FOUND;
+        }
+
+        *value = entry->value;
+        return STATUS_SUCCESS;
+    }
+
+    /* the tree only compares key bytes, so a stack key is sufficient. */
+    memset(&tmp, 0, sizeof(tmp));
+    tmp.value = (char*)key;
+    tmp.length = length;
+
+    /* attempt to find a value by key in the object's rbtree. */
+    retval = rbtree_find((resource**)&elem, obj->elements, &tmp);
+    if (ERROR_RBTREE_NOT_FOUND == retval)
+    {
+        return ERROR_VCJSON_KEY_NOT_FOUND;
+    }
+    else if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* set the value. */
+    *value = elem->value;
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,57 @@
+/**
+ * \file vcjson_object_hash_clear.c
+ *
+ * \brief Release all entries in a flat or hash-backed object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release all entries in a flat or hash-backed object.
+ *
+ * \note The entry storage itself is retained for reuse.
+ *
+ * \param obj           The object instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_hash_clear(vcjson_object* obj)
+{
+    status retval = STATUS_SUCCESS;
+    status release_retval;
+
+    /* release every key and value, keeping the first error. */
+    for (size_t i = 0; i < obj->count; ++i)
+    {
+        release_retval = resource_release(&obj->entries[i].key->hdr);
+        if (STATUS_SUCCESS == retval)
+        {
+            retval = release_retval;
+        }
+
+        release_retval = resource_release(&obj->entries[i].value->hdr);
+        if (STATUS_SUCCESS == retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    /* reset the entries and index. */
+    obj->count = 0;
+    if (NULL != obj->index)
+    {
+        memset(obj->index, 0, obj->index_size * sizeof(*obj->index));
+    }
+
+    return retval;
+}
@@ -0,0 +1,80 @@
+/**
+ * \file vcjson_object_hash_find.c
+ *
+ * \brief Find an entry in a flat or hash-backed object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Find the entry for the given key in a flat or hash-backed object.
+ *
+ * \param obj           The object instance for this operation.
+ * \param key           The key bytes to find.
+ * \param length        The length of this key, in bytes.
+ * \param hash          The hash of this key.
+ * \param slot          Optional pointer to receive, if the key is not found,
+ *                      the empty index slot where it belongs, or SIZE_MAX if
+ *                      the object has no index.
+ *
+ * \returns the entry for this key, or NULL if it is not found.
+ */
+vcjson_object_entry* vcjson_object_hash_find(
+    const vcjson_object* obj, const char* key, size_t length, uint64_t hash,
+    size_t* slot)
+{
+    size_t mask, probe;
+    vcjson_object_entry* entry;
+
+    /* flat objects are small enough to scan, comparing cached hashes. */
+    if (0 == obj->index_size)
+    {
+        if (NULL != slot)
+        {
+            *slot = SIZE_MAX;
+        }
+
+        for (size_t i = 0; i < obj->count; ++i)
+        {
+            entry = &obj->entries[i];
+            if (entry->hash == hash && entry->key->length == length
+             && 0 == memcmp(entry->key->value, key, length))
+            {
+                return entry;
+            }
+        }
+
+        return NULL;
+    }
+
+    mask = obj->index_size - 1;
+    probe = (size_t)hash & mask;
+
+    /* probe until we find this key or an empty slot. */
+    while (0 != obj->index[probe])
+    {
+        entry = &obj->entries[obj->index[probe] - 1];
+
+        /* the cached hash rejects nearly all mismatches without a compare. */
+        if (entry->hash == hash && entry->key->length == length
+         && 0 == memcmp(entry->key->value, key, length))
+        {
+            return entry;
+        }
+
+        probe = (probe + 1) & mask;
+    }
+
+    /* this is where the key belongs, so an insert needs no second probe. */
+    if (NULL != slot)
+    {
+        *slot = probe;
+    }
+
+    return NULL;
+}
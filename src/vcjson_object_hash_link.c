@@ -0,0 +1,32 @@
+/**
+ * \file vcjson_object_hash_link.c
+ *
+ * \brief Add an entry to the index of a hash-backed object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Add the entry at the given offset to the index of a hash-backed
+ * object.
+ *
+ * \param obj           The object instance for this operation.
+ * \param offset        The offset of the entry to add.
+ */
+void vcjson_object_hash_link(vcjson_object* obj, size_t offset)
+{
+    size_t mask = obj->index_size - 1;
+    size_t slot = (size_t)obj->entries[offset].hash & mask;
+
+    /* the index is at most half full, so linear probing always terminates. */
+    while (0 != obj->index[slot])
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    obj->index[slot] = (uint32_t)(offset + 1);
+}
@@ -0,0 +1,55 @@
+/**
+ * \file vcjson_object_hash_order.c
+ *
+ * \brief Bring the sorted order of a flat or hash-backed object up to date.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <sched.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Bring the sorted order of a flat or hash-backed object up to date.
+ *
+ * \note Adding or removing a member only marks the sorted order as stale, so
+ * that building an object takes O(n) time, and the order is sorted once, here,
+ * when it is next needed. This does not change the members of the object, and
+ * may be called by several threads reading the object at once: one of them
+ * sorts the order while the others wait for it.
+ *
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_hash_order(const vcjson_object* obj)
+{
+    /* only the order is rebuilt, so the members remain unchanged. */
+    vcjson_object* tmp = (vcjson_object*)obj;
+    int state;
+
+    for (;;)
+    {
+        state = __atomic_load_n(&tmp->order_state, __ATOMIC_ACQUIRE);
+        if (VCJSON_OBJECT_ORDER_SORTED == state)
+        {
+            return;
+        }
+
+        /* the first reader to claim a stale order sorts it. */
+        if (VCJSON_OBJECT_ORDER_STALE == state
+         && __atomic_compare_exchange_n(
+                &tmp->order_state, &state, VCJSON_OBJECT_ORDER_SORTING, false,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            vcjson_object_hash_sort(tmp);
+            __atomic_store_n(
+                &tmp->order_state, VCJSON_OBJECT_ORDER_SORTED,
+                __ATOMIC_RELEASE);
+            return;
+        }
+
+        /* another reader is sorting it. */
+        sched_yield();
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * \file vcjson_object_hash_reserve.c
+ *
+ * \brief Grow the entry storage of a flat or hash-backed object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Ensure that a flat or hash-backed object can hold the given number of
+ * entries.
+ *
+ * \note If the entries are moved, the sorted order is rebased and the index is
+ * rebuilt. A hash-backed object without an index, such as a flat object being
+ * promoted, is always given one.
+ *
+ * \param obj           The object instance for this operation.
+ * \param capacity      The number of entries required.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_hash_reserve(vcjson_object* obj, size_t capacity)
+{
+    status retval;
+    size_t new_capacity, index_size, entries_size, order_size, index_bytes;
+    vcjson_object_entry* entries;
+    vcjson_object_entry** order;
+    uint32_t* index;
+
+    bool indexed = (VCJSON_OBJECT_STORAGE_HASH == obj->storage);
+
+    /* if there is already enough room, there is nothing to do. */
+    if (capacity <= obj->capacity && (!indexed || obj->index_size > 0))
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* grow geometrically, so appending stays amortized constant time. */
+    new_capacity =
+        obj->capacity > 0 ? obj->capacity : VCJSON_OBJECT_HASH_MINIMUM_CAPACITY;
+    while (new_capacity < capacity)
+    {
+        new_capacity *= 2;
+    }
+
+    /* index slots hold a 32-bit offset, and are kept at most half full. */
+    if (new_capacity > UINT32_MAX / 2)
+    {
+        return ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* flat objects are searched linearly and have no index. */
+    index_size = indexed ? 2 * new_capacity : 0;
+
+    /* entries, order, and index share a single allocation. */
+    entries_size = new_capacity * sizeof(*entries);
+    order_size = new_capacity * sizeof(*order);
+    index_bytes = index_size * sizeof(*index);
+    retval =
+        allocator_allocate(
+            obj->alloc, (void**)&entries,
+            entries_size + order_size + index_bytes);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    order = (vcjson_object_entry**)((uint8_t*)entries + entries_size);
+    index = (uint32_t*)((uint8_t*)order + order_size);
+
+    /* move the existing entries, and rebase the sorted order if it is up to
+     * date; a stale order is rebuilt from the entries when next needed. */
+    if (obj->count > 0)
+    {
+        memcpy(entries, obj->entries, obj->count * sizeof(*entries));
+
+        if (VCJSON_OBJECT_ORDER_SORTED
+                == __atomic_load_n(&obj->order_state, __ATOMIC_RELAXED))
+        {
+            for (size_t i = 0; i < obj->count; ++i)
+            {
+                order[i] = entries + (obj->order[i] - obj->entries);
+            }
+        }
+    }
+
+    /* reclaim the old storage, unless it is part of the object. */
+    if (NULL != obj->entries && !obj->entries_inline)
+    {
+        retval = allocator_reclaim(obj->alloc, obj->entries);
+    }
+
+    /* install the new storage. */
+    obj->entries = entries;
+    obj->order = order;
+    obj->index = indexed ? index : NULL;
+    obj->capacity = new_capacity;
+    obj->index_size = index_size;
+    obj->entries_inline = false;
+
+    /* flat objects are done. */
+    if (!indexed)
+    {
+        return retval;
+    }
+
+    /* rebuild the index. */
+    memset(index, 0, index_bytes);
+    for (size_t i = 0; i < obj->count; ++i)
+    {
+        vcjson_object_hash_link(obj, i);
+    }
+
+    /* the object is valid even if the old storage could not be reclaimed. */
+    return retval;
+}
@@ -0,0 +1,36 @@
+/**
+ * \file vcjson_object_hash_slot.c
+ *
+ * \brief Find the index slot of an entry in a hash-backed object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Find the index slot holding the entry at the given offset in a
+ * hash-backed object.
+ *
+ * \note The entry must be linked in the index.
+ *
+ * \param obj           The object instance for this operation.
+ * \param offset        The offset of the entry to find.
+ *
+ * \returns the index slot holding this entry.
+ */
+size_t vcjson_object_hash_slot(const vcjson_object* obj, size_t offset)
+{
+    size_t mask = obj->index_size - 1;
+    size_t slot = (size_t)obj->entries[offset].hash & mask;
+
+    /* the entry is linked, so the probe ends at its slot. */
+    while (obj->index[slot] != (uint32_t)(offset + 1))
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file vcjson_object_hash_sort.c
+ *
+ * \brief Sort the entries of a flat or hash-backed object by key.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stdlib.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static int vcjson_object_hash_sort_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Sort the entries of a flat or hash-backed object by key.
+ *
+ * \note This rebuilds the sorted order from scratch, but does not mark it as up
+ * to date. Objects being read use \ref vcjson_object_hash_order instead.
+ *
+ * \param obj           The object instance for this operation.
+ */
+void vcjson_object_hash_sort(vcjson_object* obj)
+{
+    /* sort pointers to the entries, so that insertion order is preserved. */
+    for (size_t i = 0; i < obj->count; ++i)
+    {
+        obj->order[i] = &obj->entries[i];
+    }
+
+    if (obj->count > 1)
+    {
+        qsort(
+            obj->order, obj->count, sizeof(*obj->order),
+            &vcjson_object_hash_sort_compare);
+    }
+}
+
+/**
+ * \brief Compare two entry pointers by key, in the same order as a tree.
+ *
+ * \param lhs           Pointer to the left-hand-side entry pointer.
+ * \param rhs           Pointer to the right-hand-side entry pointer.
+ *
+ * \returns a negative, zero, or positive value as \p lhs is less than, equal
+ * to, or greater than \p rhs.
+ */
+static int vcjson_object_hash_sort_compare(const void* lhs, const void* rhs)
+{
+    const vcjson_object_entry* l = *(const vcjson_object_entry* const*)lhs;
+    const vcjson_object_entry* r = *(const vcjson_object_entry* const*)rhs;
+
+    switch (vcjson_object_element_compare(NULL, l->key, r->key))
+    {
+        case RCPR_COMPARE_LT:
+            return -1;
+
+        case RCPR_COMPARE_GT:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * \file vcjson_object_hash_unlink.c
+ *
+ * \brief Remove an entry from the index of a hash-backed object.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Empty the given slot in the index of a hash-backed object.
+ *
+ * Later entries in the same probe run are shifted back over the gap, so that
+ * every remaining entry is still reached from its home slot without leaving
+ * tombstones behind. Only the entries in this run are touched.
+ *
+ * \param obj           The object instance for this operation.
+ * \param slot          The index slot to empty.
+ */
+void vcjson_object_hash_unlink(vcjson_object* obj, size_t slot)
+{
+    size_t mask = obj->index_size - 1;
+    size_t next = slot;
+    size_t home;
+
+    for (;;)
+    {
+        next = (next + 1) & mask;
+        if (0 == obj->index[next])
+        {
+            break;
+        }
+
+        /* an entry may fill the gap only if its home slot is not between the
+         * gap and its current slot. */
+        home = (size_t)obj->entries[obj->index[next] - 1].hash & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            obj->index[slot] = obj->index[next];
+            slot = next;
+        }
+    }
+
+    obj->index[slot] = 0;
+}
@@ -12,7 +12,6 @@
 #include "vcjson_internal.h"
 
 RCPR_IMPORT_allocator;
-RCPR_IMPORT_rbtree;
 RCPR_IMPORT_resource;
 
 /**
@@ -43,18 +42,19 @@ vcjson_object_iterator_create(
 {
     status retval;
     vcjson_object_iterator* tmp = NULL;
-    rbtree_node* nil = rbtree_nil_node(obj->elements);
-    rbtree_node* root = rbtree_root_node(obj->elements);
+    vcjson_pool* pool;
 
-    /* if the root node is nil, then the iterator cannot be initialized. */
-    if (nil == root)
+    /* if the object is empty, then the iterator cannot be initialized. */
+    if (0 == vcjson_object_elements(obj))
     {
         retval = ERROR_VCJSON_ITERATOR_END;
         goto done;
     }
 
     /* allocate memory for this iterator instance. */
-    retval = allocator_allocate(obj->alloc, (void**)&tmp, sizeof(*tmp));
+    retval =
+        vcjson_pool_node_allocate(
+            &pool, obj->alloc, (void**)&tmp, sizeof(*tmp));
     if (STATUS_SUCCESS != retval)
     {
         goto done;
@@ -62,15 +62,15 @@ vcjson_object_iterator_create(
 
     /* clear this memory. */
     memset(tmp, 0, sizeof(*tmp));
+    tmp->pool = pool;
 
     /* initialize resource. */
     resource_init(&tmp->hdr, &vcjson_object_iterator_resource_release);
 
     /* set initial values. */
     tmp->alloc = obj->alloc;
-    tmp->tree = obj->elements;
-    tmp->nil = nil;
-    tmp->curr = rbtree_minimum_node(obj->elements, root);
+    tmp->obj = obj;
+    vcjson_object_cursor_begin(&tmp->cursor, obj);
 
     /* success. */
     retval = STATUS_SUCCESS;
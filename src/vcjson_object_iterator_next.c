@@ -11,8 +11,6 @@
 
 #include "vcjson_internal.h"
 
-RCPR_IMPORT_rbtree;
-
 /**
  * \brief Increment the given iterator to the next key-value pair in the object
  * to which it points.
@@ -32,15 +30,20 @@ RCPR_IMPORT_rbtree;
 status FN_DECL_MUST_CHECK
 vcjson_object_iterator_next(vcjson_object_iterator* iterator)
 {
+    const vcjson_string* key;
+    vcjson_value* value;
+
     /* verify that this iterator is valid. */
-    if (iterator->curr == iterator->nil)
+    if (!vcjson_object_cursor_member(
+            &key, &value, iterator->obj, &iterator->cursor))
     {
         return ERROR_VCJSON_ITERATOR_END;
     }
 
-    /* get the next node. */
-    iterator->curr = rbtree_successor_node(iterator->tree, iterator->curr);
-    if (iterator->curr == iterator->nil)
+    /* get the next member. */
+    vcjson_object_cursor_next(&iterator->cursor, iterator->obj);
+    if (!vcjson_object_cursor_member(
+            &key, &value, iterator->obj, &iterator->cursor))
     {
         return ERROR_VCJSON_ITERATOR_END;
     }
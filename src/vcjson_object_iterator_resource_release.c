@@ -23,13 +23,14 @@ vcjson_object_iterator_resource_release(RCPR_SYM(resource)* r)
 {
     vcjson_object_iterator* iter = (vcjson_object_iterator*)r;
 
-    /* cache allocator. */
+    /* cache allocator and pool. */
     allocator* alloc = iter->alloc;
+    vcjson_pool* pool = iter->pool;
 
     /* clear instance memory. */
     memset(iter, 0, sizeof(*iter));
 
     /* reclaim memory. */
     return
-        allocator_reclaim(alloc, iter);
+        vcjson_pool_node_reclaim(pool, alloc, iter, sizeof(*iter));
 }
@@ -11,8 +11,6 @@
 
 #include "vcjson_internal.h"
 
-RCPR_IMPORT_rbtree;
-
 /**
  * \brief Get the key-value pair associated with the current iterator position.
  *
@@ -36,25 +34,13 @@ vcjson_object_iterator_value(
     const vcjson_string** key, vcjson_value** value,
     vcjson_object_iterator* iterator)
 {
-    vcjson_object_element* elem = NULL;
-
-    /* Exit if the iterator is not currently valid. */
-    if (iterator->curr == iterator->nil)
-    {
-        return ERROR_VCJSON_ITERATOR_BAD;
-    }
-
-    /* get the element at this iterator position. */
-    elem = (vcjson_object_element*)
-            rbtree_node_value(
-                iterator->tree, iterator->curr);
-    if (NULL == elem)
+    /* get the member at this iterator position, if it is valid. */
+    if (!vcjson_object_cursor_member(
+            key, value, iterator->obj, &iterator->cursor))
     {
         return ERROR_VCJSON_ITERATOR_BAD;
     }
 
-    /* Success. Set the key and value. */
-    *key = elem->key;
-    *value = elem->value;
+    /* Success. The key and value are set. */
     return STATUS_SUCCESS;
 }
@@ -0,0 +1,138 @@
+/**
+ * \file vcjson_object_key_hash.c
+ *
+ * \brief Compute the hash of an object key.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/random.h>
+#include <time.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static void vcjson_object_key_seed_init(void);
+static uint64_t vcjson_object_key_load(const uint8_t* data);
+
+/* the per-process key of the hash, chosen once. */
+static pthread_once_t vcjson_object_key_seed_once = PTHREAD_ONCE_INIT;
+static uint64_t vcjson_object_key_seed[2];
+
+#define VCJSON_ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+/* one SipHash round. */
+#define VCJSON_SIPROUND(v0, v1, v2, v3) \
+    do { \
+        v0 += v1; v1 = VCJSON_ROTL(v1, 13); v1 ^= v0; \
+        v0 = VCJSON_ROTL(v0, 32); \
+        v2 += v3; v3 = VCJSON_ROTL(v3, 16); v3 ^= v2; \
+        v0 += v3; v3 = VCJSON_ROTL(v3, 21); v3 ^= v0; \
+        v2 += v1; v1 = VCJSON_ROTL(v1, 17); v1 ^= v2; \
+        v2 = VCJSON_ROTL(v2, 32); \
+    } while (0)
+
+/**
+ * \brief Compute the hash of an object key.
+ *
+ * This is SipHash-1-3, keyed with a random seed chosen once per process, so
+ * that keys colliding in an object's index cannot be crafted ahead of time.
+ * Hashes therefore differ between processes, and must not be persisted.
+ *
+ * \param key           The key bytes to hash.
+ * \param length        The length of this key, in bytes.
+ *
+ * \returns the 64-bit keyed hash of this key.
+ */
+uint64_t vcjson_object_key_hash(const char* key, size_t length)
+{
+    const uint8_t* data = (const uint8_t*)key;
+    const uint8_t* end = data + (length & ~(size_t)7);
+    uint64_t v0, v1, v2, v3, m;
+    uint8_t tail[8];
+
+    (void)pthread_once(
+        &vcjson_object_key_seed_once, &vcjson_object_key_seed_init);
+
+    v0 = vcjson_object_key_seed[0] ^ 0x736f6d6570736575ULL;
+    v1 = vcjson_object_key_seed[1] ^ 0x646f72616e646f6dULL;
+    v2 = vcjson_object_key_seed[0] ^ 0x6c7967656e657261ULL;
+    v3 = vcjson_object_key_seed[1] ^ 0x7465646279746573ULL;
+
+    /* compress each whole word with one round. */
+    for (; data != end; data += 8)
+    {
+        m = vcjson_object_key_load(data);
+        v3 ^= m;
+        VCJSON_SIPROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    /* the last word holds the remaining bytes and the length. */
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, data, length & 7);
+    m = vcjson_object_key_load(tail) | ((uint64_t)length << 56);
+    v3 ^= m;
+    VCJSON_SIPROUND(v0, v1, v2, v3);
+    v0 ^= m;
+
+    /* finalize with three rounds. */
+    v2 ^= 0xff;
+    VCJSON_SIPROUND(v0, v1, v2, v3);
+    VCJSON_SIPROUND(v0, v1, v2, v3);
+    VCJSON_SIPROUND(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/**
+ * \brief Choose the key of the hash for this process.
+ *
+ * The key comes from the system's random source. If that is unavailable, the
+ * time and addresses that vary between runs are mixed together instead.
+ */
+static void vcjson_object_key_seed_init(void)
+{
+    struct timespec now;
+    uint64_t z, m;
+
+    if ((ssize_t)sizeof(vcjson_object_key_seed)
+            == getrandom(
+                vcjson_object_key_seed, sizeof(vcjson_object_key_seed), 0))
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    z = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    z ^= (uint64_t)(uintptr_t)&now;
+    z ^= (uint64_t)(uintptr_t)&vcjson_object_key_seed_init << 17;
+
+    /* spread the entropy over both words with the splitmix64 finalizer. */
+    for (size_t i = 0; i < 2; ++i)
+    {
+        z += 0x9e3779b97f4a7c15ULL;
+        m = z;
+        m = (m ^ (m >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        m = (m ^ (m >> 27)) * 0x94d049bb133111ebULL;
+        vcjson_object_key_seed[i] = m ^ (m >> 31);
+    }
+}
+
+/**
+ * \brief Load a little-endian word.
+ */
+static uint64_t vcjson_object_key_load(const uint8_t* data)
+{
+    uint64_t word = 0;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        word |= (uint64_t)data[i] << (8 * i);
+    }
+
+    return word;
+}
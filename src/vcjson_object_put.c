@@ -29,6 +29,8 @@ RCPR_IMPORT_resource;
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
@@ -37,13 +39,124 @@ vcjson_object_put(
 {
     status retval, release_retval;
     vcjson_object_element* elem;
+    vcjson_pool* pool;
+    vcjson_object_entry* entry;
+    uint64_t hash;
+    size_t slot;
+
+    /* a shared object, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the emitted form of this object and its parents is now stale. */
+    retval = vcjson_emit_cache_invalidate(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* flat and hash storage keep their own entries. */
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        hash = vcjson_string_hash(key);
+
+        /* grow a hash table before probing, so that the empty slot found by
+         * the probe is still valid for an insert. */
+        if (VCJSON_OBJECT_STORAGE_HASH == obj->storage)
+        {
+            retval = vcjson_object_hash_reserve(obj, obj->count + 1);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+        }
+
+        /* a single probe finds the key, or the slot where it belongs. */
+        entry =
+            vcjson_object_hash_find(
+                obj, key->value, key->length, hash, &slot);
+        if (NULL != entry)
+        {
+            /* release the old value and key if found. */
+            retval = resource_release(&entry->value->hdr);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+
+            retval = resource_release(&entry->key->hdr);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto done;
+            }
+        }
+        else
+        {
+            /* a flat object that grows too large is promoted to a hash. */
+            if (VCJSON_OBJECT_STORAGE_FLAT == obj->storage
+             && obj->count >= VCJSON_OBJECT_FLAT_MAXIMUM_SIZE)
+            {
+                obj->storage = VCJSON_OBJECT_STORAGE_HASH;
+            }
+
+            /* make room for a new entry, indexing it if needed. */
+            retval = vcjson_object_hash_reserve(obj, obj->count + 1);
+            if (STATUS_SUCCESS != retval)
+            {
+                /* stay flat if the index could not be built. */
+                if (0 == obj->index_size)
+                {
+                    obj->storage = VCJSON_OBJECT_STORAGE_FLAT;
+                }
+
+                goto done;
+            }
+
+            entry = &obj->entries[obj->count];
+            entry->hash = hash;
+
+            /* the sorted order is rebuilt once, when it is next walked. */
+            __atomic_store_n(
+                &obj->order_state, VCJSON_OBJECT_ORDER_STALE,
+                __ATOMIC_RELAXED);
+
+            /* index the new entry, using the probed slot if there was one. */
+            if (SIZE_MAX != slot)
+            {
+                obj->index[slot] = (uint32_t)(obj->count + 1);
+            }
+            else if (obj->index_size > 0)
+            {
+                vcjson_object_hash_link(obj, obj->count);
+            }
+
+            ++obj->count;
+        }
+
+        /* set the new key and value. */
+        entry->key = key;
+        entry->value = value;
+
+        /* link the value's emit cache to this object. */
+        vcjson_emit_cache_adopt(&obj->cache, value);
+
+        /* success. */
+        retval = STATUS_SUCCESS;
+        goto done;
+    }
 
     /* attempt to find a value by key in the object's rbtree. */
     retval = rbtree_find((resource**)&elem, obj->elements, key);
     if (ERROR_RBTREE_NOT_FOUND == retval)
     {
         /* allocate the element if it's not found. */
-        retval = allocator_allocate(obj->alloc, (void**)&elem, sizeof(*elem));
+        retval =
+            vcjson_pool_node_allocate(
+                &pool, obj->alloc, (void**)&elem, sizeof(*elem));
         if (STATUS_SUCCESS != retval)
         {
             goto done;
@@ -51,6 +164,7 @@ vcjson_object_put(
 
         /* clear memory. */
         memset(elem, 0, sizeof(*elem));
+        elem->pool = pool;
 
         /* initialize resource. */
         resource_init(&elem->hdr, &vcjson_object_element_resource_release);
@@ -95,6 +209,9 @@ vcjson_object_put(
     elem->value = value;
     elem->owns_key = true;
 
+    /* link the value's emit cache to this object. */
+    vcjson_emit_cache_adopt(&obj->cache, value);
+
     /* success. */
     retval = STATUS_SUCCESS;
     goto done;
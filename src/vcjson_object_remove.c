@@ -12,6 +12,7 @@
 #include "vcjson_internal.h"
 
 RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
 
 /**
  * \brief Remove the given key from the object.
@@ -27,12 +28,100 @@ RCPR_IMPORT_rbtree;
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
  *      - a non-zero error code on failure.
  */
 status FN_DECL_MUST_CHECK
 vcjson_object_remove(vcjson_object* obj, const vcjson_string* key)
 {
-    status retval;
+    status retval, release_retval;
+    vcjson_object_entry* entry;
+    vcjson_string* oldkey;
+    vcjson_value* oldvalue;
+    size_t offset, last;
+
+    /* a shared object, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the emitted form of this object and its parents is now stale. */
+    retval = vcjson_emit_cache_invalidate(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* remove this key from flat or hash storage. */
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        entry =
+            vcjson_object_hash_find(
+                obj, key->value, key->length, vcjson_string_hash(key), NULL);
+        if (NULL == entry)
+        {
+            /* if the element does not exist, then it is removed... */
+            return STATUS_SUCCESS;
+        }
+
+        oldkey = entry->key;
+        oldvalue = entry->value;
+        offset = (size_t)(entry - obj->entries);
+        last = obj->count - 1;
+
+        /* the sorted order is rebuilt once, when it is next walked. */
+        __atomic_store_n(
+            &obj->order_state, VCJSON_OBJECT_ORDER_STALE, __ATOMIC_RELAXED);
+        --obj->count;
+
+        /* drop this entry from any index. */
+        if (obj->index_size > 0)
+        {
+            vcjson_object_hash_unlink(
+                obj, vcjson_object_hash_slot(obj, offset));
+        }
+
+        if (obj->insertion_order)
+        {
+            /* close the gap, keeping the remaining entries in insertion
+             * order. */
+            memmove(entry, entry + 1, (last - offset) * sizeof(*entry));
+
+            /* rebase their index slots in place, without rehashing. */
+            for (size_t i = 0; i < obj->index_size; ++i)
+            {
+                if (obj->index[i] > offset + 1)
+                {
+                    --obj->index[i];
+                }
+            }
+        }
+        else if (offset != last)
+        {
+            /* move the last entry into the gap, relinking only it. */
+            if (obj->index_size > 0)
+            {
+                obj->index[vcjson_object_hash_slot(obj, last)] =
+                    (uint32_t)(offset + 1);
+            }
+
+            *entry = obj->entries[last];
+        }
+
+        /* release the removed key and value. */
+        retval = resource_release(&oldkey->hdr);
+        release_retval = resource_release(&oldvalue->hdr);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+
+        return retval;
+    }
 
     /* delete this key from the tree. */
     retval = rbtree_delete(NULL, obj->elements, key);
@@ -25,8 +25,15 @@ vcjson_object_resource_release(RCPR_SYM(resource)* r)
 {
     status reclaim_retval = STATUS_SUCCESS;
     status elements_release_retval = STATUS_SUCCESS;
+    status cache_retval;
     vcjson_object* obj = (vcjson_object*)r;
 
+    /* a shared object is only released by the last value sharing it. */
+    if (__atomic_fetch_sub(&obj->shares, 1, __ATOMIC_ACQ_REL) > 0)
+    {
+        return STATUS_SUCCESS;
+    }
+
     /* cache allocator. */
     allocator* alloc = obj->alloc;
 
@@ -37,6 +44,29 @@ vcjson_object_resource_release(RCPR_SYM(resource)* r)
             resource_release(rbtree_resource_handle(obj->elements));
     }
 
+    /* release flat or hash entries and their storage if set. */
+    if (NULL != obj->entries)
+    {
+        elements_release_retval = vcjson_object_hash_clear(obj);
+
+        /* inline entries are reclaimed with the object. */
+        if (!obj->entries_inline)
+        {
+            reclaim_retval = allocator_reclaim(alloc, obj->entries);
+            if (STATUS_SUCCESS == elements_release_retval)
+            {
+                elements_release_retval = reclaim_retval;
+            }
+        }
+    }
+
+    /* release the emit cache. */
+    cache_retval = vcjson_emit_cache_reset(&obj->cache);
+    if (STATUS_SUCCESS == elements_release_retval)
+    {
+        elements_release_retval = cache_retval;
+    }
+
     /* clear structure. */
     memset(obj, 0, sizeof(*obj));
 
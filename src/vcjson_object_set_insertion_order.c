@@ -0,0 +1,69 @@
+/**
+ * \file vcjson_object_set_insertion_order.c
+ *
+ * \brief Choose whether an object walks its members in insertion order.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Choose whether an object walks its members in insertion order.
+ *
+ * By default, objects iterate and emit their members in sorted key order. An
+ * object using \ref VCJSON_OBJECT_STORAGE_HASH or
+ * \ref VCJSON_OBJECT_STORAGE_FLAT can instead keep the order in which its
+ * members were first put. Replacing the value of an existing key keeps its
+ * position, and removing a member keeps the order of the rest. Members are
+ * removed faster while this is off, by moving the last member into the gap,
+ * so turning it on after such a removal walks the members in the order they
+ * were left in. Canonical emission always sorts members.
+ *
+ * \param obj           The object instance for this operation.
+ * \param enabled       true to walk members in insertion order, or false to
+ *                      walk them in sorted key order.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if this object is shared with a copy of its
+ *        value, or is held in a container that is.
+ *      - ERROR_VCJSON_OBJECT_BAD_STORAGE if \p obj uses
+ *        \ref VCJSON_OBJECT_STORAGE_TREE.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_object_set_insertion_order(vcjson_object* obj, bool enabled)
+{
+    status retval;
+
+    /* a shared object, or one nested under a shared container, must be
+     * unshared by its value before it is modified. */
+    retval = vcjson_emit_cache_check_exclusive(&obj->cache);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* a tree only knows its sorted order. */
+    if (VCJSON_OBJECT_STORAGE_TREE == obj->storage)
+    {
+        return ERROR_VCJSON_OBJECT_BAD_STORAGE;
+    }
+
+    /* the member order is visible in the emitted form. */
+    if (obj->insertion_order != enabled)
+    {
+        retval = vcjson_emit_cache_invalidate(&obj->cache);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        obj->insertion_order = enabled;
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -35,13 +35,17 @@ static status
         vcjson_value** value, vcjson_parser_context* ctx);
 static status
     vcjson_read_string(
-        vcjson_string** string, vcjson_parser_context* ctx);
+        vcjson_string** string, vcjson_value** value,
+        vcjson_parser_context* ctx);
 static status
     vcjson_read_value_object(
         vcjson_value** value, vcjson_parser_context* ctx);
 static status
     vcjson_read_value_object_member(
         vcjson_object* obj, vcjson_parser_context* ctx);
+static bool
+    vcjson_read_is_sensitive_key(
+        const vcjson_string* key, const vcjson_parser_context* ctx);
 static status
     vcjson_read_value_array(
         vcjson_value** value, vcjson_parser_context* ctx);
@@ -51,6 +55,20 @@ static status
 static status
     vcjson_read_value_number(
         vcjson_value** value, vcjson_parser_context* ctx);
+static status
+    vcjson_read_number(
+        double* number, vcjson_parser_context* ctx);
+static status
+    vcjson_read_array_number(
+        bool* is_number, double** numbers, size_t* count, size_t* capacity,
+        vcjson_parser_context* ctx);
+static status
+    vcjson_read_array_box_numbers(
+        slist* list, const double* numbers, size_t count, allocator* alloc);
+static status
+    vcjson_read_array_from_numbers(
+        vcjson_value** value, allocator* alloc, const double* numbers,
+        size_t count);
 static status
     vcjson_string_simplify(
         char* output, size_t output_len, size_t* simplified_len,
@@ -79,6 +97,85 @@ status FN_DECL_MUST_CHECK
 vcjson_parse(
     vcjson_value** value, size_t* error_begin, size_t* error_end,
     RCPR_SYM(allocator)* alloc, const char* input, size_t size)
+{
+    return
+        vcjson_parse_with_flags(
+            value, error_begin, error_end, alloc, input, size, 0);
+}
+
+/**
+ * \brief Attempt to parse a JSON value from a UTF-8 character buffer, using
+ * the given \ref vcjson_parse_flags.
+ *
+ * With \ref VCJSON_PARSE_FLAG_INSERTION_ORDER, every parsed object walks its
+ * members in the order in which they appear in the input, as if by
+ * \ref vcjson_object_set_insertion_order.
+ *
+ * With \ref VCJSON_PARSE_FLAG_SENSITIVE, every parsed string and key is
+ * sensitive, as if by \ref vcjson_string_set_sensitive, and the parser wipes
+ * its working buffers.
+ *
+ * \note This parse function must consume all input to be successful.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param error_begin   Pointer to receive the start of an error location on
+ *                      failure.
+ * \param error_end     Pointer to receive the end of an error location on
+ *                      failure.
+ * \param alloc         The allocator to use for this operation.
+ * \param input         The input UTF-8 character buffer.
+ * \param size          The size of this buffer.
+ * \param flags         The \ref vcjson_parse_flags for this parse.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_parse_with_flags(
+    vcjson_value** value, size_t* error_begin, size_t* error_end,
+    RCPR_SYM(allocator)* alloc, const char* input, size_t size,
+    uint32_t flags)
+{
+    return
+        vcjson_parse_with_sensitive_keys(
+            value, error_begin, error_end, alloc, input, size, flags, NULL, 0);
+}
+
+/**
+ * \brief Attempt to parse a JSON value from a UTF-8 character buffer, marking
+ * the members with the given keys as sensitive.
+ *
+ * The value of every object member whose key is in \p keys is sensitive, as
+ * if by \ref vcjson_value_set_sensitive, at any depth in the document. The
+ * parser wipes its working buffers only while reading these values. The keys
+ * themselves are not sensitive, unless they are within a sensitive value.
+ *
+ * \note This parse function must consume all input to be successful.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param error_begin   Pointer to receive the start of an error location on
+ *                      failure.
+ * \param error_end     Pointer to receive the end of an error location on
+ *                      failure.
+ * \param alloc         The allocator to use for this operation.
+ * \param input         The input UTF-8 character buffer.
+ * \param size          The size of this buffer.
+ * \param flags         The \ref vcjson_parse_flags for this parse.
+ * \param keys          The keys of the sensitive members.
+ * \param key_count     The number of keys in \p keys.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_parse_with_sensitive_keys(
+    vcjson_value** value, size_t* error_begin, size_t* error_end,
+    RCPR_SYM(allocator)* alloc, const char* input, size_t size,
+    uint32_t flags, const char* const* keys, size_t key_count)
 {
     status retval, release_retval;
     int symbol;
@@ -96,6 +193,10 @@ vcjson_parse(
     ctx.size = size;
     ctx.offset = &offset;
     ctx.recursion_depth = 0;
+    ctx.flags = flags;
+    ctx.sensitive_keys = keys;
+    ctx.sensitive_key_count = key_count;
+    ctx.sensitive = (0 != (flags & VCJSON_PARSE_FLAG_SENSITIVE));
 
     /* read a value. */
     retval = vcjson_read_value(value, &ctx);
@@ -234,8 +335,35 @@ static status
     vcjson_read_value_number(
         vcjson_value** value, vcjson_parser_context* ctx)
 {
-    status retval, release_retval;
-    vcjson_number* number;
+    status retval;
+    double numberval;
+
+    /* convert the scanned symbol to a number. */
+    retval = vcjson_read_number(&numberval, ctx);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* create a JSON value holding this number. */
+    return vcjson_value_create_number(value, ctx->alloc, numberval);
+}
+
+/**
+ * \brief Convert the number symbol that was just scanned to a double.
+ *
+ * \param number        Pointer to receive the number on success.
+ * \param ctx           The parser context for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status
+    vcjson_read_number(
+        double* number, vcjson_parser_context* ctx)
+{
+    status retval;
     char* buffer;
     size_t buffer_size;
 
@@ -246,7 +374,7 @@ static status
     retval = allocator_allocate(ctx->alloc, (void**)&buffer, buffer_size + 1);
     if (STATUS_SUCCESS != retval)
     {
-        goto done;
+        return retval;
     }
 
     /* copy the string value. */
@@ -254,43 +382,15 @@ static status
     buffer[buffer_size] = 0;
 
     /* convert this to a number. */
-    double numberval = atof(buffer);
-
-    /* create a JSON number. */
-    retval = vcjson_number_create(&number, ctx->alloc, numberval);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_buffer;
-    }
+    *number = atof(buffer);
 
-    /* create a JSON value. */
-    retval = vcjson_value_create_from_number(value, ctx->alloc, number);
-    if (STATUS_SUCCESS != retval)
+    /* clean up the working buffer, wiping it if this number is sensitive. */
+    if (ctx->sensitive)
     {
-        goto cleanup_number;
+        memset(buffer, 0, buffer_size);
     }
 
-    /* success. */
-    retval = STATUS_SUCCESS;
-    goto cleanup_buffer;
-
-cleanup_number:
-    release_retval = resource_release(vcjson_number_resource_handle(number));
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-cleanup_buffer:
-    memset(buffer, 0, buffer_size);
-    release_retval = allocator_reclaim(ctx->alloc, buffer);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
+    return allocator_reclaim(ctx->alloc, buffer);
 }
 
 /**
@@ -308,44 +408,20 @@ static status
     vcjson_read_value_string(
         vcjson_value** value, vcjson_parser_context* ctx)
 {
-    status retval, release_retval;
-    vcjson_string* string_value;
-
-    /* read the string. */
-    retval = vcjson_read_string(&string_value, ctx);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-    /* create a value from this string value. */
-    retval = vcjson_value_create_from_string(value, ctx->alloc, string_value);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_string_value;
-    }
-
-    /* success. */
-    retval = STATUS_SUCCESS;
-    goto done;
-
-cleanup_string_value:
-    release_retval =
-        resource_release(vcjson_string_resource_handle(string_value));
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
+    /* read the string directly into a value. */
+    return vcjson_read_string(NULL, value, ctx);
 }
 
 /**
  * \brief Create a string from input.
  *
+ * When \p value is not NULL, the string is created along with a value holding
+ * it in a single allocation, and \p string is ignored.
+ *
  * \param string        Pointer to the string pointer to hold the JSON string on
  *                      success.
+ * \param value         Optional pointer to the value pointer to hold a JSON
+ *                      string value on success.
  * \param ctx           The parser context for this operation.
  *
  * \returns a status code indicating success or failure.
@@ -354,7 +430,8 @@ done:
  */
 static status
     vcjson_read_string(
-        vcjson_string** string, vcjson_parser_context* ctx)
+        vcjson_string** string, vcjson_value** value,
+        vcjson_parser_context* ctx)
 {
     status retval, release_retval;
     char* buffer;
@@ -381,20 +458,44 @@ static status
         goto cleanup_buffer;
     }
 
-    /* create a string from this value. */
-    retval =
-        vcjson_string_create_from_raw(string, ctx->alloc, buffer, length);
+    /* create a string or string value from this value. */
+    if (NULL != value)
+    {
+        retval =
+            vcjson_value_create_string_from_raw(
+                value, ctx->alloc, buffer, length);
+    }
+    else
+    {
+        retval =
+            vcjson_string_create_from_raw(string, ctx->alloc, buffer, length);
+    }
     if (STATUS_SUCCESS != retval)
     {
         goto cleanup_buffer;
     }
 
+    /* mark the string if it is sensitive. */
+    if (NULL != value)
+    {
+        ((vcjson_string*)(*value)->value)->sensitive = ctx->sensitive;
+    }
+    else
+    {
+        (*string)->sensitive = ctx->sensitive;
+    }
+
     /* success. */
     retval = STATUS_SUCCESS;
     goto cleanup_buffer;
 
 cleanup_buffer:
-    memset(buffer, 0, buffer_size);
+    /* only a sensitive string is wiped from the working buffer. */
+    if (ctx->sensitive)
+    {
+        memset(buffer, 0, buffer_size);
+    }
+
     release_retval = allocator_reclaim(ctx->alloc, buffer);
     if (STATUS_SUCCESS != release_retval)
     {
@@ -639,13 +740,21 @@ static status
     vcjson_object* obj;
     bool expecting_comma = false;
 
-    /* create an empty object instance. */
-    retval = vcjson_object_create(&obj, ctx->alloc);
+    /* create an empty flat object, which becomes a hash table if it grows. */
+    retval =
+        vcjson_object_create_with_storage(
+            &obj, ctx->alloc, VCJSON_OBJECT_STORAGE_FLAT);
     if (STATUS_SUCCESS != retval)
     {
         goto done;
     }
 
+    /* keep members in document order if requested. */
+    if (0 != (ctx->flags & VCJSON_PARSE_FLAG_INSERTION_ORDER))
+    {
+        obj->insertion_order = true;
+    }
+
     /* iterate through the object members. */
     for (;;)
     {
@@ -760,9 +869,10 @@ static status vcjson_read_value_object_member(
     int symbol;
     vcjson_string* elemkey;
     vcjson_value* elemvalue;
+    bool sensitive = ctx->sensitive;
 
     /* read the key string. */
-    retval = vcjson_read_string(&elemkey, ctx);
+    retval = vcjson_read_string(&elemkey, NULL, ctx);
     if (STATUS_SUCCESS != retval)
     {
         goto done;
@@ -785,8 +895,15 @@ static status vcjson_read_value_object_member(
         goto cleanup_elemkey;
     }
 
+    /* the value of a sensitive key is sensitive. */
+    if (vcjson_read_is_sensitive_key(elemkey, ctx))
+    {
+        ctx->sensitive = true;
+    }
+
     /* read a value. */
     retval = vcjson_read_value(&elemvalue, ctx);
+    ctx->sensitive = sensitive;
     if (STATUS_SUCCESS != retval)
     {
         goto cleanup_elemkey;
@@ -821,6 +938,32 @@ done:
     return retval;
 }
 
+/**
+ * \brief Determine whether a key is one of the parser's sensitive keys.
+ *
+ * \param key           The key to check.
+ * \param ctx           The parser context for this operation.
+ *
+ * \returns true if this key is sensitive, and false otherwise.
+ */
+static bool
+    vcjson_read_is_sensitive_key(
+        const vcjson_string* key, const vcjson_parser_context* ctx)
+{
+    for (size_t i = 0; i < ctx->sensitive_key_count; ++i)
+    {
+        const char* sensitive_key = ctx->sensitive_keys[i];
+
+        if (strlen(sensitive_key) == key->length
+         && 0 == memcmp(sensitive_key, key->value, key->length))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * \brief Create an array value from input.
  *
@@ -842,6 +985,11 @@ static status
     bool expecting_comma = false;
     slist* list;
     size_t primpos;
+    bool is_number;
+    bool packing = true;
+    double* numbers = NULL;
+    size_t number_count = 0;
+    size_t number_capacity = 0;
 
     /* create an slist instance for holding array values. */
     retval = slist_create(&list, ctx->alloc);
@@ -915,11 +1063,25 @@ static status
 
                 /* if this is an empty array or there was no comma after the
                  * last element, then this is valid. */
-                if (slist_count(list) == 0 || expecting_comma)
+                if (
+                    (slist_count(list) == 0 && 0 == number_count)
+                 || expecting_comma)
                 {
-                    /* create an array value from this list. */
-                    retval =
-                        vcjson_read_array_from_list(value, ctx->alloc, list);
+                    /* an array of only numbers is packed. */
+                    if (0 != number_count)
+                    {
+                        retval =
+                            vcjson_read_array_from_numbers(
+                                value, ctx->alloc, numbers, number_count);
+                    }
+                    /* otherwise, create an array value from this list. */
+                    else
+                    {
+                        retval =
+                            vcjson_read_array_from_list(
+                                value, ctx->alloc, list);
+                    }
+
                     if (STATUS_SUCCESS != retval)
                     {
                         goto cleanup_list;
@@ -940,11 +1102,43 @@ static status
             default:
                 if (expecting_comma)
                 {
-                    return
+                    retval =
                         ERROR_VCJSON_PARSE_da3c5b50_0456_4acd_904b_2a72464e59ae;
+                    goto cleanup_list;
                 }
                 else
                 {
+                    /* while every element is a number, keep it unboxed. */
+                    if (packing)
+                    {
+                        retval =
+                            vcjson_read_array_number(
+                                &is_number, &numbers, &number_count,
+                                &number_capacity, ctx);
+                        if (STATUS_SUCCESS != retval)
+                        {
+                            goto cleanup_list;
+                        }
+
+                        if (is_number)
+                        {
+                            expecting_comma = true;
+                            break;
+                        }
+
+                        /* box the numbers read so far, and stop packing. */
+                        retval =
+                            vcjson_read_array_box_numbers(
+                                list, numbers, number_count, ctx->alloc);
+                        if (STATUS_SUCCESS != retval)
+                        {
+                            goto cleanup_list;
+                        }
+
+                        packing = false;
+                        number_count = 0;
+                    }
+
                     /* try to read a value from input. */
                     retval = vcjson_read_value(&elemval, ctx);
                     if (STATUS_SUCCESS != retval)
@@ -975,6 +1169,15 @@ static status
     }
 
 cleanup_list:
+    if (NULL != numbers)
+    {
+        release_retval = allocator_reclaim(ctx->alloc, numbers);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
     release_retval = resource_release(slist_resource_handle(list));
     if (STATUS_SUCCESS != release_retval)
     {
@@ -985,6 +1188,184 @@ done:
     return retval;
 }
 
+/**
+ * \brief Read an array element if it is a number, keeping it unboxed.
+ *
+ * \note If the next element is not a number, the input offset is left where
+ * it was, so that the element can be read as a value.
+ *
+ * \param is_number     Pointer to receive whether a number was read.
+ * \param numbers       Pointer to the growable buffer of numbers read so far.
+ * \param count         Pointer to the number of numbers read so far.
+ * \param capacity      Pointer to the capacity of the buffer.
+ * \param ctx           The parser context for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_PARSE_c207ee84_a90b_4d01_9314_a769a460819a if the next
+ *        element is malformed.
+ *      - a non-zero error code on failure, such as an allocation failure,
+ *        which is returned unchanged.
+ */
+static status
+    vcjson_read_array_number(
+        bool* is_number, double** numbers, size_t* count, size_t* capacity,
+        vcjson_parser_context* ctx)
+{
+    status retval;
+    int symbol;
+    size_t mark = *ctx->offset;
+    size_t new_capacity;
+    double number;
+
+    /* scan the next symbol. */
+    retval =
+        vcjson_scan_symbol(
+            &symbol, ctx->error_begin, ctx->error_end, ctx->input, ctx->size,
+            ctx->offset);
+    if (STATUS_SUCCESS != retval)
+    {
+        /* this element is malformed, just as if it were read as a value. */
+        return ERROR_VCJSON_PARSE_c207ee84_a90b_4d01_9314_a769a460819a;
+    }
+
+    /* if this is not a number, rewind so that it is read as a value. */
+    if (VCJSON_LEXER_SYMBOL_NUMBER != symbol)
+    {
+        *ctx->offset = mark;
+        *is_number = false;
+        return STATUS_SUCCESS;
+    }
+
+    /* convert the number. */
+    retval = vcjson_read_number(&number, ctx);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* grow the buffer geometrically. */
+    if (*count == *capacity)
+    {
+        new_capacity =
+            *capacity > 0 ? 2 * *capacity : VCJSON_ARRAY_MINIMUM_CAPACITY;
+
+        if (NULL == *numbers)
+        {
+            retval =
+                allocator_allocate(
+                    ctx->alloc, (void**)numbers,
+                    new_capacity * sizeof(**numbers));
+        }
+        else
+        {
+            retval =
+                allocator_reallocate(
+                    ctx->alloc, (void**)numbers,
+                    new_capacity * sizeof(**numbers));
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        *capacity = new_capacity;
+    }
+
+    (*numbers)[(*count)++] = number;
+    *is_number = true;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Box the given numbers into values at the end of the given list.
+ *
+ * \param list          The list for this operation.
+ * \param numbers       The numbers to box.
+ * \param count         The number of numbers.
+ * \param alloc         The allocator to use for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status
+    vcjson_read_array_box_numbers(
+        slist* list, const double* numbers, size_t count, allocator* alloc)
+{
+    status retval, release_retval;
+    vcjson_value* elemval;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        /* create a JSON value holding this number. */
+        retval = vcjson_value_create_number(&elemval, alloc, numbers[i]);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* append this value to the end of the list. */
+        retval = slist_append_tail(list, &elemval->hdr);
+        if (STATUS_SUCCESS != retval)
+        {
+            release_retval = resource_release(&elemval->hdr);
+            if (STATUS_SUCCESS != release_retval)
+            {
+                retval = release_retval;
+            }
+
+            return retval;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Create a packed array value from the given numbers.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param alloc         The allocator to use for this operation.
+ * \param numbers       The numbers for this array.
+ * \param count         The number of numbers.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status
+    vcjson_read_array_from_numbers(
+        vcjson_value** value, allocator* alloc, const double* numbers,
+        size_t count)
+{
+    status retval, release_retval;
+    vcjson_array* array;
+
+    /* create the packed array instance. */
+    retval = vcjson_array_create_from_doubles(&array, alloc, numbers, count);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* convert the array to a value. */
+    retval = vcjson_value_create_from_array(value, alloc, array);
+    if (STATUS_SUCCESS != retval)
+    {
+        release_retval = resource_release(vcjson_array_resource_handle(array));
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    return retval;
+}
+
 /**
  * \brief Convert the given list to an array.
  *
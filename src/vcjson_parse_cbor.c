@@ -0,0 +1,1105 @@
+/**
+ * \file vcjson_parse_cbor.c
+ *
+ * \brief Create a JSON value from an RFC 8949 CBOR buffer.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/* the additional information value of an indefinite-length item. */
+#define VCJSON_PARSE_CBOR_INDEFINITE                                        31
+
+/* the break byte that ends an indefinite-length item. */
+#define VCJSON_PARSE_CBOR_BREAK                                           0xff
+
+/* the number of members first reserved for an indefinite-length map. */
+#define VCJSON_PARSE_CBOR_MAP_CAPACITY                                       8
+
+typedef struct vcjson_parse_cbor_context vcjson_parse_cbor_context;
+struct vcjson_parse_cbor_context
+{
+    allocator* alloc;
+    const uint8_t* input;
+    size_t size;
+    size_t offset;
+    size_t recursion_depth;
+    uint32_t flags;
+    bool sensitive;
+    /* the offset of the innermost item that failed, once set. */
+    size_t* error_offset;
+    bool failed;
+};
+
+/* forward decls. */
+static status vcjson_parse_cbor_item(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx);
+static status vcjson_parse_cbor_head(
+    uint8_t* major, uint8_t* info, uint64_t* argument,
+    vcjson_parse_cbor_context* ctx);
+static status vcjson_parse_cbor_simple(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx, uint8_t info,
+    uint64_t argument);
+static status vcjson_parse_cbor_number(
+    double* number, uint8_t major, uint8_t info, uint64_t argument);
+static double vcjson_parse_cbor_half(uint16_t half);
+static bool vcjson_parse_cbor_next_is_number(
+    const vcjson_parse_cbor_context* ctx);
+static status vcjson_parse_cbor_string(
+    vcjson_string** string, vcjson_value** value,
+    vcjson_parse_cbor_context* ctx, uint8_t info, uint64_t argument);
+static status vcjson_parse_cbor_text(
+    const char** text, size_t* length, char** buffer,
+    vcjson_parse_cbor_context* ctx, uint8_t info, uint64_t argument);
+static status vcjson_parse_cbor_array(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx, uint8_t info,
+    uint64_t argument);
+static status vcjson_parse_cbor_map(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx, uint8_t info,
+    uint64_t argument);
+static status vcjson_parse_cbor_fail(
+    vcjson_parse_cbor_context* ctx, size_t offset, status retval);
+
+/**
+ * \brief Attempt to parse a JSON value from an RFC 8949 CBOR buffer, using
+ * the given \ref vcjson_parse_flags.
+ *
+ * Integers and floating point numbers of every width become numbers, text
+ * strings become strings, and maps with text string keys become objects.
+ * Arrays holding only numbers become packed arrays. Both definite and
+ * indefinite-length items are accepted. Tags are skipped, and the undefined
+ * simple value becomes null. Byte strings, keys that are not text strings,
+ * other simple values, and numbers that are not finite have no JSON form and
+ * are not supported.
+ *
+ * The flags have the same meaning as for \ref vcjson_parse_with_flags.
+ *
+ * \note This parse function must consume all input to be successful.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param error_offset  Pointer to receive the offset of the data item at which
+ *                      parsing failed, on failure.
+ * \param alloc         The allocator to use for this operation.
+ * \param input         The input CBOR buffer.
+ * \param size          The size of this buffer.
+ * \param flags         The \ref vcjson_parse_flags for this parse.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_CBOR_TRUNCATED if the input ends within a data item.
+ *      - ERROR_VCJSON_CBOR_MALFORMED if the input is not well-formed CBOR, or
+ *        if data follows the first data item.
+ *      - ERROR_VCJSON_CBOR_UNSUPPORTED if a data item has no JSON form.
+ *      - ERROR_VCJSON_OBJECT_DUPLICATE_KEY if a map repeats a key.
+ *      - ERROR_VCJSON_PARSE_RECURSION_DEPTH_EXCEEDED if the input nests
+ *        deeper than \ref VCJSON_PARSER_MAXIMUM_RECURSION_DEPTH.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_parse_cbor(
+    vcjson_value** value, size_t* error_offset, RCPR_SYM(allocator)* alloc,
+    const void* input, size_t size, uint32_t flags)
+{
+    status retval, release_retval;
+    vcjson_parse_cbor_context ctx;
+
+    /* initialize the parser context. */
+    *error_offset = 0;
+    ctx.alloc = alloc;
+    ctx.input = (const uint8_t*)input;
+    ctx.size = size;
+    ctx.offset = 0;
+    ctx.recursion_depth = 0;
+    ctx.flags = flags;
+    ctx.sensitive = (0 != (flags & VCJSON_PARSE_FLAG_SENSITIVE));
+    ctx.error_offset = error_offset;
+    ctx.failed = false;
+
+    /* read a data item. */
+    retval = vcjson_parse_cbor_item(value, &ctx);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* verify that it is the whole input. */
+    if (ctx.offset != ctx.size)
+    {
+        retval =
+            vcjson_parse_cbor_fail(
+                &ctx, ctx.offset, ERROR_VCJSON_CBOR_MALFORMED);
+        goto cleanup_value;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_value:
+    release_retval = resource_release(vcjson_value_resource_handle(*value));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Read a single data item from input.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param ctx           The parser context for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_parse_cbor_item(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx)
+{
+    status retval;
+    size_t begin = ctx->offset;
+    uint8_t major, info;
+    uint64_t argument;
+    double number;
+
+    /* check the recursion depth. */
+    if (ctx->recursion_depth >= VCJSON_PARSER_MAXIMUM_RECURSION_DEPTH)
+    {
+        return
+            vcjson_parse_cbor_fail(
+                ctx, begin, ERROR_VCJSON_PARSE_RECURSION_DEPTH_EXCEEDED);
+    }
+    else
+    {
+        ++ctx->recursion_depth;
+    }
+
+    /* tags have no JSON form, so the item that they enclose is read. */
+    do
+    {
+        retval = vcjson_parse_cbor_head(&major, &info, &argument, ctx);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    } while (6 == major);
+
+    /* decode the item by its major type. */
+    switch (major)
+    {
+        /* read an unsigned or negative integer. */
+        case 0:
+        case 1:
+            retval = vcjson_parse_cbor_number(&number, major, info, argument);
+            if (STATUS_SUCCESS == retval)
+            {
+                retval =
+                    vcjson_value_create_number(value, ctx->alloc, number);
+            }
+            goto done;
+
+        /* read a text string. */
+        case 3:
+            retval =
+                vcjson_parse_cbor_string(NULL, value, ctx, info, argument);
+            goto done;
+
+        /* read an array. */
+        case 4:
+            retval = vcjson_parse_cbor_array(value, ctx, info, argument);
+            goto done;
+
+        /* read a map. */
+        case 5:
+            retval = vcjson_parse_cbor_map(value, ctx, info, argument);
+            goto done;
+
+        /* read a simple value or a floating point number. */
+        case 7:
+            retval = vcjson_parse_cbor_simple(value, ctx, info, argument);
+            goto done;
+
+        /* byte strings have no JSON form. */
+        default:
+            retval = ERROR_VCJSON_CBOR_UNSUPPORTED;
+            goto done;
+    }
+
+done:
+    --ctx->recursion_depth;
+
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = vcjson_parse_cbor_fail(ctx, begin, retval);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Read the head of a data item: its major type, additional
+ * information, and argument.
+ *
+ * \param major         Pointer to receive the major type.
+ * \param info          Pointer to receive the additional information.
+ * \param argument      Pointer to receive the argument, which is zero for an
+ *                      indefinite-length item.
+ * \param ctx           The parser context for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_CBOR_TRUNCATED if the input ends within this head.
+ *      - ERROR_VCJSON_CBOR_MALFORMED if this head is not well-formed.
+ */
+static status vcjson_parse_cbor_head(
+    uint8_t* major, uint8_t* info, uint64_t* argument,
+    vcjson_parse_cbor_context* ctx)
+{
+    uint8_t initial;
+    size_t bytes;
+
+    if (ctx->offset >= ctx->size)
+    {
+        return ERROR_VCJSON_CBOR_TRUNCATED;
+    }
+
+    initial = ctx->input[ctx->offset++];
+    *major = initial >> 5;
+    *info = initial & 0x1f;
+    *argument = 0;
+
+    /* small arguments are held in the initial byte. */
+    if (*info < 24)
+    {
+        *argument = *info;
+        return STATUS_SUCCESS;
+    }
+
+    /* only strings, containers, and the break may be indefinite. */
+    if (VCJSON_PARSE_CBOR_INDEFINITE == *info)
+    {
+        switch (*major)
+        {
+            case 2:
+            case 3:
+            case 4:
+            case 5:
+            case 7:
+                return STATUS_SUCCESS;
+
+            default:
+                return ERROR_VCJSON_CBOR_MALFORMED;
+        }
+    }
+
+    /* additional information values 28 through 30 are reserved. */
+    if (*info > 27)
+    {
+        return ERROR_VCJSON_CBOR_MALFORMED;
+    }
+
+    /* the argument follows in network byte order. */
+    bytes = (size_t)1 << (*info - 24);
+    if (bytes > ctx->size - ctx->offset)
+    {
+        return ERROR_VCJSON_CBOR_TRUNCATED;
+    }
+
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        *argument = (*argument << 8) | ctx->input[ctx->offset + i];
+    }
+
+    ctx->offset += bytes;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Create a value from a simple value or a floating point number.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param ctx           The parser context for this operation.
+ * \param info          The additional information of this item.
+ * \param argument      The argument of this item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_parse_cbor_simple(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx, uint8_t info,
+    uint64_t argument)
+{
+    status retval;
+    double number;
+
+    switch (info)
+    {
+        case 20:
+            return vcjson_value_create_from_false(value, ctx->alloc);
+
+        case 21:
+            return vcjson_value_create_from_true(value, ctx->alloc);
+
+        /* both null and undefined become null. */
+        case 22:
+        case 23:
+            return vcjson_value_create_from_null(value, ctx->alloc);
+
+        case 25:
+        case 26:
+        case 27:
+            retval = vcjson_parse_cbor_number(&number, 7, info, argument);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            return vcjson_value_create_number(value, ctx->alloc, number);
+
+        /* a break is only valid within an indefinite-length item. */
+        case VCJSON_PARSE_CBOR_INDEFINITE:
+            return ERROR_VCJSON_CBOR_MALFORMED;
+
+        default:
+            return ERROR_VCJSON_CBOR_UNSUPPORTED;
+    }
+}
+
+/**
+ * \brief Convert an integer or floating point item to a number.
+ *
+ * \param number        Pointer to receive the number on success.
+ * \param major         The major type of this item.
+ * \param info          The additional information of this item.
+ * \param argument      The argument of this item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_CBOR_UNSUPPORTED if this number is not finite.
+ */
+static status vcjson_parse_cbor_number(
+    double* number, uint8_t major, uint8_t info, uint64_t argument)
+{
+    uint32_t single_bits;
+    float single;
+
+    if (0 == major)
+    {
+        *number = (double)argument;
+    }
+    else if (1 == major)
+    {
+        /* -1 - argument, computed without losing an exact result. */
+        *number =
+            (UINT64_MAX == argument)
+                ? -18446744073709551616.0
+                : -(double)(argument + 1);
+    }
+    else if (25 == info)
+    {
+        *number = vcjson_parse_cbor_half((uint16_t)argument);
+    }
+    else if (26 == info)
+    {
+        single_bits = (uint32_t)argument;
+        memcpy(&single, &single_bits, sizeof(single));
+        *number = single;
+    }
+    else
+    {
+        memcpy(number, &argument, sizeof(*number));
+    }
+
+    /* JSON has no form for infinities or NaN. */
+    if (!isfinite(*number))
+    {
+        return ERROR_VCJSON_CBOR_UNSUPPORTED;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Convert half precision bits to a double.
+ *
+ * \param half          The half precision bits.
+ *
+ * \returns the number held by these bits.
+ */
+static double vcjson_parse_cbor_half(uint16_t half)
+{
+    int exponent = (half >> 10) & 0x1f;
+    double mantissa = half & 0x3ff;
+    double result;
+
+    if (0 == exponent)
+    {
+        result = ldexp(mantissa, -24);
+    }
+    else if (31 == exponent)
+    {
+        result = (0.0 == mantissa) ? INFINITY : NAN;
+    }
+    else
+    {
+        result = ldexp(mantissa + 1024, exponent - 25);
+    }
+
+    return (half & 0x8000) ? -result : result;
+}
+
+/**
+ * \brief Determine whether the next data item is an untagged number.
+ *
+ * \param ctx           The parser context for this operation.
+ *
+ * \returns true if the next item is an integer or floating point number.
+ */
+static bool vcjson_parse_cbor_next_is_number(
+    const vcjson_parse_cbor_context* ctx)
+{
+    uint8_t initial;
+
+    if (ctx->offset >= ctx->size)
+    {
+        return false;
+    }
+
+    initial = ctx->input[ctx->offset];
+
+    return
+        (initial >> 5) <= 1
+     || 0xf9 == initial || 0xfa == initial || 0xfb == initial;
+}
+
+/**
+ * \brief Create a string from a text string item.
+ *
+ * When \p value is not NULL, the string is created along with a value holding
+ * it in a single allocation, and \p string is ignored.
+ *
+ * \param string        Pointer to the string pointer to hold the JSON string on
+ *                      success.
+ * \param value         Optional pointer to the value pointer to hold a JSON
+ *                      string value on success.
+ * \param ctx           The parser context for this operation.
+ * \param info          The additional information of this item.
+ * \param argument      The argument of this item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_parse_cbor_string(
+    vcjson_string** string, vcjson_value** value,
+    vcjson_parse_cbor_context* ctx, uint8_t info, uint64_t argument)
+{
+    status retval, release_retval;
+    const char* text;
+    size_t length;
+    char* buffer;
+
+    /* find the text, joining its chunks if it is indefinite. */
+    retval =
+        vcjson_parse_cbor_text(&text, &length, &buffer, ctx, info, argument);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* create a string or string value from this text. */
+    if (NULL != value)
+    {
+        retval =
+            vcjson_value_create_string_from_raw(
+                value, ctx->alloc, text, length);
+        if (STATUS_SUCCESS == retval)
+        {
+            ((vcjson_string*)(*value)->value)->sensitive = ctx->sensitive;
+        }
+    }
+    else
+    {
+        retval =
+            vcjson_string_create_from_raw(string, ctx->alloc, text, length);
+        if (STATUS_SUCCESS == retval)
+        {
+            (*string)->sensitive = ctx->sensitive;
+        }
+    }
+
+    /* only a sensitive string is wiped from the working buffer. */
+    if (NULL != buffer)
+    {
+        if (ctx->sensitive)
+        {
+            memset(buffer, 0, length);
+        }
+
+        release_retval = allocator_reclaim(ctx->alloc, buffer);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Find the text of a text string item.
+ *
+ * A definite-length string is read in place. The chunks of an
+ * indefinite-length string are joined into a working buffer.
+ *
+ * \param text          Pointer to receive the text.
+ * \param length        Pointer to receive the length of the text.
+ * \param buffer        Pointer to receive the working buffer, which the caller
+ *                      must reclaim, or NULL if none was needed.
+ * \param ctx           The parser context for this operation.
+ * \param info          The additional information of this item.
+ * \param argument      The argument of this item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_parse_cbor_text(
+    const char** text, size_t* length, char** buffer,
+    vcjson_parse_cbor_context* ctx, uint8_t info, uint64_t argument)
+{
+    status retval;
+    size_t begin, end, total = 0;
+    uint8_t major, chunk_info;
+    uint64_t chunk;
+
+    *buffer = NULL;
+
+    /* a definite-length string is read in place. */
+    if (VCJSON_PARSE_CBOR_INDEFINITE != info)
+    {
+        if (argument > ctx->size - ctx->offset)
+        {
+            return ERROR_VCJSON_CBOR_TRUNCATED;
+        }
+
+        *text = (const char*)ctx->input + ctx->offset;
+        *length = (size_t)argument;
+        ctx->offset += (size_t)argument;
+
+        return STATUS_SUCCESS;
+    }
+
+    /* measure the chunks, which must be definite-length text strings. */
+    begin = ctx->offset;
+    for (;;)
+    {
+        if (ctx->offset >= ctx->size)
+        {
+            return ERROR_VCJSON_CBOR_TRUNCATED;
+        }
+
+        if (VCJSON_PARSE_CBOR_BREAK == ctx->input[ctx->offset])
+        {
+            ++ctx->offset;
+            break;
+        }
+
+        retval = vcjson_parse_cbor_head(&major, &chunk_info, &chunk, ctx);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        if (3 != major || VCJSON_PARSE_CBOR_INDEFINITE == chunk_info)
+        {
+            return ERROR_VCJSON_CBOR_MALFORMED;
+        }
+
+        if (chunk > ctx->size - ctx->offset)
+        {
+            return ERROR_VCJSON_CBOR_TRUNCATED;
+        }
+
+        total += (size_t)chunk;
+        ctx->offset += (size_t)chunk;
+    }
+    end = ctx->offset;
+
+    /* create a working buffer. */
+    retval = allocator_allocate(ctx->alloc, (void**)buffer, total + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* join the chunks, whose heads have already been checked. */
+    ctx->offset = begin;
+    total = 0;
+    while (ctx->offset < end - 1)
+    {
+        (void)vcjson_parse_cbor_head(&major, &chunk_info, &chunk, ctx);
+        memcpy(*buffer + total, ctx->input + ctx->offset, (size_t)chunk);
+        total += (size_t)chunk;
+        ctx->offset += (size_t)chunk;
+    }
+    ctx->offset = end;
+
+    *text = *buffer;
+    *length = total;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Create an array value from an array item.
+ *
+ * The leading numbers of a definite-length array are read into a working
+ * buffer. If every element is a number, a packed array is created from it.
+ * Otherwise, they are boxed and the remaining elements are read as values.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param ctx           The parser context for this operation.
+ * \param info          The additional information of this item.
+ * \param argument      The argument of this item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_parse_cbor_array(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx, uint8_t info,
+    uint64_t argument)
+{
+    status retval, release_retval;
+    bool indefinite = (VCJSON_PARSE_CBOR_INDEFINITE == info);
+    vcjson_array* arr;
+    vcjson_value* element;
+    double* numbers = NULL;
+    size_t count = 0, elements = 0;
+    size_t begin;
+    uint8_t major, number_info;
+    uint64_t number_argument;
+
+    /* each element takes at least one byte. */
+    if (!indefinite && argument > ctx->size - ctx->offset)
+    {
+        return ERROR_VCJSON_CBOR_TRUNCATED;
+    }
+
+    /* read the leading numbers of a definite-length array. */
+    if (!indefinite && argument > 0)
+    {
+        retval =
+            allocator_allocate(
+                ctx->alloc, (void**)&numbers, argument * sizeof(double));
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        while (count < argument && vcjson_parse_cbor_next_is_number(ctx))
+        {
+            begin = ctx->offset;
+            retval =
+                vcjson_parse_cbor_head(
+                    &major, &number_info, &number_argument, ctx);
+            if (STATUS_SUCCESS == retval)
+            {
+                retval =
+                    vcjson_parse_cbor_number(
+                        &numbers[count], major, number_info, number_argument);
+            }
+            if (STATUS_SUCCESS != retval)
+            {
+                retval = vcjson_parse_cbor_fail(ctx, begin, retval);
+                goto cleanup_numbers;
+            }
+
+            ++count;
+        }
+
+        /* an array holding only numbers is packed. */
+        if (count == argument)
+        {
+            retval =
+                vcjson_array_create_from_doubles(
+                    &arr, ctx->alloc, numbers, count);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_numbers;
+            }
+
+            goto create_value;
+        }
+    }
+
+    /* otherwise, the elements are boxed. */
+    retval = vcjson_array_create(&arr, ctx->alloc, 0);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_numbers;
+    }
+
+    if (!indefinite)
+    {
+        retval = vcjson_array_reserve(arr, argument);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_arr;
+        }
+    }
+
+    /* box the leading numbers. */
+    for (; elements < count; ++elements)
+    {
+        retval =
+            vcjson_value_create_number(
+                &element, ctx->alloc, numbers[elements]);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_arr;
+        }
+
+        retval = vcjson_array_append(arr, element);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_element;
+        }
+    }
+
+    /* read the remaining elements. */
+    for (;;)
+    {
+        if (indefinite)
+        {
+            if (ctx->offset >= ctx->size)
+            {
+                retval = ERROR_VCJSON_CBOR_TRUNCATED;
+                goto cleanup_arr;
+            }
+
+            if (VCJSON_PARSE_CBOR_BREAK == ctx->input[ctx->offset])
+            {
+                ++ctx->offset;
+                break;
+            }
+        }
+        else if (elements == argument)
+        {
+            break;
+        }
+
+        retval = vcjson_parse_cbor_item(&element, ctx);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_arr;
+        }
+
+        retval = vcjson_array_append(arr, element);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_element;
+        }
+
+        ++elements;
+    }
+
+create_value:
+    /* convert the array to a value. */
+    retval = vcjson_value_create_from_array(value, ctx->alloc, arr);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_arr;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_numbers;
+
+cleanup_element:
+    release_retval = resource_release(vcjson_value_resource_handle(element));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_arr:
+    release_retval = resource_release(vcjson_array_resource_handle(arr));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_numbers:
+    if (NULL != numbers)
+    {
+        /* only the numbers of a sensitive document are wiped. */
+        if (ctx->sensitive)
+        {
+            memset(numbers, 0, count * sizeof(double));
+        }
+
+        release_retval = allocator_reclaim(ctx->alloc, numbers);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Create an object value from a map item.
+ *
+ * The members are collected and the object is built from them at once, as
+ * if by \ref vcjson_object_create_from_members.
+ *
+ * \param value         Pointer to the value pointer to hold the JSON value on
+ *                      success.
+ * \param ctx           The parser context for this operation.
+ * \param info          The additional information of this item.
+ * \param argument      The argument of this item.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_parse_cbor_map(
+    vcjson_value** value, vcjson_parse_cbor_context* ctx, uint8_t info,
+    uint64_t argument)
+{
+    status retval, release_retval;
+    bool indefinite = (VCJSON_PARSE_CBOR_INDEFINITE == info);
+    vcjson_string** keys;
+    vcjson_value** values;
+    vcjson_object* obj;
+    size_t count = 0, capacity;
+    size_t begin;
+    uint8_t major, key_info;
+    uint64_t key_argument;
+
+    /* each member takes at least two bytes. */
+    if (!indefinite && argument > (ctx->size - ctx->offset) / 2)
+    {
+        return ERROR_VCJSON_CBOR_TRUNCATED;
+    }
+
+    /* create the member buffers. */
+    capacity =
+        indefinite
+            ? VCJSON_PARSE_CBOR_MAP_CAPACITY
+            : (argument > 0 ? (size_t)argument : 1);
+    retval =
+        allocator_allocate(
+            ctx->alloc, (void**)&keys, capacity * sizeof(vcjson_string*));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        allocator_allocate(
+            ctx->alloc, (void**)&values, capacity * sizeof(vcjson_value*));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_keys;
+    }
+
+    /* read the members. */
+    for (;;)
+    {
+        if (indefinite)
+        {
+            if (ctx->offset >= ctx->size)
+            {
+                retval = ERROR_VCJSON_CBOR_TRUNCATED;
+                goto cleanup_members;
+            }
+
+            if (VCJSON_PARSE_CBOR_BREAK == ctx->input[ctx->offset])
+            {
+                ++ctx->offset;
+                break;
+            }
+
+            /* grow the member buffers. */
+            if (count == capacity)
+            {
+                capacity *= 2;
+                retval =
+                    allocator_reallocate(
+                        ctx->alloc, (void**)&keys,
+                        capacity * sizeof(vcjson_string*));
+                if (STATUS_SUCCESS != retval)
+                {
+                    goto cleanup_members;
+                }
+
+                retval =
+                    allocator_reallocate(
+                        ctx->alloc, (void**)&values,
+                        capacity * sizeof(vcjson_value*));
+                if (STATUS_SUCCESS != retval)
+                {
+                    goto cleanup_members;
+                }
+            }
+        }
+        else if (count == argument)
+        {
+            break;
+        }
+
+        /* read the key, which must be a text string. */
+        begin = ctx->offset;
+        retval = vcjson_parse_cbor_head(&major, &key_info, &key_argument, ctx);
+        if (STATUS_SUCCESS == retval && 3 != major)
+        {
+            retval = ERROR_VCJSON_CBOR_UNSUPPORTED;
+        }
+        if (STATUS_SUCCESS == retval)
+        {
+            retval =
+                vcjson_parse_cbor_string(
+                    &keys[count], NULL, ctx, key_info, key_argument);
+        }
+        if (STATUS_SUCCESS != retval)
+        {
+            retval = vcjson_parse_cbor_fail(ctx, begin, retval);
+            goto cleanup_members;
+        }
+
+        /* read the value. */
+        retval = vcjson_parse_cbor_item(&values[count], ctx);
+        if (STATUS_SUCCESS != retval)
+        {
+            release_retval =
+                resource_release(vcjson_string_resource_handle(keys[count]));
+            if (STATUS_SUCCESS != release_retval)
+            {
+                retval = release_retval;
+            }
+
+            goto cleanup_members;
+        }
+
+        ++count;
+    }
+
+    /* create the object from these members. */
+    retval =
+        vcjson_object_create_from_members(
+            &obj, ctx->alloc, keys, values, count);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_members;
+    }
+
+    /* the object now owns its members. */
+    count = 0;
+
+    /* keep the order of the input if requested. */
+    if (ctx->flags & VCJSON_PARSE_FLAG_INSERTION_ORDER)
+    {
+        retval = vcjson_object_set_insertion_order(obj, true);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_obj;
+        }
+    }
+
+    /* convert the object to a value. */
+    retval = vcjson_value_create_from_object(value, ctx->alloc, obj);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_obj;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_values;
+
+cleanup_obj:
+    release_retval = resource_release(vcjson_object_resource_handle(obj));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_members:
+    for (size_t i = 0; i < count; ++i)
+    {
+        release_retval =
+            resource_release(vcjson_string_resource_handle(keys[i]));
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+
+        release_retval =
+            resource_release(vcjson_value_resource_handle(values[i]));
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+cleanup_values:
+    release_retval = allocator_reclaim(ctx->alloc, values);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_keys:
+    release_retval = allocator_reclaim(ctx->alloc, keys);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Record the offset of a failed data item, unless an item within it
+ * has already been recorded.
+ *
+ * \param ctx           The parser context for this operation.
+ * \param offset        The offset of the failed item.
+ * \param retval        The status code of the failure.
+ *
+ * \returns \p retval.
+ */
+static status vcjson_parse_cbor_fail(
+    vcjson_parse_cbor_context* ctx, size_t offset, status retval)
+{
+    if (!ctx->failed)
+    {
+        *ctx->error_offset = offset;
+        ctx->failed = true;
+    }
+
+    return retval;
+}
@@ -0,0 +1,33 @@
+/**
+ * \file vcjson_pool_attach.c
+ *
+ * \brief Attach a pool to the calling thread.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* the pool attached to the calling thread. */
+_Thread_local vcjson_pool* vcjson_pool_thread_attached = NULL;
+
+/**
+ * \brief Attach the given \ref vcjson_pool to the calling thread.
+ *
+ * Nodes that this thread creates with the pool's allocator are then taken
+ * from this pool, including the nodes created by \ref vcjson_parse.
+ *
+ * \param pool          The pool to attach, or NULL to detach the current pool.
+ *
+ * \returns the pool that was previously attached to this thread, or NULL.
+ */
+vcjson_pool* vcjson_pool_attach(vcjson_pool* pool)
+{
+    vcjson_pool* prev = vcjson_pool_thread_attached;
+
+    vcjson_pool_thread_attached = pool;
+
+    return prev;
+}
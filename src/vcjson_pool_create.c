@@ -0,0 +1,73 @@
+/**
+ * \file vcjson_pool_create.c
+ *
+ * \brief Create a pool of small node allocations.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcjson_pool instance using the given allocator.
+ *
+ * A pool holds free lists of small, fixed-size nodes, carved from slabs of
+ * \ref VCJSON_POOL_SLAB_SIZE bytes that are allocated from \p alloc. While a
+ * pool is attached to a thread with \ref vcjson_pool_attach, values, numbers,
+ * short strings, object elements, and object iterators that this thread
+ * creates with \p alloc are taken from the pool, and are returned to it when
+ * released.
+ *
+ * \note On success, this function creates a \ref vcjson_pool instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. Every node taken from the pool must be released before the pool is;
+ * until then, releasing the pool fails with \ref ERROR_VCJSON_POOL_IN_USE and
+ * leaves it intact. Nodes are only taken from a pool by the thread it is
+ * attached to, so it should be attached to one thread at a time. Its nodes may
+ * be released on any thread; those released elsewhere are handed back to the
+ * attached thread through a lock-free list.
+ *
+ * \param pool          Pointer to the pool pointer to hold this pool.
+ * \param alloc         The allocator to use for this pool's slabs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_create(vcjson_pool** pool, RCPR_SYM(allocator)* alloc)
+{
+    status retval;
+    vcjson_pool* tmp;
+
+    /* allocate memory for this pool. */
+    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory; slabs are allocated on first use. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcjson_pool_resource_release);
+
+    /* set initial values. */
+    tmp->alloc = alloc;
+
+    /* success. */
+    *pool = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
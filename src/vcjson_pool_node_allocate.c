@@ -0,0 +1,115 @@
+/**
+ * \file vcjson_pool_node_allocate.c
+ *
+ * \brief Allocate a node from the calling thread's pool.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/* the first bytes of each slab link it to the next slab. */
+#define VCJSON_POOL_SLAB_HEADER_SIZE 16
+
+/* forward decls. */
+static status vcjson_pool_refill(vcjson_pool* pool, size_t size_class);
+
+/**
+ * \brief Allocate a node, taking it from the calling thread's pool if one is
+ * attached for the given allocator.
+ *
+ * \param pool          Pointer to receive the pool that the node was taken
+ *                      from, or NULL if it was allocated from \p alloc.
+ * \param alloc         The allocator to use for this operation.
+ * \param node          Pointer to receive the node.
+ * \param size          The size of the node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_node_allocate(
+    vcjson_pool** pool, RCPR_SYM(allocator)* alloc, void** node, size_t size)
+{
+    status retval;
+    vcjson_pool* attached = vcjson_pool_thread_attached;
+    size_t size_class = (size - 1) / VCJSON_POOL_CLASS_SIZE;
+
+    /* without a matching pool, or for a large node, use the allocator. */
+    if (NULL == attached || attached->alloc != alloc
+     || 0 == size || size_class >= VCJSON_POOL_CLASSES)
+    {
+        *pool = NULL;
+        return allocator_allocate(alloc, node, size);
+    }
+
+    /* take over the nodes that other threads have released, if any. */
+    if (NULL == attached->free[size_class])
+    {
+        attached->free[size_class] =
+            __atomic_exchange_n(
+                &attached->remote[size_class], NULL, __ATOMIC_ACQUIRE);
+    }
+
+    /* carve a new slab if this size class is exhausted. */
+    if (NULL == attached->free[size_class])
+    {
+        retval = vcjson_pool_refill(attached, size_class);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* pop a node from the free list. */
+    *node = attached->free[size_class];
+    attached->free[size_class] = *(void**)*node;
+    __atomic_fetch_add(&attached->live, 1, __ATOMIC_RELAXED);
+    *pool = attached;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Carve a new slab into free nodes of the given size class.
+ *
+ * \param pool          The pool to refill.
+ * \param size_class    The size class to refill.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_pool_refill(vcjson_pool* pool, size_t size_class)
+{
+    status retval;
+    char* slab;
+    size_t node_size = (size_class + 1) * VCJSON_POOL_CLASS_SIZE;
+
+    /* allocate a slab. */
+    retval =
+        allocator_allocate(pool->alloc, (void**)&slab, VCJSON_POOL_SLAB_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* link it to this pool's slabs. */
+    *(void**)slab = pool->slabs;
+    pool->slabs = slab;
+
+    /* push each node in this slab onto the free list. */
+    for (size_t offset = VCJSON_POOL_SLAB_HEADER_SIZE;
+         offset + node_size <= VCJSON_POOL_SLAB_SIZE; offset += node_size)
+    {
+        *(void**)(slab + offset) = pool->free[size_class];
+        pool->free[size_class] = slab + offset;
+    }
+
+    return STATUS_SUCCESS;
+}
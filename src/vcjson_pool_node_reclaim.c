@@ -0,0 +1,70 @@
+/**
+ * \file vcjson_pool_node_reclaim.c
+ *
+ * \brief Return a node to the pool that it was taken from.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Reclaim a node allocated with \ref vcjson_pool_node_allocate.
+ *
+ * A node released on the thread that its pool is attached to goes straight
+ * back onto that thread's free list. A node released on any other thread is
+ * pushed onto the pool's remote list for its size class instead, which the
+ * attached thread takes over when its own free list runs out.
+ *
+ * \param pool          The pool that the node was taken from, or NULL.
+ * \param alloc         The allocator that the node was allocated from.
+ * \param node          The node to reclaim.
+ * \param size          The size of the node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_node_reclaim(
+    vcjson_pool* pool, RCPR_SYM(allocator)* alloc, void* node, size_t size)
+{
+    size_t size_class;
+    void* head;
+
+    /* a node that was not taken from a pool goes back to its allocator. */
+    if (NULL == pool)
+    {
+        return allocator_reclaim(alloc, node);
+    }
+
+    size_class = (size - 1) / VCJSON_POOL_CLASS_SIZE;
+
+    if (vcjson_pool_thread_attached == pool)
+    {
+        /* the owning thread pushes onto its own free list. */
+        *(void**)node = pool->free[size_class];
+        pool->free[size_class] = node;
+    }
+    else
+    {
+        /* any other thread pushes onto the remote list. */
+        head = __atomic_load_n(&pool->remote[size_class], __ATOMIC_RELAXED);
+        do
+        {
+            *(void**)node = head;
+        } while (
+            !__atomic_compare_exchange_n(
+                &pool->remote[size_class], &head, node, true,
+                __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+
+    /* the pool may only be released once every node is back. */
+    __atomic_fetch_sub(&pool->live, 1, __ATOMIC_RELEASE);
+
+    return STATUS_SUCCESS;
+}
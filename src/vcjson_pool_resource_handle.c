@@ -0,0 +1,23 @@
+/**
+ * \file vcjson_pool_resource_handle.c
+ *
+ * \brief Return a resource handle for a pool resource.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the resource handle for the given \ref vcjson_pool instance.
+ *
+ * \param pool          The instance for this accessor.
+ *
+ * \returns the resource handle for this instance.
+ */
+RCPR_SYM(resource)* vcjson_pool_resource_handle(vcjson_pool* pool)
+{
+    return &pool->hdr;
+}
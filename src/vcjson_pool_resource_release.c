@@ -0,0 +1,77 @@
+/**
+ * \file vcjson_pool_resource_release.c
+ *
+ * \brief Release a pool of small node allocations.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Release a \ref vcjson_pool resource.
+ *
+ * \note The pool is left intact if any node taken from it is still live, since
+ * its slabs still hold those nodes.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_POOL_IN_USE if a node taken from this pool has not been
+ *        released.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_pool_resource_release(RCPR_SYM(resource)* r)
+{
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    vcjson_pool* pool = (vcjson_pool*)r;
+    void* slab;
+
+    /* cache allocator. */
+    allocator* alloc = pool->alloc;
+
+    /* releasing the slabs would free the nodes still taken from them. */
+    if (0 != __atomic_load_n(&pool->live, __ATOMIC_ACQUIRE))
+    {
+        return ERROR_VCJSON_POOL_IN_USE;
+    }
+
+    /* a released pool can no longer be attached to this thread. */
+    if (vcjson_pool_thread_attached == pool)
+    {
+        vcjson_pool_thread_attached = NULL;
+    }
+
+    /* reclaim every slab. */
+    while (NULL != pool->slabs)
+    {
+        slab = pool->slabs;
+        pool->slabs = *(void**)slab;
+
+        reclaim_retval = allocator_reclaim(alloc, slab);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    /* clear structure. */
+    memset(pool, 0, sizeof(*pool));
+
+    /* reclaim memory. */
+    reclaim_retval = allocator_reclaim(alloc, pool);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
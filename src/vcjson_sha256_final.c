@@ -0,0 +1,55 @@
+/**
+ * \file vcjson_sha256_final.c
+ *
+ * \brief Finish a SHA-256 digest.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Finish a SHA-256 digest.
+ *
+ * \note The context is cleared by this operation.
+ *
+ * \param ctx           The context for this digest.
+ * \param digest        Buffer to receive the \ref VCJSON_SHA256_DIGEST_SIZE
+ *                      byte digest.
+ */
+void vcjson_sha256_final(vcjson_sha256_context* ctx, uint8_t* digest)
+{
+    const uint8_t pad[64] = { 0x80 };
+    uint8_t length[8];
+    uint64_t bits = ctx->length * 8;
+    size_t pad_size;
+
+    /* encode the message length in bits as a big-endian value. */
+    for (int i = 0; i < 8; ++i)
+    {
+        length[i] = (uint8_t)(bits >> (56 - i * 8));
+    }
+
+    /* pad so that the length ends on a block boundary. */
+    pad_size =
+        (ctx->block_size < 56)
+            ? 56 - ctx->block_size
+            : 120 - ctx->block_size;
+    vcjson_sha256_update(ctx, pad, pad_size);
+    vcjson_sha256_update(ctx, length, sizeof(length));
+
+    /* write the digest as big-endian words. */
+    for (int i = 0; i < 8; ++i)
+    {
+        digest[i * 4] = (uint8_t)(ctx->state[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)(ctx->state[i]);
+    }
+
+    /* clear the context. */
+    memset(ctx, 0, sizeof(*ctx));
+}
@@ -0,0 +1,33 @@
+/**
+ * \file vcjson_sha256_init.c
+ *
+ * \brief Initialize a SHA-256 context.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Initialize a SHA-256 context.
+ *
+ * \param ctx           The context to initialize.
+ */
+void vcjson_sha256_init(vcjson_sha256_context* ctx)
+{
+    /* clear the context. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* set the initial hash value from FIPS 180-4. */
+    ctx->state[0] = 0x6a09e667;
+    ctx->state[1] = 0xbb67ae85;
+    ctx->state[2] = 0x3c6ef372;
+    ctx->state[3] = 0xa54ff53a;
+    ctx->state[4] = 0x510e527f;
+    ctx->state[5] = 0x9b05688c;
+    ctx->state[6] = 0x1f83d9ab;
+    ctx->state[7] = 0x5be0cd19;
+}
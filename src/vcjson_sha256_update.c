@@ -0,0 +1,166 @@
+/**
+ * \file vcjson_sha256_update.c
+ *
+ * \brief Add data to a SHA-256 digest.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static void vcjson_sha256_compress(
+    vcjson_sha256_context* ctx, const uint8_t* block);
+
+/* round constants from FIPS 180-4. */
+static const uint32_t vcjson_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define VCJSON_SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+ * \brief Add data to a SHA-256 digest.
+ *
+ * \param ctx           The context for this digest.
+ * \param data          The data to add.
+ * \param size          The size of this data.
+ */
+void vcjson_sha256_update(
+    vcjson_sha256_context* ctx, const void* data, size_t size)
+{
+    const uint8_t* in = (const uint8_t*)data;
+    size_t copy_size;
+
+    ctx->length += size;
+
+    /* fill a partial block first. */
+    if (ctx->block_size > 0)
+    {
+        copy_size = sizeof(ctx->block) - ctx->block_size;
+        if (copy_size > size)
+        {
+            copy_size = size;
+        }
+
+        memcpy(ctx->block + ctx->block_size, in, copy_size);
+        ctx->block_size += copy_size;
+        in += copy_size;
+        size -= copy_size;
+
+        if (ctx->block_size < sizeof(ctx->block))
+        {
+            return;
+        }
+
+        vcjson_sha256_compress(ctx, ctx->block);
+        ctx->block_size = 0;
+    }
+
+    /* compress whole blocks directly from the input. */
+    while (size >= sizeof(ctx->block))
+    {
+        vcjson_sha256_compress(ctx, in);
+        in += sizeof(ctx->block);
+        size -= sizeof(ctx->block);
+    }
+
+    /* save the remainder. */
+    memcpy(ctx->block, in, size);
+    ctx->block_size = size;
+}
+
+/**
+ * \brief Compress a single 64 byte block into the hash state.
+ *
+ * \param ctx           The context for this digest.
+ * \param block         The block to compress.
+ */
+static void vcjson_sha256_compress(
+    vcjson_sha256_context* ctx, const uint8_t* block)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h, s0, s1, t1, t2;
+
+    /* prepare the message schedule. */
+    for (int i = 0; i < 16; ++i)
+    {
+        w[i] =
+            ((uint32_t)block[i * 4] << 24)
+          | ((uint32_t)block[i * 4 + 1] << 16)
+          | ((uint32_t)block[i * 4 + 2] << 8)
+          | ((uint32_t)block[i * 4 + 3]);
+    }
+
+    for (int i = 16; i < 64; ++i)
+    {
+        s0 =
+            VCJSON_SHA256_ROTR(w[i - 15], 7) ^ VCJSON_SHA256_ROTR(w[i - 15], 18)
+          ^ (w[i - 15] >> 3);
+        s1 =
+            VCJSON_SHA256_ROTR(w[i - 2], 17) ^ VCJSON_SHA256_ROTR(w[i - 2], 19)
+          ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = ctx->state[0];
+    b = ctx->state[1];
+    c = ctx->state[2];
+    d = ctx->state[3];
+    e = ctx->state[4];
+    f = ctx->state[5];
+    g = ctx->state[6];
+    h = ctx->state[7];
+
+    /* run the rounds. */
+    for (int i = 0; i < 64; ++i)
+    {
+        s1 =
+            VCJSON_SHA256_ROTR(e, 6) ^ VCJSON_SHA256_ROTR(e, 11)
+          ^ VCJSON_SHA256_ROTR(e, 25);
+        t1 = h + s1 + ((e & f) ^ (~e & g)) + vcjson_sha256_k[i] + w[i];
+        s0 =
+            VCJSON_SHA256_ROTR(a, 2) ^ VCJSON_SHA256_ROTR(a, 13)
+          ^ VCJSON_SHA256_ROTR(a, 22);
+        t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    ctx->state[0] += a;
+    ctx->state[1] += b;
+    ctx->state[2] += c;
+    ctx->state[3] += d;
+    ctx->state[4] += e;
+    ctx->state[5] += f;
+    ctx->state[6] += g;
+    ctx->state[7] += h;
+
+    /* clear the message schedule. */
+    memset(w, 0, sizeof(w));
+}
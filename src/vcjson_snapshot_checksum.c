@@ -0,0 +1,64 @@
+/**
+ * \file vcjson_snapshot_checksum.c
+ *
+ * \brief Compute the checksum of snapshot data.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+#define VCJSON_SNAPSHOT_CHECKSUM_PRIME 0xff51afd7ed558ccdULL
+
+/**
+ * \brief Compute the checksum of snapshot data.
+ *
+ * The data is read a word at a time into four independent lanes, so that a
+ * large tape is checked at close to memory speed. This detects corruption and
+ * truncation; it is not a cryptographic digest.
+ *
+ * \param data          The data to checksum.
+ * \param size          The size of the data, in bytes.
+ *
+ * \returns the 64-bit checksum of this data.
+ */
+uint64_t vcjson_snapshot_checksum(const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint64_t lanes[4] = {
+        0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL,
+        0x94d049bb133111ebULL, 0xc4ceb9fe1a85ec53ULL };
+    uint64_t word, hash;
+    size_t offset = 0;
+
+    /* mix each 32 byte block into the lanes. */
+    for (; offset + 32 <= size; offset += 32)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            memcpy(&word, bytes + offset + 8 * i, sizeof(word));
+            lanes[i] = (lanes[i] ^ word) * VCJSON_SNAPSHOT_CHECKSUM_PRIME;
+            lanes[i] ^= lanes[i] >> 32;
+        }
+    }
+
+    /* combine the lanes with the size. */
+    hash = size;
+    for (int i = 0; i < 4; ++i)
+    {
+        hash = (hash ^ lanes[i]) * VCJSON_SNAPSHOT_CHECKSUM_PRIME;
+        hash ^= hash >> 29;
+    }
+
+    /* mix in the remaining bytes. */
+    for (; offset < size; ++offset)
+    {
+        hash = (hash ^ bytes[offset]) * VCJSON_SNAPSHOT_CHECKSUM_PRIME;
+        hash ^= hash >> 32;
+    }
+
+    return hash;
+}
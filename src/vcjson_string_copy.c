@@ -14,6 +14,8 @@
 /**
  * \brief Make a deep copy of the given \ref vcjson_string instance.
  *
+ * The copy is sensitive if the original is.
+ *
  * \note On success, this function creates a \ref vcjson_string instance. This
  * is a resource that is owned by the caller. When no longer needed, this
  * resource must be released by calling \ref resource_release on its resource
@@ -32,6 +34,17 @@ vcjson_string_copy(
     vcjson_string** string, RCPR_SYM(allocator)* alloc,
     const vcjson_string* orig)
 {
-    return
+    status retval;
+
+    retval =
         vcjson_string_create_from_raw(string, alloc, orig->value, orig->length);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the copy is as sensitive as the original. */
+    (*string)->sensitive = orig->sensitive;
+
+    return STATUS_SUCCESS;
 }
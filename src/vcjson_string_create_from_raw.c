@@ -39,11 +39,14 @@ vcjson_string_create_from_raw(
     vcjson_string** string, RCPR_SYM(allocator)* alloc, const char* value,
     size_t size)
 {
-    status retval, release_retval;
+    status retval;
     vcjson_string* tmp;
+    vcjson_pool* pool;
 
-    /* allocate memory for the string instance. */
-    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    /* allocate memory for the string instance and its ASCIIZ characters. */
+    retval =
+        vcjson_pool_node_allocate(
+            &pool, alloc, (void**)&tmp, sizeof(*tmp) + size + 1);
     if (STATUS_SUCCESS != retval)
     {
         goto done;
@@ -51,36 +54,29 @@ vcjson_string_create_from_raw(
 
     /* clear instance. */
     memset(tmp, 0, sizeof(*tmp));
+    tmp->pool = pool;
 
     /* initialize resource. */
     resource_init(&tmp->hdr, &vcjson_string_resource_release);
 
-    /* set initial values. */
+    /* set initial values; the characters follow the instance. */
     tmp->alloc = alloc;
+    tmp->value = (char*)(tmp + 1);
     tmp->length = size;
 
-    /* allocate memory for string. */
-    retval = allocator_allocate(alloc, (void**)&tmp->value, size);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_tmp;
-    }
-
-    /* copy string. */
+    /* copy string, keeping it ASCIIZ. */
     memcpy(tmp->value, value, size);
+    tmp->value[size] = 0;
+
+    /* precompute the hash, so object lookups never rescan this key. */
+    tmp->hash = vcjson_object_key_hash(tmp->value, size);
+    tmp->hashed = true;
 
     /* success. */
     *string = tmp;
     retval = STATUS_SUCCESS;
     goto done;
 
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
 done:
     return retval;
 }
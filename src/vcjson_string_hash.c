@@ -0,0 +1,32 @@
+/**
+ * \file vcjson_string_hash.c
+ *
+ * \brief Get the hash of a string.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Get the hash of a string, for use as an object key.
+ *
+ * \note Strings created from values carry a precomputed hash. Emitted strings
+ * do not, and are hashed on demand.
+ *
+ * \param str           The string to hash.
+ *
+ * \returns the hash of this string, as per \ref vcjson_object_key_hash.
+ */
+uint64_t vcjson_string_hash(const vcjson_string* str)
+{
+    if (str->hashed)
+    {
+        return str->hash;
+    }
+
+    return
+        vcjson_object_key_hash(str->value, str->length);
+}
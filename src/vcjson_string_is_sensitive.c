@@ -0,0 +1,23 @@
+/**
+ * \file vcjson_string_is_sensitive.c
+ *
+ * \brief Determine whether a \ref vcjson_string instance is sensitive.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Determine whether this \ref vcjson_string instance is sensitive.
+ *
+ * \param string        The string instance for this operation.
+ *
+ * \returns true if this string is sensitive, and false otherwise.
+ */
+bool vcjson_string_is_sensitive(const vcjson_string* string)
+{
+    return string->sensitive;
+}
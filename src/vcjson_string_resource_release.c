@@ -21,33 +21,23 @@ RCPR_IMPORT_allocator;
 status FN_DECL_MUST_CHECK
 vcjson_string_resource_release(RCPR_SYM(resource)* r)
 {
-    status string_reclaim_retval = STATUS_SUCCESS;
-    status reclaim_retval = STATUS_SUCCESS;
     vcjson_string* string = (vcjson_string*)r;
 
-    /* cache allocator. */
+    /* cache allocator, pool, and node size. */
     allocator* alloc = string->alloc;
+    vcjson_pool* pool = string->pool;
+    size_t size = sizeof(*string) + string->length + 1;
 
-    /* clear string value if set. */
-    if (NULL != string->value)
+    /* only sensitive characters are wiped. */
+    if (string->sensitive)
     {
         memset(string->value, 0, string->length);
-        string_reclaim_retval = allocator_reclaim(alloc, string->value);
     }
 
     /* clear string structure. */
     memset(string, 0, sizeof(*string));
 
-    /* reclaim string structure. */
-    reclaim_retval = allocator_reclaim(alloc, string);
-
-    /* decode status code. */
-    if (STATUS_SUCCESS != string_reclaim_retval)
-    {
-        return string_reclaim_retval;
-    }
-    else
-    {
-        return reclaim_retval;
-    }
+    /* reclaim the string structure along with its characters. */
+    return
+        vcjson_pool_node_reclaim(pool, alloc, string, size);
 }
@@ -0,0 +1,30 @@
+/**
+ * \file vcjson_string_set_sensitive.c
+ *
+ * \brief Mark whether a \ref vcjson_string instance is sensitive.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Mark whether this \ref vcjson_string instance is sensitive.
+ *
+ * The characters of a sensitive string are wiped before they are reclaimed,
+ * along with the parser and emitter buffers that held them. The characters of
+ * other strings are reclaimed without being wiped.
+ *
+ * \note A string that is already part of an object or array should be marked
+ * through its value with \ref vcjson_value_set_sensitive, so that emitted
+ * forms of its containers that are cached are marked as well.
+ *
+ * \param string        The string instance for this operation.
+ * \param sensitive     true if this string is sensitive.
+ */
+void vcjson_string_set_sensitive(vcjson_string* string, bool sensitive)
+{
+    string->sensitive = sensitive;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file vcjson_value_block_resource_release.c
+ *
+ * \brief Release a vcjson_value allocated along with its payload.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Release a \ref vcjson_value allocated in a single block with its
+ * number or string.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_block_resource_release(RCPR_SYM(resource)* r)
+{
+    vcjson_value* value = (vcjson_value*)r;
+    size_t size, wipe_size;
+
+    /* cache allocator and pool. */
+    allocator* alloc = value->alloc;
+    vcjson_pool* pool = value->pool;
+
+    /* compute the size of this block, and how much of it to clear. */
+    if (VCJSON_VALUE_TYPE_STRING == value->type)
+    {
+        vcjson_value_string_block* block = (vcjson_value_string_block*)value;
+        size = sizeof(*block) + block->string.length + 1;
+
+        /* only sensitive characters are wiped. */
+        wipe_size = block->string.sensitive ? size : sizeof(*block);
+    }
+    else
+    {
+        size = wipe_size = sizeof(vcjson_value_number_block);
+    }
+
+    /* clear the block. */
+    memset(value, 0, wipe_size);
+
+    /* reclaim memory. */
+    return
+        vcjson_pool_node_reclaim(pool, alloc, value, size);
+}
@@ -0,0 +1,44 @@
+/**
+ * \file vcjson_value_compact_resource_release.c
+ *
+ * \brief Release the root of a compact copy.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+
+/**
+ * \brief Release the root \ref vcjson_value of a compact copy, along with the
+ * block holding the copy.
+ *
+ * \param r             The resource to release.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_compact_resource_release(RCPR_SYM(resource)* r)
+{
+    vcjson_value_compact* compact = (vcjson_value_compact*)r;
+
+    /* cache allocator. */
+    allocator* alloc = compact->value.alloc;
+
+    /* wipe the whole block if it holds a sensitive string. */
+    if (compact->sensitive)
+    {
+        memset(compact, 0, compact->size);
+    }
+    /* otherwise, only clear the header. */
+    else
+    {
+        memset(compact, 0, sizeof(*compact));
+    }
+
+    /* reclaim the block. */
+    return
+        allocator_reclaim(alloc, compact);
+}
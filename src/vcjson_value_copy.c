@@ -15,21 +15,27 @@ RCPR_IMPORT_allocator;
 RCPR_IMPORT_resource;
 
 /* forward decls. */
-static status vcjson_value_copy_null(
-    vcjson_value** value, allocator* alloc);
-static status vcjson_value_copy_object(
-    vcjson_value** value, allocator* alloc, const vcjson_object* orig);
-static status vcjson_value_copy_array(
-    vcjson_value** value, allocator* alloc, const vcjson_array* orig);
-static status vcjson_value_copy_number(
-    vcjson_value** value, allocator* alloc, const vcjson_number* orig);
-static status vcjson_value_copy_string(
-    vcjson_value** value, allocator* alloc, const vcjson_string* orig);
-static status vcjson_value_copy_bool(
-    vcjson_value** value, allocator* alloc, const vcjson_bool* orig);
+static status vcjson_value_share_object(
+    vcjson_value** value, allocator* alloc, vcjson_object* shared);
+static status vcjson_value_share_array(
+    vcjson_value** value, allocator* alloc, vcjson_array* shared);
 
 /**
- * \brief Create a deep copy of the given \ref vcjson_value instance.
+ * \brief Create a copy of the given \ref vcjson_value instance.
+ *
+ * Objects and arrays are not copied. Instead, the copy shares them with the
+ * original, so copying takes constant time regardless of the size of the
+ * value. A shared object or array can be read through either value, but
+ * modifying it, or any container nested in it, fails with
+ * \ref ERROR_VCJSON_VALUE_SHARED. Fetching it with
+ * \ref vcjson_value_get_object_mut or \ref vcjson_value_get_array_mut gives
+ * that value its own copy of the container's top level. Each nested
+ * container on the path to a modified member must in turn be fetched with
+ * these functions before it is modified, so only that path is copied. Objects
+ * and arrays held in a compact copy made with \ref vcjson_value_copy_compact
+ * are read-only, so they are copied in full instead of shared. Containers are
+ * also copied in full when \p alloc is not the allocator that owns them, so
+ * that the copy never depends on the lifetime of another allocator.
  *
  * \note On success, this function creates a \ref vcjson_value instance. This
  * value instance is a resource that is owned by the caller. When no longer
@@ -48,220 +54,84 @@ status FN_DECL_MUST_CHECK
 vcjson_value_copy(
     vcjson_value** value, RCPR_SYM(allocator)* alloc, const vcjson_value* orig)
 {
+    vcjson_object* obj;
+    vcjson_array* arr;
+
     /* decode the value type. */
     switch (orig->type)
     {
-        /* copy a null value. */
-        case VCJSON_VALUE_TYPE_NULL:
-            return vcjson_value_copy_null(value, alloc);
-
-        /* copy an object value. */
+        /* share an object value. */
         case VCJSON_VALUE_TYPE_OBJECT:
-            return
-                vcjson_value_copy_object(
-                    value, alloc, (const vcjson_object*)orig->value);
-
-        /* copy an array value. */
+            obj = (vcjson_object*)orig->value;
+            if (!obj->compact && obj->alloc == alloc)
+            {
+                return vcjson_value_share_object(value, alloc, obj);
+            }
+            break;
+
+        /* share an array value. */
         case VCJSON_VALUE_TYPE_ARRAY:
-            return
-                vcjson_value_copy_array(
-                    value, alloc, (const vcjson_array*)orig->value);
-
-        /* copy a number value. */
-        case VCJSON_VALUE_TYPE_NUMBER:
-            return
-                vcjson_value_copy_number(
-                    value, alloc, (const vcjson_number*)orig->value);
+            arr = (vcjson_array*)orig->value;
+            if (!arr->compact && arr->alloc == alloc)
+            {
+                return vcjson_value_share_array(value, alloc, arr);
+            }
+            break;
 
-        /* copy a string value. */
-        case VCJSON_VALUE_TYPE_STRING:
-            return
-                vcjson_value_copy_string(
-                    value, alloc, (const vcjson_string*)orig->value);
-
-        /* copy a bool value. */
-        case VCJSON_VALUE_TYPE_BOOL:
-            return
-                vcjson_value_copy_bool(
-                    value, alloc, (const vcjson_bool*)orig->value);
-
-        /* an unknown value type was encountered... */
         default:
-            return ERROR_VCJSON_INVALID_GET;
-    }
-}
-
-/**
- * \brief Copy a null value.
- */
-static status vcjson_value_copy_null(
-    vcjson_value** value, allocator* alloc)
-{
-    return vcjson_value_create_from_null(value, alloc);
-}
-
-/**
- * \brief Copy an object value.
- */
-static status vcjson_value_copy_object(
-    vcjson_value** value, allocator* alloc, const vcjson_object* orig)
-{
-    status retval, release_retval;
-    vcjson_object* tmp;
-
-    /* copy the object. */
-    retval = vcjson_object_copy(&tmp, alloc, orig);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-    /* wrap this object in a new value. */
-    retval = vcjson_value_create_from_object(value, alloc, tmp);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_tmp;
-    }
-
-    /* success. */
-    goto done;
-
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
-}
-
-/**
- * \brief Copy an array value.
- */
-static status vcjson_value_copy_array(
-    vcjson_value** value, allocator* alloc, const vcjson_array* orig)
-{
-    status retval, release_retval;
-    vcjson_array* tmp;
-
-    /* copy the array. */
-    retval = vcjson_array_copy(&tmp, alloc, orig);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-    /* wrap this array in a new value. */
-    retval = vcjson_value_create_from_array(value, alloc, tmp);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_tmp;
+            break;
     }
 
-    /* success. */
-    goto done;
-
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
+    /* a compact container is read-only, and one owned by another allocator
+     * must not be freed through this one, so either is copied instead, as is
+     * any other value. */
+    return vcjson_value_copy_deep(value, alloc, orig);
 }
 
 /**
- * \brief Copy a number value.
+ * \brief Wrap a shared object in a new value.
  */
-static status vcjson_value_copy_number(
-    vcjson_value** value, allocator* alloc, const vcjson_number* orig)
+static status vcjson_value_share_object(
+    vcjson_value** value, allocator* alloc, vcjson_object* shared)
 {
-    status retval, release_retval;
-    vcjson_number* tmp;
-
-    /* copy the number. */
-    retval = vcjson_number_copy(&tmp, alloc, orig);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
+    status retval;
 
-    /* wrap this number in a new value. */
-    retval = vcjson_value_create_from_number(value, alloc, tmp);
+    /* wrap the original object in a new value. */
+    retval = vcjson_value_create_from_object(value, alloc, shared);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_tmp;
+        return retval;
     }
 
-    /* success. */
-    goto done;
+    /* the original value keeps the link to its parent. */
+    (*value)->linked = false;
 
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
+    /* share it; either value copies it when fetching it for modification. */
+    __atomic_fetch_add(&shared->shares, 1, __ATOMIC_RELAXED);
 
-done:
-    return retval;
+    return STATUS_SUCCESS;
 }
 
 /**
- * \brief Copy a string value.
+ * \brief Wrap a shared array in a new value.
  */
-static status vcjson_value_copy_string(
-    vcjson_value** value, allocator* alloc, const vcjson_string* orig)
+static status vcjson_value_share_array(
+    vcjson_value** value, allocator* alloc, vcjson_array* shared)
 {
-    status retval, release_retval;
-    vcjson_string* tmp;
+    status retval;
 
-    /* copy the string. */
-    retval = vcjson_string_copy(&tmp, alloc, orig);
+    /* wrap the original array in a new value. */
+    retval = vcjson_value_create_from_array(value, alloc, shared);
     if (STATUS_SUCCESS != retval)
     {
-        goto done;
+        return retval;
     }
 
-    /* wrap this string in a new value. */
-    retval = vcjson_value_create_from_string(value, alloc, tmp);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto cleanup_tmp;
-    }
+    /* the original value keeps the link to its parent. */
+    (*value)->linked = false;
 
-    /* success. */
-    goto done;
+    /* share it; either value copies it when fetching it for modification. */
+    __atomic_fetch_add(&shared->shares, 1, __ATOMIC_RELAXED);
 
-cleanup_tmp:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
-done:
-    return retval;
-}
-
-/**
- * \brief Copy a bool value.
- */
-static status vcjson_value_copy_bool(
-    vcjson_value** value, allocator* alloc, const vcjson_bool* orig)
-{
-    /* handle true. */
-    if (orig == VCJSON_TRUE)
-    {
-        return vcjson_value_create_from_true(value, alloc);
-    }
-    /* otherwise, handle false. */
-    else
-    {
-        return vcjson_value_create_from_false(value, alloc);
-    }
+    return STATUS_SUCCESS;
 }
@@ -0,0 +1,531 @@
+/**
+ * \file vcjson_value_copy_compact.c
+ *
+ * \brief Copy a value instance into a single allocation.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+typedef struct vcjson_copy_compact_context vcjson_copy_compact_context;
+struct vcjson_copy_compact_context
+{
+    allocator* alloc;
+    /* the block being filled, or NULL while the copy is only measured. */
+    uint8_t* base;
+    size_t offset;
+    bool sensitive;
+};
+
+/* forward decls. */
+static vcjson_value_compact* vcjson_copy_compact_root(
+    vcjson_copy_compact_context* ctx, const vcjson_value* orig);
+static vcjson_value* vcjson_copy_compact_value(
+    vcjson_copy_compact_context* ctx, vcjson_value* orig);
+static vcjson_value* vcjson_copy_compact_object(
+    vcjson_copy_compact_context* ctx, vcjson_value* value,
+    vcjson_object* orig);
+static vcjson_value* vcjson_copy_compact_array(
+    vcjson_copy_compact_context* ctx, vcjson_value* value,
+    vcjson_array* orig);
+static vcjson_value* vcjson_copy_compact_number(
+    vcjson_copy_compact_context* ctx, double number);
+static vcjson_value* vcjson_copy_compact_string_value(
+    vcjson_copy_compact_context* ctx, const vcjson_string* orig);
+static vcjson_string* vcjson_copy_compact_key(
+    vcjson_copy_compact_context* ctx, const vcjson_string* orig);
+static void vcjson_copy_compact_string_init(
+    vcjson_copy_compact_context* ctx, vcjson_string* string,
+    const vcjson_string* orig);
+static void vcjson_copy_compact_container_init(
+    vcjson_copy_compact_context* ctx, vcjson_value* value, int type,
+    void* container);
+static void* vcjson_copy_compact_take(
+    vcjson_copy_compact_context* ctx, size_t size);
+
+/**
+ * \brief Create a deep copy of the given \ref vcjson_value instance in a
+ * single allocation.
+ *
+ * The size of the whole copy is measured first, and the copy is then laid out
+ * in one block in depth-first order, so that it is created with a single
+ * allocation and released with a single reclaim. Objects in the copy use flat
+ * or hash storage, and arrays of numbers keep their packed numbers. Strings
+ * keep the sensitivity that they have when the copy is made.
+ *
+ * Objects and arrays in a compact copy are read-only; modifying them fails
+ * with ERROR_VCJSON_VALUE_SHARED. Their emitted forms are not memoized. A
+ * value copied from a compact copy with \ref vcjson_value_copy is an ordinary
+ * value that can be modified.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. This
+ * value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle. Values fetched from the copy must be released before
+ * it.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param orig          The original value to copy.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_copy_compact(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, const vcjson_value* orig)
+{
+    status retval;
+    vcjson_copy_compact_context ctx;
+    vcjson_value_compact* compact;
+
+    /* scalar values are already copied in a single allocation. */
+    if (VCJSON_VALUE_TYPE_OBJECT != orig->type
+     && VCJSON_VALUE_TYPE_ARRAY != orig->type)
+    {
+        return vcjson_value_copy(value, alloc, orig);
+    }
+
+    /* with no block, the first pass only measures the copy. */
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.alloc = alloc;
+    vcjson_copy_compact_root(&ctx, orig);
+
+    /* allocate the block. */
+    retval = allocator_allocate(alloc, (void**)&ctx.base, ctx.offset);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* lay out the copy. */
+    ctx.offset = 0;
+    compact = vcjson_copy_compact_root(&ctx, orig);
+    compact->size = ctx.offset;
+    compact->sensitive = ctx.sensitive;
+
+    /* releasing the root value releases the whole block. */
+    resource_init(&compact->value.hdr, &vcjson_value_compact_resource_release);
+
+    /* success. */
+    *value = &compact->value;
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Copy an object or array into the block, wrapped by the root value at
+ * the start of the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param orig          The object or array value to copy.
+ *
+ * \returns the root of the copy, or NULL if the copy is only being measured.
+ */
+static vcjson_value_compact* vcjson_copy_compact_root(
+    vcjson_copy_compact_context* ctx, const vcjson_value* orig)
+{
+    vcjson_value_compact* compact =
+        vcjson_copy_compact_take(ctx, sizeof(*compact));
+    vcjson_value* value = (NULL != compact) ? &compact->value : NULL;
+
+    if (VCJSON_VALUE_TYPE_OBJECT == orig->type)
+    {
+        vcjson_copy_compact_object(ctx, value, (vcjson_object*)orig->value);
+    }
+    else
+    {
+        vcjson_copy_compact_array(ctx, value, (vcjson_array*)orig->value);
+    }
+
+    return compact;
+}
+
+/**
+ * \brief Copy a value into the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param orig          The value to copy.
+ *
+ * \returns the copy, or NULL if the copy is only being measured.
+ */
+static vcjson_value* vcjson_copy_compact_value(
+    vcjson_copy_compact_context* ctx, vcjson_value* orig)
+{
+    switch (orig->type)
+    {
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return
+                vcjson_copy_compact_object(
+                    ctx, vcjson_copy_compact_take(ctx, sizeof(vcjson_value)),
+                    (vcjson_object*)orig->value);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return
+                vcjson_copy_compact_array(
+                    ctx, vcjson_copy_compact_take(ctx, sizeof(vcjson_value)),
+                    (vcjson_array*)orig->value);
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            return
+                vcjson_copy_compact_number(
+                    ctx, ((const vcjson_number*)orig->value)->value);
+
+        case VCJSON_VALUE_TYPE_STRING:
+            return
+                vcjson_copy_compact_string_value(
+                    ctx, (const vcjson_string*)orig->value);
+
+        /* true, false, and null values are shared singletons. */
+        default:
+            return orig;
+    }
+}
+
+/**
+ * \brief Copy an object and its members into the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param value         The value to wrap the copy, or NULL if the copy is
+ *                      only being measured.
+ * \param orig          The object to copy.
+ *
+ * \returns the value wrapping the copy, or NULL if the copy is only being
+ * measured.
+ */
+static vcjson_value* vcjson_copy_compact_object(
+    vcjson_copy_compact_context* ctx, vcjson_value* value,
+    vcjson_object* orig)
+{
+    vcjson_object* obj;
+    vcjson_object_entry* entries;
+    vcjson_object_entry** order;
+    uint32_t* index;
+    size_t count = vcjson_object_elements(orig);
+    size_t index_size = 0;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* member;
+
+    /* larger objects are hashed; index slots are kept at most half full. */
+    if (count > VCJSON_OBJECT_FLAT_MAXIMUM_SIZE)
+    {
+        index_size = 2 * VCJSON_OBJECT_HASH_MINIMUM_CAPACITY;
+        while (index_size < 2 * count)
+        {
+            index_size *= 2;
+        }
+    }
+
+    /* the object, its entries, order, and index come first. */
+    obj = vcjson_copy_compact_take(ctx, sizeof(*obj));
+    entries = vcjson_copy_compact_take(ctx, count * sizeof(*entries));
+    order = vcjson_copy_compact_take(ctx, count * sizeof(*order));
+    index = vcjson_copy_compact_take(ctx, index_size * sizeof(*index));
+
+    if (NULL != obj)
+    {
+        memset(obj, 0, sizeof(*obj));
+        resource_init(&obj->hdr, &vcjson_value_singleton_resource_release);
+        obj->alloc = ctx->alloc;
+        obj->storage =
+            index_size > 0
+                ? VCJSON_OBJECT_STORAGE_HASH
+                : VCJSON_OBJECT_STORAGE_FLAT;
+        obj->entries = entries;
+        obj->count = count;
+        obj->capacity = count;
+        obj->index = (index_size > 0) ? index : NULL;
+        obj->index_size = index_size;
+        obj->order = order;
+        obj->insertion_order = orig->insertion_order;
+
+        /* the block holds a share, so that the object is never modified. */
+        obj->shares = 1;
+        obj->compact = true;
+        obj->cache.alloc = ctx->alloc;
+        obj->cache.shares = &obj->shares;
+
+        vcjson_copy_compact_container_init(
+            ctx, value, VCJSON_VALUE_TYPE_OBJECT, obj);
+    }
+
+    /* each key is followed by its value. */
+    vcjson_object_cursor_begin(&iter, orig);
+    for (size_t i = 0; i < count; ++i)
+    {
+        vcjson_object_cursor_member(&key, &member, orig, &iter);
+
+        vcjson_string* keycopy = vcjson_copy_compact_key(ctx, key);
+        vcjson_value* membercopy = vcjson_copy_compact_value(ctx, member);
+
+        if (NULL != obj)
+        {
+            entries[i].key = keycopy;
+            entries[i].value = membercopy;
+            entries[i].hash = keycopy->hash;
+            order[i] = &entries[i];
+            vcjson_emit_cache_adopt(&obj->cache, membercopy);
+        }
+
+        vcjson_object_cursor_next(&iter, orig);
+    }
+
+    /* members are copied in key order, unless insertion order is kept. */
+    if (NULL != obj && obj->insertion_order)
+    {
+        vcjson_object_hash_sort(obj);
+    }
+
+    /* the order is sorted up front, since this object is read-only. */
+    if (NULL != obj)
+    {
+        __atomic_store_n(
+            &obj->order_state, VCJSON_OBJECT_ORDER_SORTED, __ATOMIC_RELAXED);
+    }
+
+    /* index the entries of a hashed object. */
+    if (NULL != obj && index_size > 0)
+    {
+        memset(index, 0, index_size * sizeof(*index));
+        for (size_t i = 0; i < count; ++i)
+        {
+            vcjson_object_hash_link(obj, i);
+        }
+    }
+
+    return value;
+}
+
+/**
+ * \brief Copy an array and its elements into the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param value         The value to wrap the copy, or NULL if the copy is
+ *                      only being measured.
+ * \param orig          The array to copy.
+ *
+ * \returns the value wrapping the copy, or NULL if the copy is only being
+ * measured.
+ */
+static vcjson_value* vcjson_copy_compact_array(
+    vcjson_copy_compact_context* ctx, vcjson_value* value,
+    vcjson_array* orig)
+{
+    vcjson_array* arr;
+    vcjson_value** elements;
+    double* numbers = NULL;
+    size_t elems = orig->elems;
+
+    /* the array and its element table come first. */
+    arr = vcjson_copy_compact_take(ctx, sizeof(*arr));
+    elements = vcjson_copy_compact_take(ctx, elems * sizeof(*elements));
+
+    /* packed numbers are kept, and are boxed ahead of time. */
+    if (NULL != orig->numbers)
+    {
+        numbers = vcjson_copy_compact_take(ctx, elems * sizeof(*numbers));
+    }
+
+    if (NULL != arr)
+    {
+        memset(arr, 0, sizeof(*arr));
+        resource_init(&arr->hdr, &vcjson_value_singleton_resource_release);
+        arr->alloc = ctx->alloc;
+        arr->arr = elements;
+        arr->elems = elems;
+        arr->capacity = elems;
+        arr->numbers = numbers;
+
+        /* the block holds a share, so that the array is never modified. */
+        arr->shares = 1;
+        arr->compact = true;
+        arr->cache.alloc = ctx->alloc;
+        arr->cache.shares = &arr->shares;
+
+        if (NULL != numbers)
+        {
+            memcpy(numbers, orig->numbers, elems * sizeof(*numbers));
+        }
+
+        vcjson_copy_compact_container_init(
+            ctx, value, VCJSON_VALUE_TYPE_ARRAY, arr);
+    }
+
+    /* the elements follow the array. */
+    for (size_t i = 0; i < elems; ++i)
+    {
+        vcjson_value* element =
+            (NULL != orig->numbers)
+                ? vcjson_copy_compact_number(ctx, orig->numbers[i])
+                : vcjson_copy_compact_value(ctx, orig->arr[i]);
+
+        if (NULL != arr)
+        {
+            elements[i] = element;
+            vcjson_emit_cache_adopt(&arr->cache, element);
+        }
+    }
+
+    return value;
+}
+
+/**
+ * \brief Copy a number value into the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param number        The number to copy.
+ *
+ * \returns the copy, or NULL if the copy is only being measured.
+ */
+static vcjson_value* vcjson_copy_compact_number(
+    vcjson_copy_compact_context* ctx, double number)
+{
+    vcjson_value_number_block* block =
+        vcjson_copy_compact_take(ctx, sizeof(*block));
+
+    if (NULL == block)
+    {
+        return NULL;
+    }
+
+    memset(block, 0, sizeof(*block));
+    resource_init(&block->value.hdr, &vcjson_value_singleton_resource_release);
+    resource_init(
+        &block->number.hdr, &vcjson_value_singleton_resource_release);
+    block->number.alloc = ctx->alloc;
+    block->number.value = number;
+    block->value.alloc = ctx->alloc;
+    block->value.type = VCJSON_VALUE_TYPE_NUMBER;
+    block->value.value = &block->number;
+
+    return &block->value;
+}
+
+/**
+ * \brief Copy a string value into the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param orig          The string to copy.
+ *
+ * \returns the copy, or NULL if the copy is only being measured.
+ */
+static vcjson_value* vcjson_copy_compact_string_value(
+    vcjson_copy_compact_context* ctx, const vcjson_string* orig)
+{
+    vcjson_value_string_block* block =
+        vcjson_copy_compact_take(ctx, sizeof(*block) + orig->length + 1);
+
+    if (NULL == block)
+    {
+        return NULL;
+    }
+
+    memset(block, 0, sizeof(*block));
+    resource_init(&block->value.hdr, &vcjson_value_singleton_resource_release);
+    block->value.alloc = ctx->alloc;
+    block->value.type = VCJSON_VALUE_TYPE_STRING;
+    block->value.value = &block->string;
+    vcjson_copy_compact_string_init(ctx, &block->string, orig);
+
+    return &block->value;
+}
+
+/**
+ * \brief Copy an object key into the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param orig          The key to copy.
+ *
+ * \returns the copy, or NULL if the copy is only being measured.
+ */
+static vcjson_string* vcjson_copy_compact_key(
+    vcjson_copy_compact_context* ctx, const vcjson_string* orig)
+{
+    vcjson_string* string =
+        vcjson_copy_compact_take(ctx, sizeof(*string) + orig->length + 1);
+
+    if (NULL == string)
+    {
+        return NULL;
+    }
+
+    memset(string, 0, sizeof(*string));
+    vcjson_copy_compact_string_init(ctx, string, orig);
+
+    return string;
+}
+
+/**
+ * \brief Initialize a string in the block, whose characters follow it.
+ *
+ * \param ctx           The compact copy context.
+ * \param string        The cleared string to initialize.
+ * \param orig          The string to copy.
+ */
+static void vcjson_copy_compact_string_init(
+    vcjson_copy_compact_context* ctx, vcjson_string* string,
+    const vcjson_string* orig)
+{
+    resource_init(&string->hdr, &vcjson_value_singleton_resource_release);
+    string->alloc = ctx->alloc;
+    string->value = (char*)(string + 1);
+    string->length = orig->length;
+    memcpy(string->value, orig->value, orig->length);
+    string->value[orig->length] = 0;
+    string->hash = vcjson_string_hash(orig);
+    string->hashed = true;
+    string->sensitive = orig->sensitive;
+
+    /* the whole block is wiped if it holds a sensitive string. */
+    ctx->sensitive = ctx->sensitive || orig->sensitive;
+}
+
+/**
+ * \brief Initialize the value wrapping an object or array in the block.
+ *
+ * \param ctx           The compact copy context.
+ * \param value         The value to initialize.
+ * \param type          The type of this value.
+ * \param container     The object or array wrapped by this value.
+ */
+static void vcjson_copy_compact_container_init(
+    vcjson_copy_compact_context* ctx, vcjson_value* value, int type,
+    void* container)
+{
+    memset(value, 0, sizeof(*value));
+    resource_init(&value->hdr, &vcjson_value_singleton_resource_release);
+    value->alloc = ctx->alloc;
+    value->type = type;
+    value->value = container;
+}
+
+/**
+ * \brief Take the next piece of the block.
+ *
+ * Each piece is aligned for any type, so that pieces of any size can follow
+ * each other.
+ *
+ * \param ctx           The compact copy context.
+ * \param size          The size of this piece.
+ *
+ * \returns the piece, or NULL if the copy is only being measured.
+ */
+static void* vcjson_copy_compact_take(
+    vcjson_copy_compact_context* ctx, size_t size)
+{
+    const size_t align = _Alignof(max_align_t);
+    void* piece = (NULL != ctx->base) ? ctx->base + ctx->offset : NULL;
+
+    ctx->offset += (size + align - 1) & ~(align - 1);
+
+    return piece;
+}
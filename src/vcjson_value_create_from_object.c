@@ -39,9 +39,11 @@ vcjson_value_create_from_object(
 {
     status retval;
     vcjson_value* tmp;
+    vcjson_pool* pool;
 
     /* allocate memory for this value. */
-    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    retval =
+        vcjson_pool_node_allocate(&pool, alloc, (void**)&tmp, sizeof(*tmp));
     if (STATUS_SUCCESS != retval)
     {
         goto done;
@@ -49,6 +51,7 @@ vcjson_value_create_from_object(
 
     /* clear memory. */
     memset(tmp, 0, sizeof(*tmp));
+    tmp->pool = pool;
 
     /* initialize resource. */
     resource_init(&tmp->hdr, &vcjson_value_with_resource_release);
@@ -57,6 +60,8 @@ vcjson_value_create_from_object(
     tmp->alloc = alloc;
     tmp->type = VCJSON_VALUE_TYPE_OBJECT;
     tmp->value = object;
+    /* the object's cache is linked to this value's parent, which is NULL. */
+    tmp->linked = true;
 
     /* success. */
     *value = tmp;
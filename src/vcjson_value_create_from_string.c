@@ -39,9 +39,11 @@ vcjson_value_create_from_string(
 {
     status retval;
     vcjson_value* tmp;
+    vcjson_pool* pool;
 
     /* allocate memory for this value. */
-    retval = allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    retval =
+        vcjson_pool_node_allocate(&pool, alloc, (void**)&tmp, sizeof(*tmp));
     if (STATUS_SUCCESS != retval)
     {
         goto done;
@@ -49,6 +51,7 @@ vcjson_value_create_from_string(
 
     /* clear memory. */
     memset(tmp, 0, sizeof(*tmp));
+    tmp->pool = pool;
 
     /* initialize resource. */
     resource_init(&tmp->hdr, &vcjson_value_with_resource_release);
@@ -0,0 +1,76 @@
+/**
+ * \file vcjson_value_create_number.c
+ *
+ * \brief Create a number value in a single allocation.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcjson_value instance holding the given number.
+ *
+ * Unlike creating a \ref vcjson_number and wrapping it with
+ * \ref vcjson_value_create_from_number, this allocates the value and its
+ * number together in a single block.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. The
+ * \ref vcjson_number instance that it holds is owned by this value instance.
+ * This value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param number        The number value to be used for this instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_create_number(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, double number)
+{
+    status retval;
+    vcjson_value_number_block* tmp;
+    vcjson_pool* pool;
+
+    /* allocate memory for this value and its number. */
+    retval =
+        vcjson_pool_node_allocate(&pool, alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->value.pool = pool;
+
+    /* initialize resources; the number is released with its value. */
+    resource_init(&tmp->value.hdr, &vcjson_value_block_resource_release);
+    resource_init(&tmp->number.hdr, &vcjson_value_singleton_resource_release);
+
+    /* set initial values. */
+    tmp->number.alloc = alloc;
+    tmp->number.value = number;
+    tmp->value.alloc = alloc;
+    tmp->value.type = VCJSON_VALUE_TYPE_NUMBER;
+    tmp->value.value = &tmp->number;
+
+    /* success. */
+    *value = &tmp->value;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file vcjson_value_create_string_from_raw.c
+ *
+ * \brief Create a string value in a single allocation.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcjson_value instance holding a copy of the given raw
+ * string value.
+ *
+ * Unlike creating a \ref vcjson_string and wrapping it with
+ * \ref vcjson_value_create_from_string, this allocates the value, its string,
+ * and the string's characters together in a single block.
+ *
+ * \note On success, this function creates a \ref vcjson_value instance. The
+ * \ref vcjson_string instance that it holds is owned by this value instance.
+ * This value instance is a resource that is owned by the caller. When no longer
+ * needed, this resource must be released by calling \ref resource_release on
+ * its resource handle.
+ *
+ * \param value         Pointer to the value pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param str           The raw string value to be used for this instance. This
+ *                      value is copied; the original value is assumed owned by
+ *                      the caller.
+ * \param size          The size of this raw string value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_create_string_from_raw(
+    vcjson_value** value, RCPR_SYM(allocator)* alloc, const char* str,
+    size_t size)
+{
+    status retval;
+    vcjson_value_string_block* tmp;
+    vcjson_pool* pool;
+
+    /* allocate memory for this value, its string, and its ASCIIZ characters. */
+    retval =
+        vcjson_pool_node_allocate(
+            &pool, alloc, (void**)&tmp, sizeof(*tmp) + size + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->value.pool = pool;
+
+    /* initialize resources; the string is released with its value. */
+    resource_init(&tmp->value.hdr, &vcjson_value_block_resource_release);
+    resource_init(&tmp->string.hdr, &vcjson_value_singleton_resource_release);
+
+    /* the characters follow the block. */
+    tmp->string.alloc = alloc;
+    tmp->string.value = (char*)(tmp + 1);
+    tmp->string.length = size;
+    memcpy(tmp->string.value, str, size);
+    tmp->string.value[size] = 0;
+
+    /* precompute the hash, so object lookups never rescan this string. */
+    tmp->string.hash = vcjson_object_key_hash(tmp->string.value, size);
+    tmp->string.hashed = true;
+
+    /* set initial values. */
+    tmp->value.alloc = alloc;
+    tmp->value.type = VCJSON_VALUE_TYPE_STRING;
+    tmp->value.value = &tmp->string;
+
+    /* success. */
+    *value = &tmp->value;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
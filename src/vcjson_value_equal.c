@@ -0,0 +1,239 @@
+/**
+ * \file vcjson_value_equal.c
+ *
+ * \brief Compare two values for structural equality.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static bool vcjson_value_equal_string(
+    const vcjson_string* lhs, const vcjson_string* rhs);
+static bool vcjson_value_equal_object(vcjson_object* lhs, vcjson_object* rhs);
+static bool vcjson_value_equal_object_lookup(
+    vcjson_object* lhs, vcjson_object* rhs);
+static bool vcjson_value_equal_array(
+    const vcjson_array* lhs, const vcjson_array* rhs);
+
+/**
+ * \brief Determine whether two \ref vcjson_value instances hold the same JSON
+ * content.
+ *
+ * Values are compared structurally, without emitting them. Identical and
+ * shared nodes are equal without being walked, and containers or strings whose
+ * sizes differ are unequal without being walked. Objects are equal when they
+ * hold the same keys with equal values, regardless of storage or member
+ * order, and are compared in a single merge of their sorted members. Numbers
+ * are compared by value, so 0 and -0 are equal. Neither value is modified.
+ *
+ * \param lhs           The left-hand-side value to compare.
+ * \param rhs           The right-hand-side value to compare.
+ *
+ * \returns true if these values are equal, or false otherwise.
+ */
+bool vcjson_value_equal(const vcjson_value* lhs, const vcjson_value* rhs)
+{
+    /* a value is equal to itself. */
+    if (lhs == rhs || lhs->value == rhs->value)
+    {
+        return true;
+    }
+
+    if (lhs->type != rhs->type)
+    {
+        return false;
+    }
+
+    switch (lhs->type)
+    {
+        case VCJSON_VALUE_TYPE_NULL:
+            return true;
+
+        case VCJSON_VALUE_TYPE_BOOL:
+            return
+                ((const vcjson_bool*)lhs->value)->value
+                    == ((const vcjson_bool*)rhs->value)->value;
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            return
+                ((const vcjson_number*)lhs->value)->value
+                    == ((const vcjson_number*)rhs->value)->value;
+
+        case VCJSON_VALUE_TYPE_STRING:
+            return
+                vcjson_value_equal_string(
+                    (const vcjson_string*)lhs->value,
+                    (const vcjson_string*)rhs->value);
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return
+                vcjson_value_equal_object(
+                    (vcjson_object*)lhs->value, (vcjson_object*)rhs->value);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return
+                vcjson_value_equal_array(
+                    (const vcjson_array*)lhs->value,
+                    (const vcjson_array*)rhs->value);
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * \brief Compare two strings.
+ */
+static bool vcjson_value_equal_string(
+    const vcjson_string* lhs, const vcjson_string* rhs)
+{
+    if (lhs->length != rhs->length)
+    {
+        return false;
+    }
+
+    /* precomputed hashes rule out most unequal strings. */
+    if (lhs->hashed && rhs->hashed && lhs->hash != rhs->hash)
+    {
+        return false;
+    }
+
+    return 0 == memcmp(lhs->value, rhs->value, lhs->length);
+}
+
+/**
+ * \brief Compare two objects by merging their sorted members.
+ */
+static bool vcjson_value_equal_object(vcjson_object* lhs, vcjson_object* rhs)
+{
+    vcjson_object_cursor liter, riter;
+    const vcjson_string* lkey;
+    const vcjson_string* rkey;
+    vcjson_value* lvalue;
+    vcjson_value* rvalue;
+
+    if (vcjson_object_elements(lhs) != vcjson_object_elements(rhs))
+    {
+        return false;
+    }
+
+    /* objects walked in insertion order are compared by lookup instead. */
+    if (lhs->insertion_order || rhs->insertion_order)
+    {
+        return vcjson_value_equal_object_lookup(lhs, rhs);
+    }
+
+    /* with equal sizes, the keys must match pairwise in sorted order. */
+    vcjson_object_cursor_begin(&liter, lhs);
+    vcjson_object_cursor_begin(&riter, rhs);
+    while (vcjson_object_cursor_member(&lkey, &lvalue, lhs, &liter)
+        && vcjson_object_cursor_member(&rkey, &rvalue, rhs, &riter))
+    {
+        if (!vcjson_value_equal_string(lkey, rkey)
+         || !vcjson_value_equal(lvalue, rvalue))
+        {
+            return false;
+        }
+
+        vcjson_object_cursor_next(&liter, lhs);
+        vcjson_object_cursor_next(&riter, rhs);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Compare two objects by looking up each member of one in the other.
+ */
+static bool vcjson_value_equal_object_lookup(
+    vcjson_object* lhs, vcjson_object* rhs)
+{
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* lvalue;
+    vcjson_value* rvalue;
+
+    vcjson_object_cursor_begin(&iter, lhs);
+    while (vcjson_object_cursor_member(&key, &lvalue, lhs, &iter))
+    {
+        if (STATUS_SUCCESS != vcjson_object_get(&rvalue, rhs, key)
+         || !vcjson_value_equal(lvalue, rvalue))
+        {
+            return false;
+        }
+
+        vcjson_object_cursor_next(&iter, lhs);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Compare two arrays element by element.
+ */
+static bool vcjson_value_equal_array(
+    const vcjson_array* lhs, const vcjson_array* rhs)
+{
+    const vcjson_value* lvalue;
+    const vcjson_value* rvalue;
+
+    if (lhs->elems != rhs->elems)
+    {
+        return false;
+    }
+
+    /* packed numbers are compared without boxing them. */
+    if (NULL != lhs->numbers && NULL != rhs->numbers)
+    {
+        for (size_t i = 0; i < lhs->elems; ++i)
+        {
+            if (lhs->numbers[i] != rhs->numbers[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /* a packed array only equals an array of numbers. */
+    if (NULL != lhs->numbers || NULL != rhs->numbers)
+    {
+        if (NULL != lhs->numbers)
+        {
+            const vcjson_array* tmp = lhs;
+            lhs = rhs;
+            rhs = tmp;
+        }
+
+        for (size_t i = 0; i < lhs->elems; ++i)
+        {
+            lvalue = lhs->arr[i];
+            if (VCJSON_VALUE_TYPE_NUMBER != lvalue->type
+             || ((const vcjson_number*)lvalue->value)->value
+                    != rhs->numbers[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    for (size_t i = 0; i < lhs->elems; ++i)
+    {
+        lvalue = lhs->arr[i];
+        rvalue = rhs->arr[i];
+        if (!vcjson_value_equal(lvalue, rvalue))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
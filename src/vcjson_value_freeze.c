@@ -0,0 +1,503 @@
+/**
+ * \file vcjson_value_freeze.c
+ *
+ * \brief Freeze a value instance into a read-only tape.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief A slot in the table of interned strings.
+ */
+typedef struct vcjson_freeze_intern vcjson_freeze_intern;
+struct vcjson_freeze_intern
+{
+    uint64_t hash;
+    /* offset of the characters from the start of the block, or 0 if empty. */
+    size_t offset;
+    size_t length;
+};
+
+typedef struct vcjson_freeze_context vcjson_freeze_context;
+struct vcjson_freeze_context
+{
+    /* the block being filled, or NULL while the tape is only measured. */
+    uint8_t* base;
+    /* the end of the entries, or their size while measuring. */
+    size_t entries;
+    /* the end of the characters, or their size while measuring. */
+    size_t strings;
+    size_t string_count;
+    vcjson_freeze_intern* interned;
+    size_t interned_size;
+    bool sensitive;
+};
+
+/* forward decls. */
+static status vcjson_freeze_measure(
+    vcjson_freeze_context* ctx, vcjson_value* value);
+static status vcjson_freeze_measure_string(
+    vcjson_freeze_context* ctx, const vcjson_string* str);
+static void vcjson_freeze_value(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    vcjson_value* value);
+static void vcjson_freeze_object(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    vcjson_object* obj);
+static void vcjson_freeze_array(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    const vcjson_array* arr);
+static void vcjson_freeze_string(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    const vcjson_string* str);
+static vcjson_frozen_value* vcjson_freeze_take(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry, size_t count);
+
+/**
+ * \brief Freeze the given \ref vcjson_value instance into a contiguous,
+ * read-only tape.
+ *
+ * The tape is a single block holding an entry for every value, followed by the
+ * characters of every string. Each object's members are stored as key and
+ * value entry pairs sorted by key, so that members are found by binary search,
+ * and each array's elements are stored as consecutive entries. Identical
+ * strings, such as keys repeated across objects, are stored once. Entries
+ * refer to their characters, members, and elements by relative offsets, so
+ * the tape does not depend on where it is placed in memory.
+ *
+ * A frozen value is read with the \ref vcjson_frozen_value_get_object family
+ * of accessors, which mirror those of \ref vcjson_value. Since it is never
+ * modified, it may be read from any number of threads without locking, and it
+ * is released with a single reclaim. Strings keep the sensitivity that they
+ * have when the value is frozen, and the tape is wiped when it is released if
+ * it holds a sensitive string.
+ *
+ * \note On success, this function creates a \ref vcjson_frozen instance. This
+ * is a resource that is owned by the caller. When no longer needed, this
+ * resource must be released by calling \ref resource_release on its resource
+ * handle. Frozen values read from it share its lifetime. The value is not
+ * modified.
+ *
+ * \param frozen        Pointer to the frozen pointer to hold this value.
+ * \param alloc         The allocator to use for this operation.
+ * \param value         The value to freeze.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_FREEZE_TOO_LARGE if a string, object, or array is too
+ *        large to be frozen.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_freeze(
+    vcjson_frozen** frozen, RCPR_SYM(allocator)* alloc, vcjson_value* value)
+{
+    status retval, release_retval;
+    vcjson_freeze_context ctx;
+    vcjson_frozen* tmp;
+    size_t interned_size, size;
+
+    /* the first pass only measures the tape. */
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.entries = sizeof(vcjson_frozen) + sizeof(vcjson_frozen_value);
+    retval = vcjson_freeze_measure(&ctx, value);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* size the intern table to at most half full. */
+    for (ctx.interned_size = 16; ctx.interned_size < 2 * ctx.string_count; )
+    {
+        ctx.interned_size *= 2;
+    }
+
+    interned_size = ctx.interned_size * sizeof(*ctx.interned);
+    retval = allocator_allocate(alloc, (void**)&ctx.interned, interned_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    memset(ctx.interned, 0, interned_size);
+
+    /* allocate the block, assuming that no string is repeated. */
+    retval =
+        allocator_allocate(alloc, (void**)&ctx.base, ctx.entries + ctx.strings);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_interned;
+    }
+
+    /* lay out the tape, with the characters following the entries. */
+    tmp = (vcjson_frozen*)ctx.base;
+    ctx.strings = ctx.entries;
+    ctx.entries = sizeof(*tmp) + sizeof(vcjson_frozen_value);
+    vcjson_freeze_value(
+        &ctx, (vcjson_frozen_value*)(ctx.base + sizeof(*tmp)), value);
+
+    /* give back the space saved by interning strings. */
+    size = ctx.strings;
+    retval = allocator_reallocate(alloc, (void**)&tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_block;
+    }
+
+    /* set up the frozen instance at the start of the block. */
+    resource_init(&tmp->hdr, &vcjson_frozen_resource_release);
+    tmp->alloc = alloc;
+    tmp->tape = (vcjson_frozen_value*)(tmp + 1);
+    tmp->tape_size = size - sizeof(*tmp);
+    tmp->size = size;
+    tmp->sensitive = ctx.sensitive;
+    tmp->mapping = NULL;
+    tmp->mapping_size = 0;
+
+    /* success. */
+    *frozen = tmp;
+    retval = STATUS_SUCCESS;
+    goto cleanup_interned;
+
+cleanup_block:
+    if (ctx.sensitive)
+    {
+        memset(ctx.base, 0, ctx.strings);
+    }
+
+    release_retval = allocator_reclaim(alloc, ctx.base);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_interned:
+    release_retval = allocator_reclaim(alloc, ctx.interned);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Measure the entries and characters that a value adds to the tape.
+ *
+ * \param ctx           The freeze context.
+ * \param value         The value to measure.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_FREEZE_TOO_LARGE if a string, object, or array is too
+ *        large to be frozen.
+ */
+static status vcjson_freeze_measure(
+    vcjson_freeze_context* ctx, vcjson_value* value)
+{
+    status retval;
+    vcjson_object* obj;
+    const vcjson_array* arr;
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* member;
+
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_STRING:
+            return
+                vcjson_freeze_measure_string(
+                    ctx, (const vcjson_string*)value->value);
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            obj = (vcjson_object*)value->value;
+            if (vcjson_object_elements(obj) > UINT32_MAX)
+            {
+                return ERROR_VCJSON_FREEZE_TOO_LARGE;
+            }
+
+            /* each member is a key entry followed by a value entry. */
+            ctx->entries +=
+                2 * vcjson_object_elements(obj) * sizeof(vcjson_frozen_value);
+
+            vcjson_object_cursor_begin(&iter, obj);
+            while (vcjson_object_cursor_member(&key, &member, obj, &iter))
+            {
+                retval = vcjson_freeze_measure_string(ctx, key);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                retval = vcjson_freeze_measure(ctx, member);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                vcjson_object_cursor_next(&iter, obj);
+            }
+
+            return STATUS_SUCCESS;
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            arr = (const vcjson_array*)value->value;
+            if (arr->elems > UINT32_MAX)
+            {
+                return ERROR_VCJSON_FREEZE_TOO_LARGE;
+            }
+
+            ctx->entries += arr->elems * sizeof(vcjson_frozen_value);
+
+            /* packed numbers need nothing beyond their entries. */
+            if (NULL == arr->numbers)
+            {
+                for (size_t i = 0; i < arr->elems; ++i)
+                {
+                    retval = vcjson_freeze_measure(ctx, arr->arr[i]);
+                    if (STATUS_SUCCESS != retval)
+                    {
+                        return retval;
+                    }
+                }
+            }
+
+            return STATUS_SUCCESS;
+
+        default:
+            return STATUS_SUCCESS;
+    }
+}
+
+/**
+ * \brief Measure the characters that a string adds to the tape.
+ *
+ * \param ctx           The freeze context.
+ * \param str           The string to measure.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_FREEZE_TOO_LARGE if this string is too large to be
+ *        frozen.
+ */
+static status vcjson_freeze_measure_string(
+    vcjson_freeze_context* ctx, const vcjson_string* str)
+{
+    if (str->length > UINT32_MAX)
+    {
+        return ERROR_VCJSON_FREEZE_TOO_LARGE;
+    }
+
+    /* characters are stored ASCIIZ. */
+    ctx->strings += str->length + 1;
+    ++ctx->string_count;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Freeze a value into the given entry.
+ *
+ * \param ctx           The freeze context.
+ * \param entry         The entry for this value.
+ * \param value         The value to freeze.
+ */
+static void vcjson_freeze_value(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    vcjson_value* value)
+{
+    memset(entry, 0, sizeof(*entry));
+    entry->type = value->type;
+
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_BOOL:
+            entry->payload.boolean = ((const vcjson_bool*)value->value)->value;
+            break;
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            entry->payload.number = ((const vcjson_number*)value->value)->value;
+            break;
+
+        case VCJSON_VALUE_TYPE_STRING:
+            vcjson_freeze_string(
+                ctx, entry, (const vcjson_string*)value->value);
+            break;
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            vcjson_freeze_object(ctx, entry, (vcjson_object*)value->value);
+            break;
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            vcjson_freeze_array(
+                ctx, entry, (const vcjson_array*)value->value);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * \brief Freeze an object's members, in sorted key order.
+ *
+ * \param ctx           The freeze context.
+ * \param entry         The entry for this object.
+ * \param obj           The object to freeze.
+ */
+static void vcjson_freeze_object(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    vcjson_object* obj)
+{
+    size_t count = vcjson_object_elements(obj);
+    vcjson_frozen_value* members = vcjson_freeze_take(ctx, entry, 2 * count);
+    const vcjson_object_element* elem;
+    rbtree_node* node;
+
+    entry->count = (uint32_t)count;
+
+    /* the tree is already sorted. */
+    if (VCJSON_OBJECT_STORAGE_TREE == obj->storage)
+    {
+        node =
+            rbtree_minimum_node(obj->elements, rbtree_root_node(obj->elements));
+        for (size_t i = 0; i < count; ++i)
+        {
+            elem =
+                (const vcjson_object_element*)
+                    rbtree_node_value(obj->elements, node);
+            vcjson_freeze_string(ctx, &members[2 * i], elem->key);
+            vcjson_freeze_value(ctx, &members[2 * i + 1], elem->value);
+            node = rbtree_successor_node(obj->elements, node);
+        }
+    }
+    /* flat and hash entries are sorted even with insertion order. */
+    else
+    {
+        vcjson_object_hash_order(obj);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            vcjson_freeze_string(ctx, &members[2 * i], obj->order[i]->key);
+            vcjson_freeze_value(
+                ctx, &members[2 * i + 1], obj->order[i]->value);
+        }
+    }
+}
+
+/**
+ * \brief Freeze an array's elements.
+ *
+ * \param ctx           The freeze context.
+ * \param entry         The entry for this array.
+ * \param arr           The array to freeze.
+ */
+static void vcjson_freeze_array(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    const vcjson_array* arr)
+{
+    vcjson_frozen_value* elements = vcjson_freeze_take(ctx, entry, arr->elems);
+
+    entry->count = (uint32_t)arr->elems;
+
+    for (size_t i = 0; i < arr->elems; ++i)
+    {
+        /* packed numbers are frozen without boxing them. */
+        if (NULL != arr->numbers)
+        {
+            memset(&elements[i], 0, sizeof(elements[i]));
+            elements[i].type = VCJSON_VALUE_TYPE_NUMBER;
+            elements[i].payload.number = arr->numbers[i];
+        }
+        else
+        {
+            vcjson_freeze_value(ctx, &elements[i], arr->arr[i]);
+        }
+    }
+}
+
+/**
+ * \brief Freeze a string into the given entry, storing its characters only if
+ * an identical string has not already been stored.
+ *
+ * \param ctx           The freeze context.
+ * \param entry         The entry for this string.
+ * \param str           The string to freeze.
+ */
+static void vcjson_freeze_string(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry,
+    const vcjson_string* str)
+{
+    uint64_t hash = vcjson_string_hash(str);
+    size_t mask = ctx->interned_size - 1;
+    size_t slot = (size_t)hash & mask;
+    vcjson_freeze_intern* intern;
+
+    memset(entry, 0, sizeof(*entry));
+    entry->type = VCJSON_VALUE_TYPE_STRING;
+    entry->count = (uint32_t)str->length;
+
+    if (str->sensitive)
+    {
+        ctx->sensitive = true;
+    }
+
+    /* look for an identical string that has already been stored. */
+    for (;;)
+    {
+        intern = &ctx->interned[slot];
+
+        /* store the characters in an empty slot. */
+        if (0 == intern->offset)
+        {
+            intern->hash = hash;
+            intern->offset = ctx->strings;
+            intern->length = str->length;
+            memcpy(ctx->base + ctx->strings, str->value, str->length);
+            ctx->base[ctx->strings + str->length] = 0;
+            ctx->strings += str->length + 1;
+            break;
+        }
+
+        if (intern->hash == hash && intern->length == str->length
+         && 0 == memcmp(ctx->base + intern->offset, str->value, str->length))
+        {
+            break;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    entry->payload.offset = intern->offset - ((uint8_t*)entry - ctx->base);
+}
+
+/**
+ * \brief Take consecutive entries for the members or elements of a container.
+ *
+ * \param ctx           The freeze context.
+ * \param entry         The entry for this container.
+ * \param count         The number of entries to take.
+ *
+ * \returns the first entry taken.
+ */
+static vcjson_frozen_value* vcjson_freeze_take(
+    vcjson_freeze_context* ctx, vcjson_frozen_value* entry, size_t count)
+{
+    vcjson_frozen_value* taken =
+        (vcjson_frozen_value*)(ctx->base + ctx->entries);
+
+    entry->payload.offset = (uint8_t*)taken - (uint8_t*)entry;
+    ctx->entries += count * sizeof(vcjson_frozen_value);
+
+    return taken;
+}
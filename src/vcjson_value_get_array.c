@@ -20,6 +20,12 @@
  * value instance and the lifetime of this value is the same as the lifetime of
  * this instance.
  *
+ * This never modifies \p value. If the array is shared with copies of this
+ * value, or is held in a container that is, modifying it fails with
+ * \ref ERROR_VCJSON_VALUE_SHARED. To modify it, fetch it with
+ * \ref vcjson_value_get_array_mut, after fetching each container holding it the
+ * same way.
+ *
  * \param arr           Pointer to the array pointer to hold the array value
  *                      on success.
  * \param value         The value instance for this operation.
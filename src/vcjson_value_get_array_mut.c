@@ -0,0 +1,61 @@
+/**
+ * \file vcjson_value_get_array_mut.c
+ *
+ * \brief Attempt to coerce a modifiable array from a value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the \ref vcjson_array value of this \ref vcjson_value
+ * instance, so that it can be modified.
+ *
+ * \note On success, this function sets the array pointer to the array value
+ * of this \ref vcjson_value instance. This pointer is to a value owned by this
+ * value instance and the lifetime of this value is the same as the lifetime of
+ * this instance.
+ *
+ * If the array is shared with copies of this value, this value is first given
+ * its own copy of the array. Only the top level of the array is copied; its
+ * members remain shared until they are in turn fetched with this function.
+ * Every container holding this value must already have been fetched this way,
+ * so that it is not shared.
+ *
+ * \param arr           Pointer to the array pointer to hold the array value
+ *                      on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an array.
+ *      - ERROR_VCJSON_VALUE_SHARED if a container holding this value is
+ *        shared.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_get_array_mut(vcjson_array** arr, vcjson_value* value)
+{
+    status retval;
+
+    /* verify that this value is the right type. */
+    if (VCJSON_VALUE_TYPE_ARRAY != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* give this value its own copy if the array is shared. */
+    retval = vcjson_value_unshare(value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* return the value. */
+    *arr = (vcjson_array*)value->value;
+    return STATUS_SUCCESS;
+}
@@ -20,6 +20,12 @@
  * value instance and the lifetime of this value is the same as the lifetime of
  * this instance.
  *
+ * This never modifies \p value. If the object is shared with copies of this
+ * value, or is held in a container that is, modifying it fails with
+ * \ref ERROR_VCJSON_VALUE_SHARED. To modify it, fetch it with
+ * \ref vcjson_value_get_object_mut, after fetching each container holding
+ * it the same way.
+ *
  * \param object        Pointer to the object pointer to hold the object value
  *                      on success.
  * \param value         The value instance for this operation.
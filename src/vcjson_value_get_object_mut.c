@@ -0,0 +1,61 @@
+/**
+ * \file vcjson_value_get_object_mut.c
+ *
+ * \brief Attempt to coerce a modifiable object from a value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/**
+ * \brief Attempt to get the \ref vcjson_object value of this \ref vcjson_value
+ * instance, so that it can be modified.
+ *
+ * \note On success, this function sets the object pointer to the object value
+ * of this \ref vcjson_value instance. This pointer is to a value owned by this
+ * value instance and the lifetime of this value is the same as the lifetime of
+ * this instance.
+ *
+ * If the object is shared with copies of this value, this value is first given
+ * its own copy of the object. Only the top level of the object is copied; its
+ * members remain shared until they are in turn fetched with this function.
+ * Every container holding this value must already have been fetched this way,
+ * so that it is not shared.
+ *
+ * \param object        Pointer to the object pointer to hold the object value
+ *                      on success.
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_INVALID_GET if the type of this value is not an object.
+ *      - ERROR_VCJSON_VALUE_SHARED if a container holding this value is
+ *        shared.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_get_object_mut(vcjson_object** object, vcjson_value* value)
+{
+    status retval;
+
+    /* verify that this value is the right type. */
+    if (VCJSON_VALUE_TYPE_OBJECT != value->type)
+    {
+        return ERROR_VCJSON_INVALID_GET;
+    }
+
+    /* give this value its own copy if the object is shared. */
+    retval = vcjson_value_unshare(value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* return the value. */
+    *object = (vcjson_object*)value->value;
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/**
+ * \file vcjson_value_hash.c
+ *
+ * \brief Hash the content of a value.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static uint64_t vcjson_value_hash_mix(uint64_t hash, uint64_t data);
+static uint64_t vcjson_value_hash_number(double number);
+static uint64_t vcjson_value_hash_string(const vcjson_string* str);
+static uint64_t vcjson_value_hash_object(vcjson_object* obj);
+static uint64_t vcjson_value_hash_array(const vcjson_array* arr);
+
+/**
+ * \brief Compute a hash of the JSON content of a \ref vcjson_value instance.
+ *
+ * The hash is computed from the values themselves, without emitting them, and
+ * does not depend on how a value is stored: object storage and member order,
+ * packed arrays, and the sign of zero do not change it. Values that are equal
+ * according to \ref vcjson_value_equal have the same hash. The hash is stable
+ * across processes, so it may be used as a persistent cache key, but it is not
+ * a cryptographic digest; see \ref vcjson_emit_canonical_sha256 for one.
+ *
+ * \param value         The value to hash.
+ *
+ * \returns the 64-bit hash of this value.
+ */
+uint64_t vcjson_value_hash(const vcjson_value* value)
+{
+    uint64_t hash = vcjson_value_hash_mix(0, (uint64_t)value->type);
+
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_BOOL:
+            return
+                vcjson_value_hash_mix(
+                    hash, ((const vcjson_bool*)value->value)->value);
+
+        case VCJSON_VALUE_TYPE_NUMBER:
+            return
+                vcjson_value_hash_mix(
+                    hash,
+                    vcjson_value_hash_number(
+                        ((const vcjson_number*)value->value)->value));
+
+        case VCJSON_VALUE_TYPE_STRING:
+            return
+                vcjson_value_hash_mix(
+                    hash,
+                    vcjson_value_hash_string(
+                        (const vcjson_string*)value->value));
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            return
+                vcjson_value_hash_mix(
+                    hash, vcjson_value_hash_object(
+                        (vcjson_object*)value->value));
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            return
+                vcjson_value_hash_mix(
+                    hash, vcjson_value_hash_array(
+                        (const vcjson_array*)value->value));
+
+        default:
+            return hash;
+    }
+}
+
+/**
+ * \brief Mix data into a hash, using the splitmix64 finalizer.
+ */
+static uint64_t vcjson_value_hash_mix(uint64_t hash, uint64_t data)
+{
+    uint64_t z = hash + data + 0x9e3779b97f4a7c15ULL;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);
+}
+
+/**
+ * \brief Hash a number, so that 0 and -0 hash alike.
+ */
+static uint64_t vcjson_value_hash_number(double number)
+{
+    uint64_t bits;
+
+    if (0.0 == number)
+    {
+        number = 0.0;
+    }
+
+    memcpy(&bits, &number, sizeof(bits));
+
+    return bits;
+}
+
+/**
+ * \brief Hash the characters of a string with FNV-1a.
+ *
+ * Object keys are hashed with a per-process seed, so that hash is not used
+ * here; this one must be the same in every process.
+ */
+static uint64_t vcjson_value_hash_string(const vcjson_string* str)
+{
+    const uint8_t* data = (const uint8_t*)str->value;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < str->length; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Hash an object.
+ *
+ * Member hashes are summed, so that the hash does not depend on the order in
+ * which the members are walked, and flat and hash entries need not be sorted.
+ */
+static uint64_t vcjson_value_hash_object(vcjson_object* obj)
+{
+    vcjson_object_cursor iter;
+    const vcjson_string* key;
+    vcjson_value* value;
+    uint64_t sum = 0;
+
+    if (VCJSON_OBJECT_STORAGE_TREE != obj->storage)
+    {
+        for (size_t i = 0; i < obj->count; ++i)
+        {
+            sum +=
+                vcjson_value_hash_mix(
+                    vcjson_value_hash_string(obj->entries[i].key),
+                    vcjson_value_hash(obj->entries[i].value));
+        }
+    }
+    else
+    {
+        vcjson_object_cursor_begin(&iter, obj);
+        while (vcjson_object_cursor_member(&key, &value, obj, &iter))
+        {
+            sum +=
+                vcjson_value_hash_mix(
+                    vcjson_value_hash_string(key), vcjson_value_hash(value));
+
+            vcjson_object_cursor_next(&iter, obj);
+        }
+    }
+
+    return vcjson_value_hash_mix(sum, vcjson_object_elements(obj));
+}
+
+/**
+ * \brief Hash an array, in element order.
+ */
+static uint64_t vcjson_value_hash_array(const vcjson_array* arr)
+{
+    uint64_t hash = arr->elems;
+    uint64_t element;
+
+    for (size_t i = 0; i < arr->elems; ++i)
+    {
+        /* packed numbers hash as the values they would be boxed to. */
+        if (NULL != arr->numbers)
+        {
+            element =
+                vcjson_value_hash_mix(
+                    vcjson_value_hash_mix(0, VCJSON_VALUE_TYPE_NUMBER),
+                    vcjson_value_hash_number(arr->numbers[i]));
+        }
+        else
+        {
+            element = vcjson_value_hash(arr->arr[i]);
+        }
+
+        hash = vcjson_value_hash_mix(hash, element);
+    }
+
+    return hash;
+}
@@ -0,0 +1,138 @@
+/**
+ * \file vcjson_value_set_sensitive.c
+ *
+ * \brief Mark every string in a \ref vcjson_value instance as sensitive.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+/* forward decls. */
+static status vcjson_value_set_sensitive_tree(vcjson_value* value);
+static status vcjson_value_set_sensitive_member(
+    void* context, const vcjson_string* key, vcjson_value* value);
+
+/**
+ * \brief Mark every string in this \ref vcjson_value instance as sensitive.
+ *
+ * A string value is marked directly. For an object or array, every string
+ * value and key within it is marked, at any depth. Emitted forms of this value
+ * and of its containers that are cached are marked as well, so that they are
+ * wiped when they are reset.
+ *
+ * \note Objects and arrays that this value shares with its copies are marked
+ * for every copy.
+ *
+ * \param value         The value instance for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_set_sensitive(vcjson_value* value)
+{
+    status retval;
+
+    /* mark the strings in this value. */
+    retval = vcjson_value_set_sensitive_tree(value);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* A cached container only holds cached containers, so the caches that
+     * hold this value end at the first empty cache. */
+    for (vcjson_emit_cache* cache = value->parent;
+         NULL != cache && NULL != cache->data;
+         cache = cache->parent)
+    {
+        cache->sensitive = true;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Mark the strings in a value and the caches of its containers.
+ *
+ * \param value         The value to mark.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_value_set_sensitive_tree(vcjson_value* value)
+{
+    status retval;
+    vcjson_object* obj;
+    vcjson_array* arr;
+
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_STRING:
+            ((vcjson_string*)value->value)->sensitive = true;
+            return STATUS_SUCCESS;
+
+        case VCJSON_VALUE_TYPE_OBJECT:
+            obj = (vcjson_object*)value->value;
+            if (NULL != obj->cache.data)
+            {
+                obj->cache.sensitive = true;
+            }
+
+            return
+                vcjson_object_foreach(
+                    obj, &vcjson_value_set_sensitive_member, NULL);
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            arr = (vcjson_array*)value->value;
+            if (NULL != arr->cache.data)
+            {
+                arr->cache.sensitive = true;
+            }
+
+            /* a packed array only holds numbers. */
+            if (NULL != arr->numbers)
+            {
+                return STATUS_SUCCESS;
+            }
+
+            for (size_t i = 0; i < arr->elems; ++i)
+            {
+                retval = vcjson_value_set_sensitive_tree(arr->arr[i]);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+            }
+
+            return STATUS_SUCCESS;
+
+        /* other values hold no strings. */
+        default:
+            return STATUS_SUCCESS;
+    }
+}
+
+/**
+ * \brief Mark the key and the strings in the value of an object member.
+ *
+ * \param context       Unused.
+ * \param key           The key of this member.
+ * \param value         The value of this member.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status vcjson_value_set_sensitive_member(
+    void* /*context*/, const vcjson_string* key, vcjson_value* value)
+{
+    ((vcjson_string*)key)->sensitive = true;
+
+    return vcjson_value_set_sensitive_tree(value);
+}
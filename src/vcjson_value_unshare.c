@@ -0,0 +1,130 @@
+/**
+ * \file vcjson_value_unshare.c
+ *
+ * \brief Give a value its own copy of a shared container.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcjson/vcjson.h>
+
+#include "vcjson_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Give the given value its own copy of a shared object or array.
+ *
+ * If the container held by this value is shared with other values, it is
+ * replaced with a copy whose members are in turn shared, so that it can be
+ * modified. If this value then holds the container alone, it is linked to the
+ * cache of the container holding this value.
+ *
+ * \param value         The value to unshare.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - ERROR_VCJSON_VALUE_SHARED if a container holding this value is itself
+ *        shared, so that this value cannot be changed without changing every
+ *        copy.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcjson_value_unshare(vcjson_value* value)
+{
+    status retval;
+    vcjson_object* obj;
+    vcjson_object* objcopy;
+    vcjson_array* arr;
+    vcjson_array* arrcopy;
+
+    /* the containers holding this value must already be its own, since any
+     * change to it is seen through every copy of them. */
+    retval = vcjson_emit_cache_check_exclusive(value->parent);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    switch (value->type)
+    {
+        case VCJSON_VALUE_TYPE_OBJECT:
+            obj = (vcjson_object*)value->value;
+            if (__atomic_load_n(&obj->shares, __ATOMIC_ACQUIRE) > 0
+                && !obj->compact)
+            {
+                /* copy the top level of this object, sharing its members. */
+                retval =
+                    vcjson_object_copy_with(
+                        &objcopy, value->alloc, obj, &vcjson_value_copy);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                /* drop this value's share of the original. */
+                vcjson_emit_cache_unlink(&obj->cache, value);
+
+                retval = resource_release(&obj->hdr);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                value->value = obj = objcopy;
+
+                /* the copy is not cached, so neither may its ancestors be. */
+                retval = vcjson_emit_cache_invalidate(value->parent);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+            }
+
+            /* this value now holds the object alone, so link it. */
+            vcjson_emit_cache_link(&obj->cache, value);
+            break;
+
+        case VCJSON_VALUE_TYPE_ARRAY:
+            arr = (vcjson_array*)value->value;
+            if (__atomic_load_n(&arr->shares, __ATOMIC_ACQUIRE) > 0
+                && !arr->compact)
+            {
+                /* copy the top level of this array, sharing its members. */
+                retval =
+                    vcjson_array_copy_with(
+                        &arrcopy, value->alloc, arr, &vcjson_value_copy);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                /* drop this value's share of the original. */
+                vcjson_emit_cache_unlink(&arr->cache, value);
+
+                retval = resource_release(&arr->hdr);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                value->value = arr = arrcopy;
+
+                /* the copy is not cached, so neither may its ancestors be. */
+                retval = vcjson_emit_cache_invalidate(value->parent);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+            }
+
+            /* this value now holds the array alone, so link it. */
+            vcjson_emit_cache_link(&arr->cache, value);
+            break;
+
+        default:
+            break;
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -26,8 +26,20 @@ vcjson_value_with_resource_release(RCPR_SYM(resource)* r)
     status value_release_retval = STATUS_SUCCESS;
     vcjson_value* value = (vcjson_value*)r;
 
-    /* cache allocator. */
+    /* cache allocator and pool. */
     allocator* alloc = value->alloc;
+    vcjson_pool* pool = value->pool;
+
+    /* a shared container drops its link to this value's parent. */
+    if (VCJSON_VALUE_TYPE_OBJECT == value->type)
+    {
+        vcjson_emit_cache_unlink(
+            &((vcjson_object*)value->value)->cache, value);
+    }
+    else if (VCJSON_VALUE_TYPE_ARRAY == value->type)
+    {
+        vcjson_emit_cache_unlink(&((vcjson_array*)value->value)->cache, value);
+    }
 
     /* release the value associated with this value. */
     if (NULL != value->value)
@@ -40,7 +52,8 @@ vcjson_value_with_resource_release(RCPR_SYM(resource)* r)
     memset(value, 0, sizeof(*value));
 
     /* reclaim memory. */
-    reclaim_retval = allocator_reclaim(alloc, value);
+    reclaim_retval =
+        vcjson_pool_node_reclaim(pool, alloc, value, sizeof(*value));
 
     /* decode return value. */
     if (STATUS_SUCCESS != value_release_retval)
@@ -6,7 +6,9 @@
  * \copyright 2022 Velo Payments, Inc.  All rights reserved.
  */
 
+#include <cstring>
 #include <minunit/minunit.h>
+#include <pthread.h>
 #include <vcjson/vcjson.h>
 
 RCPR_IMPORT_allocator;
@@ -99,3 +101,274 @@ TEST(vcjson_array_set)
         STATUS_SUCCESS
             == resource_release(allocator_resource_handle(alloc)));
 }
+
+/**
+ * Verify that we can grow an array one element at a time.
+ */
+TEST(vcjson_array_append)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* array = nullptr;
+    vcjson_number* number = nullptr;
+    vcjson_value* value = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create an empty array instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_array_create(&array, alloc, 0));
+
+    /* append many numbers. */
+    for (int i = 0; i < 1000; ++i)
+    {
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_number_create(&number, alloc, i));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_value_create_from_number(&value, alloc, number));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(array, value));
+    }
+
+    /* the array holds every number in order. */
+    TEST_ASSERT(1000 == vcjson_array_size(array));
+    for (int i = 0; i < 1000; ++i)
+    {
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&value, array, i));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&number, value));
+        TEST_EXPECT((double)i == vcjson_number_value(number));
+    }
+
+    /* reserving less than the size does nothing. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_reserve(array, 10));
+    TEST_EXPECT(1000 == vcjson_array_size(array));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_array_resource_handle(array)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that we can insert and remove array values.
+ */
+TEST(vcjson_array_insert_remove)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* array = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_string* string = nullptr;
+    char buffer[16];
+    size_t needed = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create an array holding a single null. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_array_create(&array, alloc, 1));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_reserve(array, 4));
+
+    /* insert true before the null, and false after it. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_true(&value, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_insert(array, 0, value));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_false(&value, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_insert(array, 2, value));
+
+    /* inserting past the end is out of bounds. */
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS
+            == vcjson_array_insert(array, 4, value));
+
+    /* insert a string in the middle. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&string, alloc, "x"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_string(&value, alloc, string));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_insert(array, 1, value));
+    TEST_ASSERT(4 == vcjson_array_size(array));
+
+    /* remove the null. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_remove(array, 2));
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS
+            == vcjson_array_remove(array, 3));
+
+    /* the emitted array reflects these changes. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_array(&value, alloc, array));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+    TEST_ASSERT(strlen(R"([true,"x",false])") == needed);
+    TEST_EXPECT(0 == memcmp(R"([true,"x",false])", buffer, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a packed number array boxes values on demand.
+ */
+TEST(vcjson_array_packed)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* array = nullptr;
+    vcjson_array* copy = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* again = nullptr;
+    vcjson_number* number = nullptr;
+    const double* numbers = nullptr;
+    const double NUMBERS[] = { 1.5, 2.25, -3.0 };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a packed array. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_array_create_from_doubles(&array, alloc, NUMBERS, 3));
+    TEST_ASSERT(3 == vcjson_array_size(array));
+
+    /* the numbers can be read directly. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get_doubles(&numbers, array));
+    TEST_EXPECT(0 == memcmp(NUMBERS, numbers, sizeof(NUMBERS)));
+
+    /* an element is boxed once, on demand. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&value, array, 1));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&number, value));
+    TEST_EXPECT(2.25 == vcjson_number_value(number));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&again, array, 1));
+    TEST_EXPECT(value == again);
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS
+            == vcjson_array_get(&value, array, 3));
+
+    /* a copy is also packed. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_copy(&copy, alloc, array));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get_doubles(&numbers, copy));
+    TEST_EXPECT(0 == memcmp(NUMBERS, numbers, sizeof(NUMBERS)));
+
+    /* modifying an array unpacks it. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_true(&value, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(array, value));
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_NOT_PACKED
+            == vcjson_array_get_doubles(&numbers, array));
+    TEST_ASSERT(4 == vcjson_array_size(array));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&value, array, 2));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&number, value));
+    TEST_EXPECT(-3.0 == vcjson_number_value(number));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_array_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_array_resource_handle(array)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Arguments for a thread boxing the elements of a packed array.
+ */
+struct packed_get_thread_args
+{
+    vcjson_array* array;
+    vcjson_value* values[256];
+    status retval;
+};
+
+/**
+ * \brief Get every element of the packed array.
+ */
+static void* packed_get_thread(void* context)
+{
+    packed_get_thread_args* args = (packed_get_thread_args*)context;
+
+    args->retval = STATUS_SUCCESS;
+    for (size_t i = 0; i < 256 && STATUS_SUCCESS == args->retval; ++i)
+    {
+        args->retval = vcjson_array_get(&args->values[i], args->array, i);
+    }
+
+    return nullptr;
+}
+
+/**
+ * Verify that the elements of a packed array can be boxed on several threads
+ * at once, and that every thread gets the same value for an element.
+ */
+TEST(vcjson_array_packed_get_threads)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* array = nullptr;
+    vcjson_number* number = nullptr;
+    double numbers[256];
+    pthread_t threads[4];
+    packed_get_thread_args args[4];
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a packed array. */
+    for (size_t i = 0; i < 256; ++i)
+    {
+        numbers[i] = (double)i;
+    }
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_array_create_from_doubles(&array, alloc, numbers, 256));
+
+    /* box its elements on several threads at once. */
+    for (int i = 0; i < 4; ++i)
+    {
+        args[i].array = array;
+        TEST_ASSERT(
+            0
+                == pthread_create(
+                        &threads[i], nullptr, &packed_get_thread, &args[i]));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], nullptr));
+        TEST_ASSERT(STATUS_SUCCESS == args[i].retval);
+    }
+
+    /* every thread got the same boxed value for each element. */
+    for (size_t i = 0; i < 256; ++i)
+    {
+        for (int j = 1; j < 4; ++j)
+        {
+            TEST_EXPECT(args[0].values[i] == args[j].values[i]);
+        }
+
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_value_get_number(&number, args[0].values[i]));
+        TEST_EXPECT((double)i == vcjson_number_value(number));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_array_resource_handle(array)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
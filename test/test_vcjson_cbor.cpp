@@ -0,0 +1,388 @@
+/**
+ * \file test/test_vcjson_cbor.cpp
+ *
+ * \brief Unit tests for vcjson_emit_cbor and vcjson_parse_cbor.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_cbor);
+
+namespace {
+
+struct test_sink
+{
+    uint8_t buffer[16384];
+    size_t offset;
+    size_t writes;
+};
+
+status test_sink_write(void* context, const void* data, size_t size)
+{
+    test_sink* sink = (test_sink*)context;
+
+    if (sink->offset + size > sizeof(sink->buffer))
+    {
+        return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+    }
+
+    memcpy(sink->buffer + sink->offset, data, size);
+    sink->offset += size;
+    ++sink->writes;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Emit the given value as CBOR and compare it to the expected bytes.
+ */
+bool emits_as(vcjson_value* value, const char* expected, size_t size)
+{
+    test_sink sink;
+
+    sink.offset = sink.writes = 0;
+
+    return
+        STATUS_SUCCESS == vcjson_emit_cbor(value, &test_sink_write, &sink)
+     && size == sink.offset
+     && 0 == memcmp(expected, sink.buffer, size);
+}
+
+/**
+ * \brief Parse the given JSON input, or return nullptr.
+ */
+vcjson_value* parse(allocator* alloc, const char* input)
+{
+    vcjson_value* value = nullptr;
+    size_t error_begin, error_end;
+
+    if (STATUS_SUCCESS
+            != vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, input))
+    {
+        return nullptr;
+    }
+
+    return value;
+}
+
+/**
+ * \brief Release the given value.
+ */
+bool release(vcjson_value* value)
+{
+    return
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(value));
+}
+
+} /* namespace */
+
+/**
+ * Verify that values are emitted using the RFC 8949 preferred serialization.
+ */
+TEST(vcjson_emit_cbor_preferred)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    const struct { double number; const char* expected; size_t size; }
+    NUMBERS[] = {
+        { 0.0, "\x00", 1 },
+        { 23.0, "\x17", 1 },
+        { 24.0, "\x18\x18", 2 },
+        { 1000.0, "\x19\x03\xe8", 3 },
+        { 100000.0, "\x1a\x00\x01\x86\xa0", 5 },
+        { 1000000000000.0, "\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00", 9 },
+        { -1.0, "\x20", 1 },
+        { -1000.0, "\x39\x03\xe7", 3 },
+        { -0.0, "\xf9\x80\x00", 3 },
+        { 1.5, "\xf9\x3e\x00", 3 },
+        { 5.960464477539063e-8, "\xf9\x00\x01", 3 },
+        { 0.00006103515625, "\xf9\x04\x00", 3 },
+        { 100000.5, "\xfa\x47\xc3\x50\x40", 5 },
+        { 3.4028234663852886e+38, "\xfa\x7f\x7f\xff\xff", 5 },
+        { 1.1, "\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a", 9 },
+        { 1.0e+300, "\xfb\x7e\x37\xe4\x3c\x88\x00\x75\x9c", 9 },
+    };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* each number uses its shortest exact form. */
+    for (size_t i = 0; i < sizeof(NUMBERS) / sizeof(NUMBERS[0]); ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_value_create_number(
+                        &value, alloc, NUMBERS[i].number));
+        TEST_EXPECT(emits_as(value, NUMBERS[i].expected, NUMBERS[i].size));
+        TEST_ASSERT(release(value));
+    }
+
+    /* literals, strings, and containers. */
+    value = parse(alloc, R"([true,false,null,"a",[1,[2,3]]])");
+    TEST_ASSERT(nullptr != value);
+    TEST_EXPECT(
+        emits_as(value, "\x85\xf5\xf4\xf6\x61\x61\x82\x01\x82\x02\x03", 11));
+    TEST_ASSERT(release(value));
+
+    /* object members are emitted in sorted order. */
+    value = parse(alloc, R"({"b":[2,3],"a":1})");
+    TEST_ASSERT(nullptr != value);
+    TEST_EXPECT(
+        emits_as(value, "\xa2\x61\x61\x01\x61\x62\x82\x02\x03", 9));
+    TEST_ASSERT(release(value));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that values survive a round trip through CBOR.
+ */
+TEST(vcjson_cbor_round_trip)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* decoded = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_array* arr = nullptr;
+    const double* numbers;
+    char input[8192];
+    size_t offset, error_offset;
+    test_sink sink;
+
+    /* build a document with a wide object and a long string. */
+    offset =
+        snprintf(
+            input, sizeof(input),
+            R"({"n":[0,-0,1.5,0.1,-7,1e300,18446744073709549568,)"
+            R"(-9007199254740992],"s":"café 😀","l":")");
+    for (int i = 0; i < 500; ++i)
+    {
+        offset +=
+            snprintf(input + offset, sizeof(input) - offset, "0123456789");
+    }
+    offset += snprintf(input + offset, sizeof(input) - offset, R"(","w":{)");
+    for (int i = 0; i < 40; ++i)
+    {
+        offset +=
+            snprintf(
+                input + offset, sizeof(input) - offset,
+                R"(%s"k%02d":[%d,"v"])", (0 == i) ? "" : ",", 39 - i, i);
+    }
+    snprintf(
+        input + offset, sizeof(input) - offset, R"(},"t":true,"z":null})");
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse it and emit it as CBOR. */
+    value = parse(alloc, input);
+    TEST_ASSERT(nullptr != value);
+    sink.offset = sink.writes = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_emit_cbor(value, &test_sink_write, &sink));
+
+    /* the encoding is streamed to the sink in pieces. */
+    TEST_EXPECT(sink.writes > 1);
+
+    /* decoding it gives an equal value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_cbor(
+                    &decoded, &error_offset, alloc, sink.buffer, sink.offset,
+                    0));
+    TEST_EXPECT(vcjson_value_equal(value, decoded));
+
+    /* arrays holding only numbers are packed. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, decoded));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "n"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get_doubles(&numbers, arr));
+    TEST_EXPECT(18446744073709549568.0 == numbers[6]);
+    TEST_EXPECT(-9007199254740992.0 == numbers[7]);
+
+    /* clean up. */
+    TEST_ASSERT(release(decoded));
+    TEST_ASSERT(release(value));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that indefinite-length items, tags, and every float width decode.
+ */
+TEST(vcjson_parse_cbor_forms)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* expected = nullptr;
+    size_t error_offset;
+    const struct { const char* input; size_t size; const char* json; }
+    FORMS[] = {
+        /* indefinite-length arrays, maps, and strings. */
+        { "\x9f\x01\x82\x02\x03\x9f\x04\x05\xff\xff", 10, "[1,[2,3],[4,5]]" },
+        { "\xbf\x61\x61\x01\x61\x62\x9f\x02\x03\xff\xff", 11,
+          R"({"a":1,"b":[2,3]})" },
+        { "\x7f\x65strea\x64ming\xff", 13, R"("streaming")" },
+        { "\x7f\xff", 2, R"("")" },
+        /* mixed arrays, with leading numbers. */
+        { "\x83\x01\xf9\x3e\x00\x61x", 7, R"([1,1.5,"x"])" },
+        /* tags are skipped, and undefined is null. */
+        { "\xc1\x1a\x51\x4b\x67\xb0", 6, "1363896240" },
+        { "\x82\xf7\xd8\x20\x61u", 6, R"([null,"u"])" },
+        /* every float width. */
+        { "\x83\xf9\xc4\x00\xfa\x47\xc3\x50\x00\xfb\x3f\xf1\x99\x99\x99\x99"
+          "\x99\x9a", 18, "[-4,100000,1.1]" },
+        /* long arguments need not be the shortest. */
+        { "\x1b\x00\x00\x00\x00\x00\x00\x00\x18", 9, "24" },
+        { "\x3a\x00\x00\x00\x63", 5, "-100" },
+        { "\x80", 1, "[]" },
+        { "\xa0", 1, "{}" },
+    };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    for (size_t i = 0; i < sizeof(FORMS) / sizeof(FORMS[0]); ++i)
+    {
+        expected = parse(alloc, FORMS[i].json);
+        TEST_ASSERT(nullptr != expected);
+
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_parse_cbor(
+                        &value, &error_offset, alloc, FORMS[i].input,
+                        FORMS[i].size, 0));
+        TEST_EXPECT(vcjson_value_equal(expected, value));
+
+        TEST_ASSERT(release(value));
+        TEST_ASSERT(release(expected));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that malformed, truncated, and unsupported input is rejected.
+ */
+TEST(vcjson_parse_cbor_errors)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_offset;
+    uint8_t deep[VCJSON_PARSER_MAXIMUM_RECURSION_DEPTH + 1];
+    const struct { const char* input; size_t size; status error; size_t at; }
+    ERRORS[] = {
+        { "", 0, ERROR_VCJSON_CBOR_TRUNCATED, 0 },
+        { "\x19\x03", 2, ERROR_VCJSON_CBOR_TRUNCATED, 0 },
+        { "\x82\x01\x63" "ab", 5, ERROR_VCJSON_CBOR_TRUNCATED, 2 },
+        { "\x9f\x01", 2, ERROR_VCJSON_CBOR_TRUNCATED, 0 },
+        { "\x82\x01\x1c", 3, ERROR_VCJSON_CBOR_MALFORMED, 2 },
+        { "\x1f", 1, ERROR_VCJSON_CBOR_MALFORMED, 0 },
+        { "\xff", 1, ERROR_VCJSON_CBOR_MALFORMED, 0 },
+        { "\x01\x01", 2, ERROR_VCJSON_CBOR_MALFORMED, 1 },
+        { "\x7f\x01\xff", 3, ERROR_VCJSON_CBOR_MALFORMED, 0 },
+        { "\x82\x01\x41\x00", 4, ERROR_VCJSON_CBOR_UNSUPPORTED, 2 },
+        { "\xa1\x01\x02", 3, ERROR_VCJSON_CBOR_UNSUPPORTED, 1 },
+        { "\xf0", 1, ERROR_VCJSON_CBOR_UNSUPPORTED, 0 },
+        { "\x81\xf9\x7c\x00", 4, ERROR_VCJSON_CBOR_UNSUPPORTED, 1 },
+        { "\xa2\x61\x61\x01\x61\x61\x02", 7,
+          ERROR_VCJSON_OBJECT_DUPLICATE_KEY, 0 },
+    };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* each input fails with its error, at the offending item. */
+    for (size_t i = 0; i < sizeof(ERRORS) / sizeof(ERRORS[0]); ++i)
+    {
+        TEST_EXPECT(
+            ERRORS[i].error
+                == vcjson_parse_cbor(
+                        &value, &error_offset, alloc, ERRORS[i].input,
+                        ERRORS[i].size, 0));
+        TEST_EXPECT(ERRORS[i].at == error_offset);
+    }
+
+    /* nesting is limited, as it is for JSON. */
+    memset(deep, 0x81, sizeof(deep) - 1);
+    deep[sizeof(deep) - 1] = 0xf6;
+    TEST_EXPECT(
+        ERROR_VCJSON_PARSE_RECURSION_DEPTH_EXCEEDED
+            == vcjson_parse_cbor(
+                    &value, &error_offset, alloc, deep, sizeof(deep), 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_cbor(
+                    &value, &error_offset, alloc, deep + 1, sizeof(deep) - 1,
+                    0));
+    TEST_ASSERT(release(value));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that the parse flags apply to decoded values.
+ */
+TEST(vcjson_parse_cbor_flags)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_string* string = nullptr;
+    size_t error_offset;
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* members keep their input order if requested. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_cbor(
+                    &value, &error_offset, alloc,
+                    "\xa2\x61\x62\x01\x61\x61\x02", 7,
+                    VCJSON_PARSE_FLAG_INSERTION_ORDER));
+
+    /* they are emitted in that order. */
+    sink.offset = sink.writes = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_emit_cbor(value, &test_sink_write, &sink));
+    TEST_EXPECT(
+        7 == sink.offset
+     && !memcmp("\xa2\x61\x62\x01\x61\x61\x02", sink.buffer, 7));
+    TEST_ASSERT(release(value));
+
+    /* strings are sensitive if requested. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_cbor(
+                    &value, &error_offset, alloc, "\xa1\x61k\x61v", 5,
+                    VCJSON_PARSE_FLAG_SENSITIVE));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "k"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_string(&string, member));
+    TEST_EXPECT(vcjson_string_is_sensitive(string));
+    TEST_ASSERT(release(value));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -9,6 +9,7 @@
 #include <minunit/minunit.h>
 #include <vcjson/vcjson.h>
 #include <cstring>
+#include <pthread.h>
 
 using namespace std;
 
@@ -89,3 +90,511 @@ TEST(copy_string)
     resource_release(vcjson_string_resource_handle(copyval));
     resource_release(allocator_resource_handle(alloc));
 }
+
+/**
+ * Test that copying a value shares its containers until they are modified.
+ */
+TEST(copy_value_shares_containers)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* origobj = nullptr;
+    vcjson_object* copyobj = nullptr;
+    vcjson_object* inner = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"b":["x",true]},"c":{"d":true}})";
+    const char* EXPECTED_COPY = R"({"a":{"b":["x",true,null],"e":false},)"
+                                R"("c":{"d":true}})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the original value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+
+    /* get the original object before copying. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&origobj, orig));
+
+    /* copy the value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, orig));
+
+    /* the original object is now shared, so it can't be modified. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "z"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_EXPECT(
+        ERROR_VCJSON_VALUE_SHARED == vcjson_object_put(origobj, key, newval));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+
+    /* the plain getter returns the shared object without copying it. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&copyobj, copy));
+    TEST_EXPECT(copyobj == origobj);
+
+    /* fetching the copy's object to modify it gives it its own top level. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&copyobj, copy));
+    TEST_EXPECT(copyobj != origobj);
+
+    /* modify a nested object and array of the copy. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_get_cstr(&member, copyobj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&inner, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "e"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_false(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(inner, key, newval));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, inner, "b"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array_mut(&arr, member));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(arr, newval));
+
+    /* the copy reflects these changes. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copy));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED_COPY) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED_COPY, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* the original is unchanged. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, orig));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* releasing the original leaves the copy intact. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copy));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED_COPY) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED_COPY, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that containers nested in a shared container are shared as well, and
+ * can only be modified after each container on their path is unshared.
+ */
+TEST(copy_value_nested_containers_shared)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_object* inner = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"b":true}})";
+    const char* EXPECTED_COPY = R"({"a":{"b":true,"c":null}})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the original value and copy it. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "c"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+
+    /* the nested object can't be modified through the plain getters. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&inner, member));
+    TEST_EXPECT(
+        ERROR_VCJSON_VALUE_SHARED == vcjson_object_put(inner, key, newval));
+
+    /* nor can it be unshared before the object holding it. */
+    TEST_EXPECT(
+        ERROR_VCJSON_VALUE_SHARED
+            == vcjson_value_get_object_mut(&inner, member));
+
+    /* the same holds for the original. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&inner, member));
+    TEST_EXPECT(
+        ERROR_VCJSON_VALUE_SHARED == vcjson_object_put(inner, key, newval));
+
+    /* fetching each container on the path with the _mut getters works. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&obj, copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&inner, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(inner, key, newval));
+
+    /* the copy reflects this change. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copy));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED_COPY) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED_COPY, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* the original is unchanged. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, orig));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that copying an object copies its members instead of sharing them.
+ */
+TEST(copy_object_is_deep)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* origobj = nullptr;
+    vcjson_object* copy = nullptr;
+    vcjson_array* arr = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"b":["x",true]}})";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the original value, and copy its object. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&origobj, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_copy(&copy, alloc, origobj));
+
+    /* the nested array of the copy is its own, and can be modified. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, copy, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&origobj, member));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_get_cstr(&member, origobj, "b"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, member));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(arr, newval));
+    TEST_EXPECT(3 == vcjson_array_size(arr));
+
+    /* the original's nested array is unchanged, and can also be modified. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&origobj, orig));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_get_cstr(&member, origobj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&origobj, member));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_get_cstr(&member, origobj, "b"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, member));
+    TEST_EXPECT(2 == vcjson_array_size(arr));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(arr, newval));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that copying a value with another allocator does not share containers.
+ */
+TEST(copy_value_other_allocator)
+{
+    allocator* alloc = nullptr;
+    allocator* otheralloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* origobj = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"b":["x",true]},"c":null})";
+    const char* output;
+    size_t output_length;
+
+    /* create two malloc allocators. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&otheralloc));
+
+    /* parse the original value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&origobj, orig));
+
+    /* copy the value with the other allocator. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_copy(&copy, otheralloc, orig));
+
+    /* the original object is not shared, so it can still be modified. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "z"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(origobj, key, newval));
+
+    /* the copy outlives the original and its allocator. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, otheralloc, copy));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(otheralloc)));
+}
+
+/**
+ * \brief Arguments for a thread copying and releasing a shared value.
+ */
+struct copy_thread_args
+{
+    allocator* alloc;
+    vcjson_value* orig;
+    status retval;
+};
+
+/**
+ * \brief Copy and release the shared value many times.
+ */
+static void* copy_thread(void* context)
+{
+    copy_thread_args* args = (copy_thread_args*)context;
+    vcjson_value* copy;
+
+    args->retval = STATUS_SUCCESS;
+    for (int i = 0; i < 1000 && STATUS_SUCCESS == args->retval; ++i)
+    {
+        args->retval = vcjson_value_copy(&copy, args->alloc, args->orig);
+        if (STATUS_SUCCESS == args->retval)
+        {
+            args->retval = resource_release(vcjson_value_resource_handle(copy));
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Test that copies of a value can be made and released on several threads.
+ */
+TEST(copy_value_threads)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_string* str = nullptr;
+    pthread_t threads[4];
+    copy_thread_args args[4];
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"b":["x",true]},"c":{"d":null}})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the original value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+
+    /* copy and release it on several threads at once. */
+    for (int i = 0; i < 4; ++i)
+    {
+        args[i].alloc = alloc;
+        args[i].orig = orig;
+        TEST_ASSERT(
+            0 == pthread_create(&threads[i], nullptr, &copy_thread, &args[i]));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], nullptr));
+        TEST_EXPECT(STATUS_SUCCESS == args[i].retval);
+    }
+
+    /* the original is intact, and is no longer shared. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, orig));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a compact copy holds the same document, and is read-only.
+ */
+TEST(copy_value_compact)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* element = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_value* shared = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_object* wide = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_number* number = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* origstr = nullptr;
+    vcjson_string* copystr = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    char input[2048];
+    size_t offset;
+    const char* origtext;
+    const char* copytext;
+    size_t origlength, copylength;
+
+    /* build a document holding a wide object, so that it is hashed. */
+    offset =
+        snprintf(
+            input, sizeof(input),
+            R"({"list":[1,2,3],"mixed":["x",true,null,{"y":"z"}],"wide":{)");
+    for (int i = 0; i < 40; ++i)
+    {
+        offset +=
+            snprintf(
+                input + offset, sizeof(input) - offset, R"(%s"k%02d":"v%d")",
+                (0 == i) ? "" : ",", i, i);
+    }
+    snprintf(input + offset, sizeof(input) - offset, "}}");
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the original value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, input));
+
+    /* make a compact copy. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_copy_compact(&copy, alloc, orig));
+
+    /* the copy emits the same text as the original. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&origstr, alloc, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&copystr, alloc, copy));
+    origtext = vcjson_string_value(origstr, &origlength);
+    copytext = vcjson_string_value(copystr, &copylength);
+    TEST_ASSERT(origlength == copylength);
+    TEST_EXPECT(0 == memcmp(origtext, copytext, origlength));
+
+    /* members of the wide object can be looked up. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "wide"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&wide, member));
+    TEST_EXPECT(40 == vcjson_object_elements(wide));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, wide, "k17"));
+    TEST_EXPECT(VCJSON_VALUE_TYPE_STRING == vcjson_value_type(member));
+
+    /* packed numbers are kept packed, and are already boxed. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "list"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&element, arr, 2));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&number, element));
+    TEST_EXPECT(3 == vcjson_number_value(number));
+
+    /* the copy is read-only. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "z"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_EXPECT(
+        ERROR_VCJSON_VALUE_SHARED == vcjson_object_put(wide, key, newval));
+    TEST_EXPECT(ERROR_VCJSON_VALUE_SHARED == vcjson_array_append(arr, newval));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+
+    /* a value copied from the copy can be modified. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&shared, alloc, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, shared));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(arr, newval));
+    TEST_EXPECT(4 == vcjson_array_size(arr));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(shared)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(copystr)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(origstr)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,150 @@
+/**
+ * \file test/test_vcjson_emit_buffer.cpp
+ *
+ * \brief Unit tests for vcjson_emit_buffer.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_emit_buffer);
+
+/**
+ * Verify that we can emit a value into a buffer that is large enough.
+ */
+TEST(vcjson_emit_buffer_fits)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":[true,false,null],"b":"x\ny"})";
+    char buffer[128];
+    size_t needed = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* we can emit this value into the buffer. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+
+    /* the needed size should match the input. */
+    TEST_ASSERT(needed == strlen(INPUT));
+    /* the emitted text should match the input. */
+    TEST_EXPECT(0 == memcmp(INPUT, buffer, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a buffer of exactly the needed size is large enough.
+ */
+TEST(vcjson_emit_buffer_exact_size)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"(["foo","bar"])";
+    char buffer[13];
+    size_t needed = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* we can emit this value into the buffer. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+
+    /* the needed size should match the buffer size. */
+    TEST_ASSERT(sizeof(buffer) == needed);
+    /* the emitted text should match the input. */
+    TEST_EXPECT(0 == memcmp(INPUT, buffer, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that an undersized buffer reports the needed size.
+ */
+TEST(vcjson_emit_buffer_overrun)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"1":"foo","2":"bar","3":"baz"})";
+    char buffer[8];
+    char exact[64];
+    size_t needed = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* emitting to a small buffer fails. */
+    TEST_ASSERT(
+        ERROR_VCJSON_EMIT_BUFFER_OVERRUN
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+
+    /* the needed size is still reported. */
+    TEST_ASSERT(needed == strlen(INPUT));
+
+    /* a size query with no buffer also reports the needed size. */
+    needed = 0;
+    TEST_ASSERT(
+        ERROR_VCJSON_EMIT_BUFFER_OVERRUN
+            == vcjson_emit_buffer(value, nullptr, 0, &needed));
+    TEST_ASSERT(needed == strlen(INPUT));
+
+    /* a buffer of the reported size works. */
+    TEST_ASSERT(needed <= sizeof(exact));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_emit_buffer(value, exact, needed, &needed));
+    TEST_EXPECT(0 == memcmp(INPUT, exact, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,381 @@
+/**
+ * \file test/test_vcjson_emit_cache.cpp
+ *
+ * \brief Unit tests for vcjson_emit_cache_update.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+#include "../src/vcjson_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_emit_cache);
+
+/**
+ * Verify that a memoized value emits the same text.
+ */
+TEST(vcjson_emit_cache_update_basics)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":[true,{"b":"x\ny"}],"c":{}})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* we can memoize this value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+
+    /* the root object is memoized. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+    TEST_ASSERT(nullptr != obj->cache.data);
+    TEST_EXPECT(strlen(INPUT) == obj->cache.size);
+
+    /* updating again is a no-op. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+
+    /* the emitted text matches the input. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that modifying a member only invalidates the changed path.
+ */
+TEST(vcjson_emit_cache_object_put_invalidates_path)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* root = nullptr;
+    vcjson_object* a = nullptr;
+    vcjson_object* b = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"x":true},"b":{"y":false}})";
+    const char* EXPECTED = R"({"a":{"x":null},"b":{"y":false}})";
+    const char* output;
+    size_t output_length;
+    const char* b_data;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* we can memoize this value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+
+    /* get the member objects. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&root, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get(&member, root, key));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&a, member));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "b"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get(&member, root, key));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&b, member));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+    b_data = b->cache.data;
+    TEST_ASSERT(nullptr != b_data);
+
+    /* replace a.x with null. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "x"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(a, key, newval));
+
+    /* a and the root are invalidated, but b is not. */
+    TEST_EXPECT(nullptr == a->cache.data);
+    TEST_EXPECT(nullptr == root->cache.data);
+    TEST_EXPECT(b_data == b->cache.data);
+
+    /* updating only rebuilds the changed path. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+    TEST_EXPECT(nullptr != a->cache.data);
+    TEST_EXPECT(nullptr != root->cache.data);
+    TEST_EXPECT(b_data == b->cache.data);
+
+    /* the emitted text reflects the change. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that removing a member or setting an array element invalidates the
+ * memoized form.
+ */
+TEST(vcjson_emit_cache_remove_and_array_set_invalidate)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* root = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":[false,false],"b":true})";
+    const char* EXPECTED = R"({"a":[false,true]})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* we can memoize this value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+
+    /* remove b. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&root, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "b"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(root, key));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+    TEST_EXPECT(nullptr == root->cache.data);
+
+    /* memoize the value again. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+    TEST_ASSERT(nullptr != root->cache.data);
+
+    /* set a[1] to true. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get(&member, root, key));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_create_from_true(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_set(arr, 1, newval));
+    TEST_EXPECT(nullptr == arr->cache.data);
+    TEST_EXPECT(nullptr == root->cache.data);
+
+    /* the emitted text reflects both changes. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that modifying a shared member of a copy invalidates the memoized form
+ * of the copy, but not of the original.
+ */
+TEST(vcjson_emit_cache_copy_invalidates_path)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* root = nullptr;
+    vcjson_object* a = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"x":true},"b":{"y":false}})";
+    const char* EXPECTED = R"({"a":{"x":null},"b":{"y":false}})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse and memoize the original. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(orig));
+
+    /* copy it, and memoize the copy's own top level. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&root, copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(copy));
+    TEST_EXPECT(nullptr != root->cache.data);
+
+    /* fetching the shared member for modification invalidates the copy. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, root, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&a, member));
+    TEST_EXPECT(nullptr == root->cache.data);
+
+    /* replace a.x with null, and memoize the copy again. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "x"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(a, key, newval));
+    TEST_EXPECT(nullptr == root->cache.data);
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(copy));
+
+    /* the copy reflects the change. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copy));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* the original does not. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, orig));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that when one value unshares a container, modifying it through the
+ * other value invalidates that value's path.
+ */
+TEST(vcjson_emit_cache_unshare_relinks_remaining_value)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* orig = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_value* newval = nullptr;
+    vcjson_object* root = nullptr;
+    vcjson_object* a = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"x":true}})";
+    const char* EXPECTED = R"({"a":{"x":null}})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the original, copy it, and give the copy its own top level. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &orig, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&root, copy));
+
+    /* memoize both; the object under "a" is shared between them. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(copy));
+    TEST_EXPECT(nullptr != root->cache.data);
+
+    /* the original unshares its "a", leaving the copy to hold it alone. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&a, orig));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, a, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&a, member));
+
+    /* the copy's "a" can't be modified before it is relinked. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "x"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_create_from_null(&newval, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, root, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&a, member));
+    TEST_EXPECT(ERROR_VCJSON_VALUE_SHARED == vcjson_object_put(a, key, newval));
+
+    /* fetching it for modification relinks it to the copy's root. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object_mut(&a, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(a, key, newval));
+    TEST_EXPECT(nullptr == root->cache.data);
+
+    /* the copy reflects the change. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copy));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* the original does not. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, orig));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(INPUT) == output_length);
+    TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(orig)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,387 @@
+/**
+ * \file test/test_vcjson_emit_canonical.cpp
+ *
+ * \brief Unit tests for vcjson_emit_canonical.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+#include "../src/vcjson_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_emit_canonical);
+
+namespace {
+
+struct test_sink
+{
+    char buffer[8192];
+    size_t offset;
+};
+
+status test_sink_write(void* context, const void* data, size_t size)
+{
+    test_sink* sink = (test_sink*)context;
+
+    if (sink->offset + size > sizeof(sink->buffer))
+    {
+        return ERROR_VCJSON_EMIT_BUFFER_OVERRUN;
+    }
+
+    memcpy(sink->buffer + sink->offset, data, size);
+    sink->offset += size;
+
+    return STATUS_SUCCESS;
+}
+
+} /* namespace */
+
+/**
+ * Verify that numbers are emitted in the ECMAScript form.
+ */
+TEST(vcjson_emit_canonical_numbers)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_number* number = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* elem = nullptr;
+    const double NUMBERS[] = {
+        0.0, -0.0, 1.0, -1.0, 4.5, 0.002, 1e-6, 1e-7, 1e20, 1e21, 1e30,
+        333333333.3333333, 5e-324, 1.7976931348623157e308, 0.1, 123.456,
+        -1.5e-10 };
+    const char* EXPECTED =
+        "[0,0,1,-1,4.5,0.002,0.000001,1e-7,100000000000000000000,1e+21,"
+        "1e+30,333333333.3333333,5e-324,1.7976931348623157e+308,0.1,123.456,"
+        "-1.5e-10]";
+    const size_t count = sizeof(NUMBERS) / sizeof(NUMBERS[0]);
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create an array of these numbers. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_create(&arr, alloc, count));
+    for (size_t i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_number_create(&number, alloc, NUMBERS[i]));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_value_create_from_number(&elem, alloc, number));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_array_set(arr, i, elem));
+    }
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_array(&value, alloc, arr));
+
+    /* emit the canonical form. */
+    sink.offset = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_canonical(value, &test_sink_write, &sink));
+    TEST_ASSERT(strlen(EXPECTED) == sink.offset);
+    TEST_EXPECT(0 == memcmp(EXPECTED, sink.buffer, sink.offset));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that non-finite numbers can't be emitted.
+ */
+TEST(vcjson_emit_canonical_non_finite)
+{
+    allocator* alloc = nullptr;
+    vcjson_number* number = nullptr;
+    vcjson_value* value = nullptr;
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create an infinite number. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_number_create(&number, alloc, __builtin_inf()));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_number(&value, alloc, number));
+
+    /* emission fails. */
+    sink.offset = 0;
+    TEST_EXPECT(
+        ERROR_VCJSON_EMIT_NUMBER_FORMAT
+            == vcjson_emit_canonical(value, &test_sink_write, &sink));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that strings use the JCS escapes.
+ */
+TEST(vcjson_emit_canonical_string_escapes)
+{
+    allocator* alloc = nullptr;
+    vcjson_string* str = nullptr;
+    vcjson_value* value = nullptr;
+    const char* INPUT = "\xe2\x82\xac$\x0f\nA'B\"\\\\\"/";
+    const char* EXPECTED = "\"\xe2\x82\xac$\\u000f\\nA'B\\\"\\\\\\\\\\\"/\"";
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create the string value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&str, alloc, INPUT));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_string(&value, alloc, str));
+
+    /* emit the canonical form. */
+    sink.offset = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_canonical(value, &test_sink_write, &sink));
+    TEST_ASSERT(strlen(EXPECTED) == sink.offset);
+    TEST_EXPECT(0 == memcmp(EXPECTED, sink.buffer, sink.offset));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that object members are sorted by UTF-16 code units.
+ */
+TEST(vcjson_emit_canonical_utf16_key_order)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* elem = nullptr;
+    const char* KEYS[] = {
+        "\xe2\x82\xac", "\r", "\xef\xac\xb3", "1", "\xf0\x9f\x98\x80",
+        "\xc2\x80", "\xc3\xb6" };
+    const char* EXPECTED =
+        "{\"\\r\":true,\"1\":true,\"\xc2\x80\":true,\"\xc3\xb6\":true,"
+        "\"\xe2\x82\xac\":true,\"\xf0\x9f\x98\x80\":true,"
+        "\"\xef\xac\xb3\":true}";
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create an object with these keys. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_create(&obj, alloc));
+    for (const char* k : KEYS)
+    {
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, k));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_value_create_from_true(&elem, alloc));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(obj, key, elem));
+    }
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_object(&value, alloc, obj));
+
+    /* emit the canonical form. */
+    sink.offset = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_canonical(value, &test_sink_write, &sink));
+    TEST_ASSERT(strlen(EXPECTED) == sink.offset);
+    TEST_EXPECT(0 == memcmp(EXPECTED, sink.buffer, sink.offset));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify the SHA-256 implementation against the FIPS 180-4 test vectors.
+ */
+TEST(vcjson_sha256_vectors)
+{
+    vcjson_sha256_context ctx;
+    uint8_t digest[VCJSON_SHA256_DIGEST_SIZE];
+    const char* TWO_BLOCK =
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const uint8_t EXPECTED_ABC[VCJSON_SHA256_DIGEST_SIZE] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+        0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+        0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+    const uint8_t EXPECTED_TWO_BLOCK[VCJSON_SHA256_DIGEST_SIZE] = {
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8,
+        0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+        0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+        0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 };
+
+    /* hash "abc". */
+    vcjson_sha256_init(&ctx);
+    vcjson_sha256_update(&ctx, "abc", 3);
+    vcjson_sha256_final(&ctx, digest);
+    TEST_EXPECT(0 == memcmp(EXPECTED_ABC, digest, sizeof(digest)));
+
+    /* hash the two block message one byte at a time. */
+    vcjson_sha256_init(&ctx);
+    for (size_t i = 0; i < strlen(TWO_BLOCK); ++i)
+    {
+        vcjson_sha256_update(&ctx, TWO_BLOCK + i, 1);
+    }
+    vcjson_sha256_final(&ctx, digest);
+    TEST_EXPECT(0 == memcmp(EXPECTED_TWO_BLOCK, digest, sizeof(digest)));
+}
+
+/**
+ * Verify that the canonical digest matches the digest of the canonical text.
+ */
+TEST(vcjson_emit_canonical_sha256_digest)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_number* number = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* elem = nullptr;
+    char payload[5001];
+    uint8_t digest[VCJSON_SHA256_DIGEST_SIZE];
+    /* SHA-256 of {"a":1.5,"b":"yyy...y"}, with 5000 y characters. */
+    const uint8_t EXPECTED[VCJSON_SHA256_DIGEST_SIZE] = {
+        0x7c, 0x5e, 0x3f, 0x1d, 0x01, 0xea, 0xf1, 0xca,
+        0x5f, 0x9c, 0x7a, 0x22, 0x93, 0x19, 0x16, 0xce,
+        0x1d, 0x89, 0xb0, 0x93, 0x88, 0x83, 0x4c, 0x43,
+        0xb8, 0x1e, 0x52, 0x15, 0x3d, 0x09, 0x7b, 0x8a };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* build the object. */
+    memset(payload, 'y', sizeof(payload) - 1);
+    payload[sizeof(payload) - 1] = 0;
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_create(&obj, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "b"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&str, alloc, payload));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_string(&elem, alloc, str));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(obj, key, elem));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_number_create(&number, alloc, 1.5));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_number(&elem, alloc, number));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(obj, key, elem));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_object(&value, alloc, obj));
+
+    /* compute the digest. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_emit_canonical_sha256(digest, value));
+    TEST_EXPECT(0 == memcmp(EXPECTED, digest, sizeof(digest)));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that objects kept in insertion order are still emitted sorted.
+ */
+TEST(vcjson_emit_canonical_insertion_order)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_begin, error_end;
+    const char* INPUT = R"({"z":true,"a":{"y":null,"b":false}})";
+    const char* EXPECTED = R"({"a":{"b":false,"y":null},"z":true})";
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the input in document order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_with_flags(
+                    &value, &error_begin, &error_end, alloc, INPUT,
+                    strlen(INPUT), VCJSON_PARSE_FLAG_INSERTION_ORDER));
+
+    /* the canonical form is sorted. */
+    sink.offset = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_canonical(value, &test_sink_write, &sink));
+    TEST_ASSERT(strlen(EXPECTED) == sink.offset);
+    TEST_EXPECT(0 == memcmp(EXPECTED, sink.buffer, sink.offset));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that packed number arrays are emitted in the canonical form.
+ */
+TEST(vcjson_emit_canonical_packed)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_value* value = nullptr;
+    const double NUMBERS[] = { 1.5, -0.0, 1e21 };
+    const char* EXPECTED = "[1.5,0,1e+21]";
+    test_sink sink;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a packed array. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_array_create_from_doubles(&arr, alloc, NUMBERS, 3));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_array(&value, alloc, arr));
+
+    /* the canonical form matches that of boxed numbers. */
+    sink.offset = 0;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_canonical(value, &test_sink_write, &sink));
+    TEST_ASSERT(strlen(EXPECTED) == sink.offset);
+    TEST_EXPECT(0 == memcmp(EXPECTED, sink.buffer, sink.offset));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,159 @@
+/**
+ * \file test/test_vcjson_emit_iovec.cpp
+ *
+ * \brief Unit tests for vcjson_emit_iovec.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <minunit/minunit.h>
+#include <sys/uio.h>
+#include <vcjson/vcjson.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_emit_iovec);
+
+/**
+ * Verify that the gathered list matches the emitted text.
+ */
+TEST(vcjson_emit_iovec_matches_buffer)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_iovec_list* list = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":[true,false,null],"b":"x\ny","c":{}})";
+    char buffer[128];
+    size_t needed = 0;
+    const struct iovec* iov;
+    size_t count = 0;
+    char gathered[128];
+    size_t gathered_size = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* we can emit this value into a buffer. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+
+    /* we can emit this value as an iovec list. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_iovec(&list, alloc, value));
+
+    /* gather the list. */
+    iov = vcjson_iovec_list_vector(list, &count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(gathered_size + iov[i].iov_len <= sizeof(gathered));
+        memcpy(gathered + gathered_size, iov[i].iov_base, iov[i].iov_len);
+        gathered_size += iov[i].iov_len;
+    }
+
+    /* all short data is coalesced into a single scratch entry. */
+    TEST_EXPECT(1 == count);
+    /* the gathered text should match the buffer. */
+    TEST_ASSERT(needed == gathered_size);
+    TEST_EXPECT(0 == memcmp(buffer, gathered, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_iovec_list_resource_handle(list)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that long string runs refer to the string storage.
+ */
+TEST(vcjson_emit_iovec_references_strings)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    vcjson_iovec_list* list = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    char payload[VCJSON_EMIT_IOVEC_REFERENCE_MINIMUM * 2 + 1];
+    char input[sizeof(payload) + 32];
+    const char* str_value;
+    size_t str_length;
+    const struct iovec* iov;
+    size_t count = 0;
+    char gathered[sizeof(input)];
+    size_t gathered_size = 0;
+
+    /* build an input with a long string payload. */
+    memset(payload, 'x', sizeof(payload) - 1);
+    payload[sizeof(payload) - 1] = 0;
+    snprintf(input, sizeof(input), R"({"a":"%s","b":"short"})", payload);
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, input));
+
+    /* get the payload string. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get(&member, obj, key));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_string(&str, member));
+    str_value = vcjson_string_value(str, &str_length);
+
+    /* we can emit this value as an iovec list. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_iovec(&list, alloc, value));
+
+    /* gather the list. */
+    iov = vcjson_iovec_list_vector(list, &count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(gathered_size + iov[i].iov_len <= sizeof(gathered));
+        memcpy(gathered + gathered_size, iov[i].iov_base, iov[i].iov_len);
+        gathered_size += iov[i].iov_len;
+    }
+
+    /* the gathered text should match the input. */
+    TEST_ASSERT(strlen(input) == gathered_size);
+    TEST_EXPECT(0 == memcmp(input, gathered, gathered_size));
+
+    /* the payload is referenced between two scratch entries. */
+    TEST_ASSERT(3 == count);
+    TEST_EXPECT(str_value == iov[1].iov_base);
+    TEST_EXPECT(str_length == iov[1].iov_len);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_iovec_list_resource_handle(list)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(key)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
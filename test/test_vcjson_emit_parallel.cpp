@@ -0,0 +1,288 @@
+/**
+ * \file test/test_vcjson_emit_parallel.cpp
+ *
+ * \brief Unit tests for vcjson_emit_string_parallel.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_emit_parallel);
+
+#define TEST_ELEMENTS (VCJSON_EMIT_PARALLEL_CHUNK_SIZE * 3 + 7)
+
+/**
+ * Verify that parallel emission matches serial emission.
+ */
+TEST(vcjson_emit_string_parallel_matches_serial)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* root = nullptr;
+    vcjson_object* members = nullptr;
+    vcjson_object* small = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* elem = nullptr;
+    vcjson_string* key = nullptr;
+    vcjson_string* str = nullptr;
+    vcjson_string* expected = nullptr;
+    vcjson_string* actual = nullptr;
+    const char* expected_str;
+    size_t expected_length;
+    const char* actual_str;
+    size_t actual_length;
+    char keybuf[32];
+    const size_t thread_counts[] = { 0, 1, 2, 4, 7 };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a large array of mixed elements. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_create(&arr, alloc, TEST_ELEMENTS));
+    for (size_t i = 0; i < TEST_ELEMENTS; ++i)
+    {
+        switch (i % 3)
+        {
+            case 0:
+                TEST_ASSERT(
+                    STATUS_SUCCESS == vcjson_string_create(&str, alloc, "s\n"));
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_value_create_from_string(&elem, alloc, str));
+                break;
+
+            case 1:
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_value_create_from_true(&elem, alloc));
+                break;
+
+            default:
+                TEST_ASSERT(
+                    STATUS_SUCCESS == vcjson_object_create(&small, alloc));
+                TEST_ASSERT(
+                    STATUS_SUCCESS == vcjson_string_create(&key, alloc, "k"));
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_value_create_from_null(&value, alloc));
+                TEST_ASSERT(
+                    STATUS_SUCCESS == vcjson_object_put(small, key, value));
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_value_create_from_object(
+                                &elem, alloc, small));
+                break;
+        }
+
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_array_set(arr, i, elem));
+    }
+
+    /* create a large object. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_create(&members, alloc));
+    for (size_t i = 0; i < TEST_ELEMENTS; ++i)
+    {
+        snprintf(keybuf, sizeof(keybuf), "k%06zu", i);
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, keybuf));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_value_create_from_false(&value, alloc));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(members, key, value));
+    }
+
+    /* nest both under a small root object. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_create(&root, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "data"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_array(&value, alloc, arr));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(root, key, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&key, alloc, "index"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_object(&value, alloc, members));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(root, key, value));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_object(&value, alloc, root));
+
+    /* emit the value serially. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&expected, alloc, value));
+    expected_str = vcjson_string_value(expected, &expected_length);
+
+    /* parallel emission matches for every thread count. */
+    for (size_t threads : thread_counts)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_emit_string_parallel(&actual, alloc, value, threads));
+        actual_str = vcjson_string_value(actual, &actual_length);
+        TEST_ASSERT(expected_length == actual_length);
+        TEST_EXPECT(0 == memcmp(expected_str, actual_str, actual_length));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(actual)));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(expected)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that scalar and empty values can be emitted in parallel.
+ */
+TEST(vcjson_emit_string_parallel_small_values)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_string* actual = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUTS[] = { "true", "[]", "{}", R"({"a":[]})" };
+    const char* actual_str;
+    size_t actual_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    for (const char* input : INPUTS)
+    {
+        /* we can parse this string. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_parse_string(
+                        &value, &error_begin, &error_end, alloc, input));
+
+        /* the parallel emission matches the input. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_emit_string_parallel(&actual, alloc, value, 4));
+        actual_str = vcjson_string_value(actual, &actual_length);
+        TEST_ASSERT(strlen(input) == actual_length);
+        TEST_EXPECT(0 == memcmp(input, actual_str, actual_length));
+
+        /* clean up. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(actual)));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_value_resource_handle(value)));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a document with no container larger than a chunk, which is
+ * emitted serially, matches serial emission.
+ */
+TEST(vcjson_emit_string_parallel_below_threshold)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_string* actual = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT =
+        R"({"a":{"b":[1.000000,2.000000,{"c":"d"}],"e":null},)"
+        R"("f":[true,false]})";
+    const char* actual_str;
+    size_t actual_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* asking for many threads still gives the serial emission. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_string_parallel(&actual, alloc, value, 64));
+    actual_str = vcjson_string_value(actual, &actual_length);
+    TEST_ASSERT(strlen(INPUT) == actual_length);
+    TEST_EXPECT(0 == memcmp(INPUT, actual_str, actual_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(actual)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that packed number arrays are emitted in parallel.
+ */
+TEST(vcjson_emit_string_parallel_packed)
+{
+    allocator* alloc = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_string* expected = nullptr;
+    vcjson_string* actual = nullptr;
+    double numbers[TEST_ELEMENTS];
+    const char* expected_str;
+    size_t expected_length;
+    const char* actual_str;
+    size_t actual_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a packed array large enough to be split into chunks. */
+    for (size_t i = 0; i < TEST_ELEMENTS; ++i)
+    {
+        numbers[i] = 0.5 * i;
+    }
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_array_create_from_doubles(
+                    &arr, alloc, numbers, TEST_ELEMENTS));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_array(&value, alloc, arr));
+
+    /* parallel emission matches serial emission. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&expected, alloc, value));
+    expected_str = vcjson_string_value(expected, &expected_length);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_string_parallel(&actual, alloc, value, 4));
+    actual_str = vcjson_string_value(actual, &actual_length);
+    TEST_ASSERT(expected_length == actual_length);
+    TEST_EXPECT(0 == memcmp(expected_str, actual_str, actual_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(actual)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(expected)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,237 @@
+/**
+ * \file test/test_vcjson_equal.cpp
+ *
+ * \brief Unit tests for value equality and hashing.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_equal);
+
+/**
+ * \brief Parse the given input, or return nullptr.
+ */
+static vcjson_value* parse(allocator* alloc, const char* input, uint32_t flags)
+{
+    vcjson_value* value = nullptr;
+    size_t error_begin, error_end;
+
+    if (STATUS_SUCCESS
+            != vcjson_parse_with_flags(
+                    &value, &error_begin, &error_end, alloc, input,
+                    strlen(input), flags))
+    {
+        return nullptr;
+    }
+
+    return value;
+}
+
+/**
+ * \brief Release the given value.
+ */
+static bool release(vcjson_value* value)
+{
+    return
+        STATUS_SUCCESS == resource_release(vcjson_value_resource_handle(value));
+}
+
+/**
+ * Verify that values holding the same content are equal and hash alike,
+ * regardless of member order, storage, and the sign of zero.
+ */
+TEST(vcjson_value_equal_same_content)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* lhs = nullptr;
+    vcjson_value* rhs = nullptr;
+    vcjson_value* ordered = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_value* compact = nullptr;
+    char left[2048], right[2048];
+    size_t loffset, roffset;
+
+    /* build documents holding a wide object, with members in each order. */
+    loffset = snprintf(left, sizeof(left), R"({"a":[1,-0,"x"],"w":{)");
+    roffset = snprintf(right, sizeof(right), R"({ "w" : {)");
+    for (int i = 0; i < 40; ++i)
+    {
+        loffset +=
+            snprintf(
+                left + loffset, sizeof(left) - loffset, R"(%s"k%02d":%d)",
+                (0 == i) ? "" : ",", i, i);
+        roffset +=
+            snprintf(
+                right + roffset, sizeof(right) - roffset, R"(%s"k%02d":%d)",
+                (0 == i) ? "" : ",", 39 - i, 39 - i);
+    }
+    snprintf(left + loffset, sizeof(left) - loffset, R"(},"b":null})");
+    snprintf(
+        right + roffset, sizeof(right) - roffset,
+        R"(}, "b" : null, "a" : [1, 0, "x"] })");
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse both documents, and one keeping insertion order. */
+    lhs = parse(alloc, left, 0);
+    TEST_ASSERT(nullptr != lhs);
+    rhs = parse(alloc, right, 0);
+    TEST_ASSERT(nullptr != rhs);
+    ordered = parse(alloc, right, VCJSON_PARSE_FLAG_INSERTION_ORDER);
+    TEST_ASSERT(nullptr != ordered);
+
+    /* they are equal, and hash alike. */
+    TEST_EXPECT(vcjson_value_equal(lhs, rhs));
+    TEST_EXPECT(vcjson_value_equal(rhs, lhs));
+    TEST_EXPECT(vcjson_value_equal(lhs, ordered));
+    TEST_EXPECT(vcjson_value_equal(ordered, lhs));
+    TEST_EXPECT(vcjson_value_hash(lhs) == vcjson_value_hash(rhs));
+    TEST_EXPECT(vcjson_value_hash(lhs) == vcjson_value_hash(ordered));
+
+    /* copies are equal to their originals. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, lhs));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_copy_compact(&compact, alloc, rhs));
+    TEST_EXPECT(vcjson_value_equal(lhs, copy));
+    TEST_EXPECT(vcjson_value_equal(compact, lhs));
+    TEST_EXPECT(vcjson_value_hash(copy) == vcjson_value_hash(lhs));
+    TEST_EXPECT(vcjson_value_hash(compact) == vcjson_value_hash(lhs));
+
+    /* clean up. */
+    TEST_ASSERT(release(compact));
+    TEST_ASSERT(release(copy));
+    TEST_ASSERT(release(ordered));
+    TEST_ASSERT(release(rhs));
+    TEST_ASSERT(release(lhs));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that values holding different content are not equal.
+ */
+TEST(vcjson_value_equal_different_content)
+{
+    allocator* alloc = nullptr;
+    const char* base = R"({"a":[1,2,3],"b":"str","c":true})";
+    const char* others[] = {
+        R"({"a":[1,2,4],"b":"str","c":true})",
+        R"({"a":[1,2],"b":"str","c":true})",
+        R"({"a":[1,2,3],"b":"stR","c":true})",
+        R"({"a":[1,2,3],"b":"str","c":false})",
+        R"({"a":[1,2,3],"b":"str","d":true})",
+        R"({"a":[1,2,3],"b":"str","c":true,"d":null})",
+        R"({"a":[1,2,3],"b":"str","c":"true"})",
+        R"([1,2,3])",
+    };
+    vcjson_value* lhs = nullptr;
+    vcjson_value* rhs = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the base document. */
+    lhs = parse(alloc, base, 0);
+    TEST_ASSERT(nullptr != lhs);
+
+    /* each other document differs from it. */
+    for (size_t i = 0; i < sizeof(others) / sizeof(others[0]); ++i)
+    {
+        rhs = parse(alloc, others[i], 0);
+        TEST_ASSERT(nullptr != rhs);
+
+        TEST_EXPECT(!vcjson_value_equal(lhs, rhs));
+        TEST_EXPECT(!vcjson_value_equal(rhs, lhs));
+        TEST_EXPECT(vcjson_value_hash(lhs) != vcjson_value_hash(rhs));
+
+        TEST_ASSERT(release(rhs));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(release(lhs));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a packed array equals an array of boxed numbers.
+ */
+TEST(vcjson_value_equal_packed_array)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* packed = nullptr;
+    vcjson_value* boxed = nullptr;
+    vcjson_value* number = nullptr;
+    vcjson_array* arr = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse a packed array. */
+    packed = parse(alloc, "[1,2,3]", 0);
+    TEST_ASSERT(nullptr != packed);
+
+    /* build the same array from boxed numbers. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_create(&arr, alloc, 0));
+    for (int i = 1; i <= 3; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_value_create_number(&number, alloc, i));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_array_append(arr, number));
+    }
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_array(&boxed, alloc, arr));
+
+    /* they are equal, and hash alike. */
+    TEST_EXPECT(vcjson_value_equal(packed, boxed));
+    TEST_EXPECT(vcjson_value_equal(boxed, packed));
+    TEST_EXPECT(vcjson_value_hash(packed) == vcjson_value_hash(boxed));
+
+    /* changing an element makes them differ. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_number(&number, alloc, 4));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_set(arr, 2, number));
+    TEST_EXPECT(!vcjson_value_equal(packed, boxed));
+    TEST_EXPECT(!vcjson_value_equal(boxed, packed));
+
+    /* clean up. */
+    TEST_ASSERT(release(boxed));
+    TEST_ASSERT(release(packed));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that the content hash is fixed, and does not depend on the seed used
+ * to hash object keys in this process.
+ */
+TEST(vcjson_value_hash_stable)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse a value. */
+    value = parse(alloc, R"({"key":["value",true,null]})", 0);
+    TEST_ASSERT(nullptr != value);
+
+    /* its hash is the same in every process. */
+    TEST_EXPECT(0xc4d0edc67b9f890fULL == vcjson_value_hash(value));
+
+    /* clean up. */
+    TEST_ASSERT(release(value));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,300 @@
+/**
+ * \file test/test_vcjson_freeze.cpp
+ *
+ * \brief Unit tests for frozen values.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+#include "../src/vcjson_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_freeze);
+
+/**
+ * Verify that every kind of value can be read back from a frozen value.
+ */
+TEST(vcjson_value_freeze_basics)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_frozen* frozen = nullptr;
+    const vcjson_frozen_value* root;
+    const vcjson_frozen_value* member;
+    const vcjson_frozen_value* element;
+    const vcjson_frozen_object* obj;
+    const vcjson_frozen_array* arr;
+    const char* str;
+    size_t length;
+    double number;
+    bool boolean;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT =
+        R"({"z":"last","a":[1,2.5,3],"m":[true,null,"s",{"k":false}]})";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse and freeze a value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_freeze(&frozen, alloc, value));
+
+    /* the frozen value no longer depends on the original. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+
+    /* the root is an object. */
+    root = vcjson_frozen_root(frozen);
+    TEST_ASSERT(VCJSON_VALUE_TYPE_OBJECT == vcjson_frozen_value_type(root));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_object(&obj, root));
+    TEST_EXPECT(3 == vcjson_frozen_object_elements(obj));
+
+    /* it is not an array. */
+    TEST_EXPECT(
+        ERROR_VCJSON_INVALID_GET == vcjson_frozen_value_get_array(&arr, root));
+
+    /* members are stored in key order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_object_member(&str, &length, &member, obj, 0));
+    TEST_EXPECT(1 == length && !strcmp("a", str));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_object_member(&str, &length, &member, obj, 2));
+    TEST_EXPECT(1 == length && !strcmp("z", str));
+    TEST_EXPECT(
+        ERROR_VCJSON_ITERATOR_END
+            == vcjson_frozen_object_member(&str, &length, &member, obj, 3));
+
+    /* strings can be looked up by key. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "z"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_value_get_string(&str, &length, member));
+    TEST_EXPECT(4 == length && !strcmp("last", str));
+    TEST_EXPECT(
+        ERROR_VCJSON_KEY_NOT_FOUND
+            == vcjson_frozen_object_get_cstr(&member, obj, "b"));
+    TEST_EXPECT(
+        ERROR_VCJSON_KEY_NOT_FOUND
+            == vcjson_frozen_object_get_raw(&member, obj, "zz", 2));
+
+    /* packed numbers are frozen as numbers. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_value_get_array(&arr, member));
+    TEST_ASSERT(3 == vcjson_frozen_array_size(arr));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 1));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_number(&number, element));
+    TEST_EXPECT(2.5 == number);
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_INDEX_OUT_OF_BOUNDS
+            == vcjson_frozen_array_get(&element, arr, 3));
+
+    /* mixed arrays hold every other kind of value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "m"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_value_get_array(&arr, member));
+    TEST_ASSERT(4 == vcjson_frozen_array_size(arr));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_bool(&boolean, element));
+    TEST_EXPECT(boolean);
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 1));
+    TEST_EXPECT(VCJSON_VALUE_TYPE_NULL == vcjson_frozen_value_type(element));
+    TEST_EXPECT(
+        ERROR_VCJSON_INVALID_GET
+            == vcjson_frozen_value_get_number(&number, element));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 3));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_object(&obj, element));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "k"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_bool(&boolean, member));
+    TEST_EXPECT(!boolean);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_frozen_resource_handle(frozen)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a wide object keeping insertion order is frozen in key order,
+ * and that repeated strings are stored once.
+ */
+TEST(vcjson_value_freeze_wide_and_interned)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_frozen* frozen = nullptr;
+    const vcjson_frozen_value* member;
+    const vcjson_frozen_value* element;
+    const vcjson_frozen_object* obj;
+    const vcjson_frozen_object* wide;
+    const vcjson_frozen_array* arr;
+    const char* str;
+    const char* first;
+    size_t length;
+    double number;
+    char input[2048];
+    char key[8];
+    size_t offset;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+
+    /* build a document holding a wide object, in reverse key order. */
+    offset =
+        snprintf(
+            input, sizeof(input),
+            R"({"list":[{"name":"x"},{"name":"x"}],"wide":{)");
+    for (int i = 39; i >= 0; --i)
+    {
+        offset +=
+            snprintf(
+                input + offset, sizeof(input) - offset, R"(%s"k%02d":%d)",
+                (39 == i) ? "" : ",", i, i);
+    }
+    snprintf(input + offset, sizeof(input) - offset, "}}");
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the document keeping insertion order, and freeze it. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_with_flags(
+                    &value, &error_begin, &error_end, alloc, input,
+                    strlen(input), VCJSON_PARSE_FLAG_INSERTION_ORDER));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_freeze(&frozen, alloc, value));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+
+    /* every member of the wide object can be found, in key order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_value_get_object(
+                    &obj, vcjson_frozen_root(frozen)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "wide"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_object(&wide, member));
+    TEST_ASSERT(40 == vcjson_frozen_object_elements(wide));
+    for (int i = 0; i < 40; ++i)
+    {
+        snprintf(key, sizeof(key), "k%02d", i);
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_frozen_object_member(
+                        &str, &length, &member, wide, i));
+        TEST_EXPECT(!strcmp(key, str));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_frozen_object_get_cstr(&member, wide, key));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_frozen_value_get_number(&number, member));
+        TEST_EXPECT(i == number);
+    }
+
+    /* keys and values repeated across objects share their characters. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "list"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_value_get_array(&arr, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_object(&obj, element));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_object_member(&first, &length, &member, obj, 0));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 1));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_object(&obj, element));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_object_member(&str, &length, &member, obj, 0));
+    TEST_EXPECT(first == str);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_frozen_resource_handle(frozen)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a tape can be read after it is moved.
+ */
+TEST(vcjson_value_freeze_relocatable)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_frozen* frozen = nullptr;
+    const vcjson_frozen_value* member;
+    const vcjson_frozen_object* obj;
+    const char* str;
+    size_t length;
+    uint8_t* moved;
+    size_t tape_size;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse and freeze a value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc,
+                    R"({"a":"b","c":["d"]})"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_freeze(&frozen, alloc, value));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+
+    /* copy the tape elsewhere, and release the original. */
+    tape_size = frozen->tape_size;
+    moved = new uint8_t[tape_size];
+    memcpy(moved, frozen->tape, tape_size);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_frozen_resource_handle(frozen)));
+
+    /* the copy can still be read. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_value_get_object(
+                    &obj, (const vcjson_frozen_value*)moved));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "a"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_value_get_string(&str, &length, member));
+    TEST_EXPECT(1 == length && !strcmp("b", str));
+
+    /* clean up. */
+    delete[] moved;
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -417,3 +417,321 @@ TEST(vcjson_object_iterate)
         STATUS_SUCCESS
             == resource_release(allocator_resource_handle(alloc)));
 }
+
+/**
+ * Verify that we can get values by raw key bytes and by C string.
+ */
+TEST(vcjson_object_get_raw)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_value* val = nullptr;
+    vcjson_string* keystr = nullptr;
+    const int STORAGE[] = {
+        VCJSON_OBJECT_STORAGE_TREE, VCJSON_OBJECT_STORAGE_HASH,
+        VCJSON_OBJECT_STORAGE_FLAT };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    for (int storage : STORAGE)
+    {
+        /* create an object instance with this storage. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_object_create_with_storage(&object, alloc, storage));
+
+        /* put a true value under "payee_id". */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_string_create(&keystr, alloc, "payee_id"));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_value_create_from_true(&val, alloc));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(object, keystr, val));
+
+        /* the raw key bytes need not be NUL-terminated. */
+        val = nullptr;
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_object_get_raw(&val, object, "payee_id_xyz", 8));
+        TEST_EXPECT(VCJSON_VALUE_TYPE_BOOL == vcjson_value_type(val));
+
+        /* a prefix of the key is not found. */
+        TEST_EXPECT(
+            ERROR_VCJSON_KEY_NOT_FOUND
+                == vcjson_object_get_raw(&val, object, "payee_id", 5));
+
+        /* the C string variant finds the key. */
+        val = nullptr;
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_object_get_cstr(&val, object, "payee_id"));
+        TEST_EXPECT(VCJSON_VALUE_TYPE_BOOL == vcjson_value_type(val));
+
+        /* a missing key is not found. */
+        TEST_EXPECT(
+            ERROR_VCJSON_KEY_NOT_FOUND
+                == vcjson_object_get_cstr(&val, object, "payer_id"));
+
+        /* clean up this object. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_object_resource_handle(object)));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that we can create an object from sorted and unsorted members.
+ */
+TEST(vcjson_object_create_from_members)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_value* val = nullptr;
+    vcjson_number* number = nullptr;
+    vcjson_object_iterator* iter = nullptr;
+    const vcjson_string* ikey = nullptr;
+    vcjson_string* keys[40];
+    vcjson_value* values[40];
+    char key[32];
+    const size_t COUNTS[] = { 0, 3, 40 };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    for (size_t count : COUNTS)
+    {
+        for (int reversed = 0; reversed < 2; ++reversed)
+        {
+            /* create the members, in ascending or descending key order. */
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t n = reversed ? count - 1 - i : i;
+                snprintf(key, sizeof(key), "%02zu", n);
+
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_string_create(&keys[i], alloc, key));
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_number_create(&number, alloc, n));
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_value_create_from_number(
+                                &values[i], alloc, number));
+            }
+
+            /* create the object from these members. */
+            TEST_ASSERT(
+                STATUS_SUCCESS
+                    == vcjson_object_create_from_members(
+                            &object, alloc, keys, values, count));
+
+            /* every key can be found. */
+            for (size_t i = 0; i < count; ++i)
+            {
+                snprintf(key, sizeof(key), "%02zu", i);
+
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_object_get_cstr(&val, object, key));
+                TEST_ASSERT(
+                    STATUS_SUCCESS == vcjson_value_get_number(&number, val));
+                TEST_EXPECT((double)i == vcjson_number_value(number));
+            }
+
+            /* the members iterate in key order. */
+            if (count > 0)
+            {
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == vcjson_object_iterator_create(&iter, object));
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    size_t length;
+                    snprintf(key, sizeof(key), "%02zu", i);
+
+                    TEST_ASSERT(
+                        STATUS_SUCCESS
+                            == vcjson_object_iterator_value(
+                                    &ikey, &val, iter));
+                    TEST_EXPECT(
+                        0 == strcmp(key, vcjson_string_value(ikey, &length)));
+
+                    if (i + 1 < count)
+                    {
+                        TEST_ASSERT(
+                            STATUS_SUCCESS
+                                == vcjson_object_iterator_next(iter));
+                    }
+                }
+
+                TEST_ASSERT(
+                    STATUS_SUCCESS
+                        == resource_release(
+                                vcjson_object_iterator_resource_handle(iter)));
+            }
+
+            /* clean up this object. */
+            TEST_ASSERT(
+                STATUS_SUCCESS
+                    == resource_release(vcjson_object_resource_handle(object)));
+        }
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that duplicate members are rejected and remain owned by the caller.
+ */
+TEST(vcjson_object_create_from_members_duplicate)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_string* keys[3];
+    vcjson_value* values[3];
+    const char* KEYS[] = { "b", "a", "b" };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create the members. */
+    for (size_t i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_string_create(&keys[i], alloc, KEYS[i]));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_value_create_from_null(&values[i], alloc));
+    }
+
+    /* a duplicate key is rejected. */
+    TEST_EXPECT(
+        ERROR_VCJSON_OBJECT_DUPLICATE_KEY
+            == vcjson_object_create_from_members(
+                    &object, alloc, keys, values, 3));
+
+    /* the caller still owns the members. */
+    for (size_t i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(keys[i])));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_value_resource_handle(values[i])));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
+
+namespace {
+
+struct foreach_context
+{
+    char keys[16];
+    size_t count;
+    size_t stop_after;
+};
+
+status foreach_collect(
+    void* context, const vcjson_string* key, vcjson_value* /*value*/)
+{
+    foreach_context* ctx = (foreach_context*)context;
+    size_t length;
+
+    if (ctx->count == ctx->stop_after)
+    {
+        return ERROR_VCJSON_ITERATOR_END;
+    }
+
+    ctx->keys[ctx->count++] = vcjson_string_value(key, &length)[0];
+
+    return STATUS_SUCCESS;
+}
+
+} /* namespace */
+
+/**
+ * Verify that we can walk the members of an object with a callback.
+ */
+TEST(vcjson_object_foreach)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_value* val = nullptr;
+    vcjson_string* keystr = nullptr;
+    const char* KEYS[] = { "c", "a", "d", "b" };
+    const int STORAGE[] = {
+        VCJSON_OBJECT_STORAGE_TREE, VCJSON_OBJECT_STORAGE_HASH,
+        VCJSON_OBJECT_STORAGE_FLAT };
+    foreach_context ctx;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    for (int storage : STORAGE)
+    {
+        /* create an object instance with this storage. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_object_create_with_storage(&object, alloc, storage));
+
+        /* an empty object has no members to visit. */
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.stop_after = 16;
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_object_foreach(object, &foreach_collect, &ctx));
+        TEST_EXPECT(0 == ctx.count);
+
+        /* put null values under each key. */
+        for (const char* key : KEYS)
+        {
+            TEST_ASSERT(
+                STATUS_SUCCESS == vcjson_string_create(&keystr, alloc, key));
+            TEST_ASSERT(
+                STATUS_SUCCESS == vcjson_value_create_from_null(&val, alloc));
+            TEST_ASSERT(
+                STATUS_SUCCESS == vcjson_object_put(object, keystr, val));
+        }
+
+        /* every member is visited in key order. */
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.stop_after = 16;
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_object_foreach(object, &foreach_collect, &ctx));
+        TEST_ASSERT(4 == ctx.count);
+        TEST_EXPECT(0 == memcmp("abcd", ctx.keys, 4));
+
+        /* an error from the callback stops the walk. */
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.stop_after = 2;
+        TEST_EXPECT(
+            ERROR_VCJSON_ITERATOR_END
+                == vcjson_object_foreach(object, &foreach_collect, &ctx));
+        TEST_EXPECT(2 == ctx.count);
+
+        /* clean up this object. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_object_resource_handle(object)));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
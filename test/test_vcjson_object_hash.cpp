@@ -0,0 +1,882 @@
+/**
+ * \file test/test_vcjson_object_hash.cpp
+ *
+ * \brief Unit tests for flat and hash-backed vcjson_object storage.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <minunit/minunit.h>
+#include <pthread.h>
+#include <vcjson/vcjson.h>
+
+#include "../src/vcjson_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_object_hash);
+
+namespace {
+
+status put_number(
+    vcjson_object* obj, allocator* alloc, const char* key, double number)
+{
+    status retval;
+    vcjson_string* keystr;
+    vcjson_number* num;
+    vcjson_value* value;
+
+    retval = vcjson_string_create(&keystr, alloc, key);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = vcjson_number_create(&num, alloc, number);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = vcjson_value_create_from_number(&value, alloc, num);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return vcjson_object_put(obj, keystr, value);
+}
+
+status get_number(
+    double* number, vcjson_object* obj, allocator* alloc, const char* key)
+{
+    status retval, release_retval;
+    vcjson_string* keystr;
+    vcjson_value* value;
+    vcjson_number* num;
+
+    retval = vcjson_string_create(&keystr, alloc, key);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = vcjson_object_get(&value, obj, keystr);
+    if (STATUS_SUCCESS == retval)
+    {
+        retval = vcjson_value_get_number(&num, value);
+        if (STATUS_SUCCESS == retval)
+        {
+            *number = vcjson_number_value(num);
+        }
+    }
+
+    release_retval = resource_release(vcjson_string_resource_handle(keystr));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * Verify that an unknown storage kind is rejected.
+ */
+TEST(vcjson_object_create_with_storage_bad)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* an unknown storage kind fails. */
+    TEST_EXPECT(
+        ERROR_VCJSON_OBJECT_BAD_STORAGE
+            == vcjson_object_create_with_storage(&object, alloc, 12345));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a hash-backed object supports put, get, replace, and remove on
+ * many keys.
+ */
+TEST(vcjson_object_hash_put_get_remove)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_string* keystr = nullptr;
+    char key[32];
+    double number;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a hash-backed object. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_HASH));
+    TEST_EXPECT(0 == vcjson_object_elements(object));
+
+    /* put many keys, in descending order. */
+    for (int i = 999; i >= 0; --i)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, key, i));
+    }
+
+    TEST_EXPECT(1000 == vcjson_object_elements(object));
+
+    /* every key can be found. */
+    for (int i = 0; i < 1000; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, key));
+        TEST_EXPECT(i == number);
+    }
+
+    /* a missing key is not found. */
+    TEST_EXPECT(
+        ERROR_VCJSON_KEY_NOT_FOUND
+            == get_number(&number, object, alloc, "key1000"));
+
+    /* replacing a key does not add an element. */
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "key17", -17));
+    TEST_EXPECT(1000 == vcjson_object_elements(object));
+    TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, "key17"));
+    TEST_EXPECT(-17 == number);
+
+    /* remove every even key. */
+    for (int i = 0; i < 1000; i += 2)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_string_create(&keystr, alloc, key));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(object, keystr));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(keystr)));
+    }
+
+    TEST_EXPECT(500 == vcjson_object_elements(object));
+
+    /* only odd keys remain. */
+    for (int i = 0; i < 1000; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i % 2)
+        {
+            TEST_ASSERT(
+                STATUS_SUCCESS == get_number(&number, object, alloc, key));
+        }
+        else
+        {
+            TEST_EXPECT(
+                ERROR_VCJSON_KEY_NOT_FOUND
+                    == get_number(&number, object, alloc, key));
+        }
+    }
+
+    /* clearing the object removes everything. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_clear(object));
+    TEST_EXPECT(0 == vcjson_object_elements(object));
+    TEST_EXPECT(
+        ERROR_VCJSON_KEY_NOT_FOUND
+            == get_number(&number, object, alloc, "key1"));
+
+    /* the object can be reused after a clear. */
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "key1", 1));
+    TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, "key1"));
+    TEST_EXPECT(1 == number);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(object)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a hash-backed object iterates and emits in sorted key order.
+ */
+TEST(vcjson_object_hash_sorted_order)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_object* copy = nullptr;
+    vcjson_object_iterator* iter = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* copyvalue = nullptr;
+    vcjson_string* str = nullptr;
+    const vcjson_string* key;
+    vcjson_value* member;
+    const char* EXPECTED =
+        R"({"a":1.000000,"b":2.000000,"bb":3.000000,"c":4.000000})";
+    const char* EXPECTED_KEYS[] = { "a", "b", "bb", "c" };
+    const char* output;
+    size_t output_length;
+    size_t count = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a hash-backed object with keys out of order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_HASH));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "c", 4));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "bb", 3));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "a", 1));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "b", 2));
+
+    /* the iterator visits keys in sorted order. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_iterator_create(&iter, object));
+    do
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_object_iterator_value(&key, &member, iter));
+        TEST_ASSERT(count < 4);
+        output = vcjson_string_value(key, &output_length);
+        TEST_EXPECT(strlen(EXPECTED_KEYS[count]) == output_length);
+        TEST_EXPECT(0 == memcmp(EXPECTED_KEYS[count], output, output_length));
+        ++count;
+    } while (STATUS_SUCCESS == vcjson_object_iterator_next(iter));
+    TEST_EXPECT(4 == count);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_iterator_resource_handle(iter)));
+
+    /* the emitted text is in sorted order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_object(&value, alloc, object));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* a copy keeps hash storage and emits the same text. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_copy(&copy, alloc, object));
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_HASH == copy->storage);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_object(&copyvalue, alloc, copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copyvalue));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(copyvalue)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that puts and removes only mark the sorted order as stale, and that
+ * the next walk sorts it once.
+ */
+TEST(vcjson_object_hash_order_sorted_on_walk)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_string* keystr = nullptr;
+    vcjson_object_cursor cursor;
+    char key[32];
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* put keys in a scrambled order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_HASH));
+    for (int i = 0; i < 200; ++i)
+    {
+        snprintf(key, sizeof(key), "k%03d", (i * 37) % 200);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, key, i));
+    }
+
+    /* walking the object sorts its order. */
+    TEST_EXPECT(VCJSON_OBJECT_ORDER_STALE == object->order_state);
+    vcjson_object_cursor_begin(&cursor, object);
+    TEST_EXPECT(VCJSON_OBJECT_ORDER_SORTED == object->order_state);
+
+    /* remove every third key, which leaves the order stale again. */
+    for (int i = 0; i < 200; i += 3)
+    {
+        snprintf(key, sizeof(key), "k%03d", i);
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_string_create(&keystr, alloc, key));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(object, keystr));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(keystr)));
+    }
+
+    TEST_EXPECT(VCJSON_OBJECT_ORDER_STALE == object->order_state);
+
+    /* after a walk, the order holds every entry in ascending key order. */
+    vcjson_object_cursor_begin(&cursor, object);
+    TEST_EXPECT(VCJSON_OBJECT_ORDER_SORTED == object->order_state);
+    TEST_ASSERT(133 == object->count);
+    for (size_t i = 0; i < object->count; ++i)
+    {
+        TEST_ASSERT(object->order[i] >= object->entries);
+        TEST_ASSERT(object->order[i] < object->entries + object->count);
+        if (i > 0)
+        {
+            TEST_EXPECT(
+                0 > strcmp(
+                        object->order[i - 1]->key->value,
+                        object->order[i]->key->value));
+        }
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(object)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Arguments for a thread walking a shared object.
+ */
+struct walk_thread_args
+{
+    const vcjson_object* object;
+    size_t count;
+    bool sorted;
+};
+
+/**
+ * \brief Walk the object, checking that its keys ascend.
+ */
+static void* walk_thread(void* context)
+{
+    walk_thread_args* args = (walk_thread_args*)context;
+    vcjson_object_cursor cursor;
+    const vcjson_string* key;
+    const vcjson_string* prev = nullptr;
+    vcjson_value* value;
+
+    args->count = 0;
+    args->sorted = true;
+    for (vcjson_object_cursor_begin(&cursor, args->object);
+         vcjson_object_cursor_member(&key, &value, args->object, &cursor);
+         vcjson_object_cursor_next(&cursor, args->object))
+    {
+        if (nullptr != prev && 0 <= strcmp(prev->value, key->value))
+        {
+            args->sorted = false;
+        }
+
+        prev = key;
+        ++args->count;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Verify that several threads can walk an object with a stale order at once.
+ */
+TEST(vcjson_object_hash_order_walk_threads)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    pthread_t threads[4];
+    walk_thread_args args[4];
+    char key[32];
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* put keys in reverse order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_HASH));
+    for (int i = 999; i >= 0; --i)
+    {
+        snprintf(key, sizeof(key), "k%04d", i);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, key, i));
+    }
+
+    /* walk it on several threads at once. */
+    for (int i = 0; i < 4; ++i)
+    {
+        args[i].object = object;
+        TEST_ASSERT(
+            0 == pthread_create(&threads[i], nullptr, &walk_thread, &args[i]));
+    }
+
+    /* every thread saw every key in ascending order. */
+    for (int i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], nullptr));
+        TEST_EXPECT(1000 == args[i].count);
+        TEST_EXPECT(args[i].sorted);
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(object)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that removals in a scrambled order leave every remaining key
+ * reachable through the index, and that removed keys can be put again.
+ */
+TEST(vcjson_object_hash_remove_relinks)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_string* keystr = nullptr;
+    char key[32];
+    double number;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* put 512 keys. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_HASH));
+    for (int i = 0; i < 512; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, key, i));
+    }
+
+    /* remove half of them in a scrambled order. */
+    for (int i = 0; i < 256; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", (i * 173) % 512);
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_string_create(&keystr, alloc, key));
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(object, keystr));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(keystr)));
+    }
+
+    TEST_EXPECT(256 == vcjson_object_elements(object));
+
+    /* every remaining key still maps to its own value. */
+    for (int i = 0; i < 256; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", (i * 173 + 256 * 173) % 512);
+        TEST_ASSERT(
+            STATUS_SUCCESS == get_number(&number, object, alloc, key));
+        TEST_EXPECT((i * 173 + 256 * 173) % 512 == number);
+
+        snprintf(key, sizeof(key), "key%d", (i * 173) % 512);
+        TEST_EXPECT(
+            ERROR_VCJSON_KEY_NOT_FOUND
+                == get_number(&number, object, alloc, key));
+    }
+
+    /* removed keys can be put again. */
+    for (int i = 0; i < 256; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", (i * 173) % 512);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, key, -i));
+    }
+
+    TEST_EXPECT(512 == vcjson_object_elements(object));
+    for (int i = 0; i < 256; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", (i * 173) % 512);
+        TEST_ASSERT(
+            STATUS_SUCCESS == get_number(&number, object, alloc, key));
+        TEST_EXPECT(-i == number);
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(object)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a flat object is searched in place and promoted to a hash.
+ */
+TEST(vcjson_object_flat_promote)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_object* copy = nullptr;
+    vcjson_string* keystr = nullptr;
+    char key[32];
+    double number;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a flat object. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_FLAT));
+
+    /* fill it to its maximum size, past its inline entries. */
+    for (int i = 0; i < VCJSON_OBJECT_FLAT_MAXIMUM_SIZE; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, key, i));
+    }
+
+    /* it is still flat. */
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_FLAT == object->storage);
+    TEST_EXPECT(
+        (size_t)VCJSON_OBJECT_FLAT_MAXIMUM_SIZE
+            == vcjson_object_elements(object));
+
+    /* replacing and removing keys keeps it flat. */
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "key3", -3));
+    TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, "key3"));
+    TEST_EXPECT(-3 == number);
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&keystr, alloc, "key0"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(object, keystr));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(keystr)));
+    TEST_EXPECT(
+        ERROR_VCJSON_KEY_NOT_FOUND
+            == get_number(&number, object, alloc, "key0"));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "key0", 0));
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_FLAT == object->storage);
+
+    /* a copy is flat as well. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_copy(&copy, alloc, object));
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_FLAT == copy->storage);
+    TEST_ASSERT(STATUS_SUCCESS == get_number(&number, copy, alloc, "key3"));
+    TEST_EXPECT(-3 == number);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(copy)));
+
+    /* one more key promotes it to a hash. */
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "extra", 99));
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_HASH == object->storage);
+    TEST_EXPECT(
+        (size_t)VCJSON_OBJECT_FLAT_MAXIMUM_SIZE + 1
+            == vcjson_object_elements(object));
+
+    /* every key can still be found. */
+    for (int i = 0; i < VCJSON_OBJECT_FLAT_MAXIMUM_SIZE; ++i)
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, key));
+        TEST_EXPECT((3 == i ? -3 : i) == number);
+    }
+    TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, "extra"));
+    TEST_EXPECT(99 == number);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(object)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that the parser switches wide objects to hash storage.
+ */
+TEST(vcjson_object_hash_parse_wide)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_object* inner = nullptr;
+    vcjson_value* innervalue = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    char input[2048];
+    char key[32];
+    size_t offset = 0;
+    const char* output;
+    size_t output_length;
+    double number;
+    const size_t MEMBERS = VCJSON_OBJECT_FLAT_MAXIMUM_SIZE + 8;
+
+    /* build a wide object with a narrow object in sorted key order. */
+    offset += snprintf(input + offset, sizeof(input) - offset, "{");
+    for (size_t i = 0; i < MEMBERS; ++i)
+    {
+        offset +=
+            snprintf(
+                input + offset, sizeof(input) - offset,
+                "%s\"k%03zu\":%zu.000000", (0 == i ? "" : ","), i, i);
+    }
+    offset +=
+        snprintf(
+            input + offset, sizeof(input) - offset, ",\"z\":{\"a\":true}}");
+    TEST_ASSERT(offset < sizeof(input));
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* we can parse this string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, input));
+
+    /* the wide object uses hash storage. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&object, value));
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_HASH == object->storage);
+    TEST_EXPECT(MEMBERS + 1 == vcjson_object_elements(object));
+
+    /* every member can be found. */
+    for (size_t i = 0; i < MEMBERS; ++i)
+    {
+        snprintf(key, sizeof(key), "k%03zu", i);
+        TEST_ASSERT(STATUS_SUCCESS == get_number(&number, object, alloc, key));
+        TEST_EXPECT((double)i == number);
+    }
+
+    /* the narrow object stays flat. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&str, alloc, "z"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get(&innervalue, object, str));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&inner, innervalue));
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_FLAT == inner->storage);
+
+    /* the emitted text matches the input. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(offset == output_length);
+    TEST_EXPECT(0 == memcmp(input, output, output_length));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that strings carry a precomputed hash, and that strings without one
+ * still work as keys.
+ */
+TEST(vcjson_object_hash_precomputed_key)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_string* created = nullptr;
+    vcjson_string* raw = nullptr;
+    vcjson_string* copy = nullptr;
+    vcjson_string* emitted = nullptr;
+    vcjson_number* num = nullptr;
+    vcjson_value* value = nullptr;
+    double number;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* created, raw, and copied strings share the same precomputed hash. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_string_create(&created, alloc, "1.000000"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_string_create_from_raw(&raw, alloc, "1.000000xyz", 8));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_copy(&copy, alloc, created));
+    TEST_ASSERT(created->hashed && raw->hashed && copy->hashed);
+    TEST_EXPECT(vcjson_object_key_hash("1.000000", 8) == created->hash);
+    TEST_EXPECT(created->hash == raw->hash);
+    TEST_EXPECT(created->hash == copy->hash);
+
+    /* emitted strings are not hashed up front. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_number_create(&num, alloc, 1.0));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_from_number(&value, alloc, num));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&emitted, alloc, value));
+    TEST_EXPECT(!emitted->hashed);
+    TEST_EXPECT(created->hash == vcjson_string_hash(emitted));
+
+    /* an emitted string works as a key in a hash-backed object. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_HASH));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_put(object, emitted, value));
+    TEST_ASSERT(
+        STATUS_SUCCESS == get_number(&number, object, alloc, "1.000000"));
+    TEST_EXPECT(1.0 == number);
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get(&value, object, raw));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(object, copy));
+    TEST_EXPECT(0 == vcjson_object_elements(object));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(object)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(created)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(raw)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that an object can walk its members in insertion order.
+ */
+TEST(vcjson_object_insertion_order)
+{
+    allocator* alloc = nullptr;
+    vcjson_object* object = nullptr;
+    vcjson_object* copy = nullptr;
+    vcjson_object* tree = nullptr;
+    vcjson_object_iterator* iter = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* copyvalue = nullptr;
+    vcjson_string* str = nullptr;
+    const vcjson_string* key;
+    vcjson_value* member;
+    vcjson_string* keystr = nullptr;
+    const char* EXPECTED =
+        R"({"c":4.000000,"bb":5.000000,"b":2.000000,"d":6.000000})";
+    const char* output;
+    size_t output_length;
+    char name[32];
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a flat object that keeps insertion order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_object_create_with_storage(
+                    &object, alloc, VCJSON_OBJECT_STORAGE_FLAT));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_set_insertion_order(object, true));
+
+    /* put, replace, and remove members. */
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "c", 4));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "bb", 3));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "a", 1));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "b", 2));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "bb", 5));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&keystr, alloc, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_remove(object, keystr));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(keystr)));
+    TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, "d", 6));
+
+    /* the emitted text keeps insertion order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_object(&value, alloc, object));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* a copy keeps insertion order. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_copy(&copy, alloc, object));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_from_object(&copyvalue, alloc, copy));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, copyvalue));
+    output = vcjson_string_value(str, &output_length);
+    TEST_ASSERT(strlen(EXPECTED) == output_length);
+    TEST_EXPECT(0 == memcmp(EXPECTED, output, output_length));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* promotion to a hash table keeps insertion order. */
+    for (int i = 0; i < VCJSON_OBJECT_FLAT_MAXIMUM_SIZE; ++i)
+    {
+        snprintf(name, sizeof(name), "0%d", i);
+        TEST_ASSERT(STATUS_SUCCESS == put_number(object, alloc, name, i));
+    }
+    TEST_EXPECT(VCJSON_OBJECT_STORAGE_HASH == object->storage);
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_iterator_create(&iter, object));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_iterator_value(&key, &member, iter));
+    output = vcjson_string_value(key, &output_length);
+    TEST_EXPECT(1 == output_length && 'c' == output[0]);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_iterator_resource_handle(iter)));
+
+    /* sorted order can be restored. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_set_insertion_order(object, false));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_iterator_create(&iter, object));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_iterator_value(&key, &member, iter));
+    output = vcjson_string_value(key, &output_length);
+    TEST_EXPECT(2 == output_length && 0 == memcmp("00", output, 2));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_iterator_resource_handle(iter)));
+
+    /* a tree-backed object only knows sorted order. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_create(&tree, alloc));
+    TEST_EXPECT(
+        ERROR_VCJSON_OBJECT_BAD_STORAGE
+            == vcjson_object_set_insertion_order(tree, true));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_object_resource_handle(tree)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(copyvalue)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -1234,3 +1234,149 @@ TEST(recursion_overflow)
     TEST_ASSERT(STATUS_SUCCESS
         == resource_release(allocator_resource_handle(alloc)));
 }
+
+/**
+ * Verify that parsed objects can keep their document order.
+ */
+TEST(parse_insertion_order)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"z":"1","a":{"y":true,"b":null},"m":[false]})";
+    const char* SORTED = R"({"a":{"b":null,"y":true},"m":[false],"z":"1"})";
+    char buffer[128];
+    size_t needed = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* by default, parsed objects are emitted in sorted key order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_with_flags(
+                    &value, &error_begin, &error_end, alloc, INPUT,
+                    strlen(INPUT), 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+    TEST_ASSERT(strlen(SORTED) == needed);
+    TEST_EXPECT(0 == memcmp(SORTED, buffer, needed));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+
+    /* with the flag, parsed objects are emitted in document order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_with_flags(
+                    &value, &error_begin, &error_end, alloc, INPUT,
+                    strlen(INPUT), VCJSON_PARSE_FLAG_INSERTION_ORDER));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+    TEST_ASSERT(strlen(INPUT) == needed);
+    TEST_EXPECT(0 == memcmp(INPUT, buffer, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(STATUS_SUCCESS
+        == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that arrays of only numbers are parsed into packed arrays.
+ */
+TEST(parse_packed_numbers)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* elem = nullptr;
+    vcjson_array* arr = nullptr;
+    vcjson_number* number = nullptr;
+    const double* numbers = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = "[[1.5,2.25,-3],[4,\"x\"],[]]";
+    const char* EXPECTED =
+        R"([[1.500000,2.250000,-3.000000],[4.000000,"x"],[]])";
+    char buffer[128];
+    size_t needed = 0;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse the input. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, value));
+
+    /* the outer array holds arrays, so it is not packed. */
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_NOT_PACKED
+            == vcjson_array_get_doubles(&numbers, arr));
+
+    /* the first array holds only numbers, so it is packed. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&elem, arr, 0));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, elem));
+    TEST_ASSERT(3 == vcjson_array_size(arr));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get_doubles(&numbers, arr));
+    TEST_EXPECT(1.5 == numbers[0]);
+    TEST_EXPECT(2.25 == numbers[1]);
+    TEST_EXPECT(-3.0 == numbers[2]);
+
+    /* the second array holds a string, so it is not packed. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&elem, arr, 1));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_array(&arr, elem));
+    TEST_EXPECT(
+        ERROR_VCJSON_ARRAY_NOT_PACKED
+            == vcjson_array_get_doubles(&numbers, arr));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_array_get(&elem, arr, 0));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&number, elem));
+    TEST_EXPECT(4.0 == vcjson_number_value(number));
+
+    /* the document emits as before. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_emit_buffer(value, buffer, sizeof(buffer), &needed));
+    TEST_ASSERT(strlen(EXPECTED) == needed);
+    TEST_EXPECT(0 == memcmp(EXPECTED, buffer, needed));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(STATUS_SUCCESS
+        == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * A malformed element after numbers in a packed array is a parse error.
+ */
+TEST(bad_packed_array)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT_STRING = R"([1,2,@])";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parsing fails. */
+    TEST_ASSERT(
+        ERROR_VCJSON_PARSE_c207ee84_a90b_4d01_9314_a769a460819a
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT_STRING));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS
+        == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,320 @@
+/**
+ * \file test/test_vcjson_pool.cpp
+ *
+ * \brief Unit tests for vcjson_pool.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+#include <cstring>
+#include <pthread.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_pool);
+
+/**
+ * Verify that attaching a pool returns the previously attached pool.
+ */
+TEST(vcjson_pool_attach_basics)
+{
+    allocator* alloc = nullptr;
+    vcjson_pool* pool = nullptr;
+    vcjson_pool* other = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create two pools. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_pool_create(&pool, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_pool_create(&other, alloc));
+
+    /* no pool is attached by default. */
+    TEST_EXPECT(nullptr == vcjson_pool_attach(pool));
+
+    /* attaching another pool returns the first. */
+    TEST_EXPECT(pool == vcjson_pool_attach(other));
+
+    /* detaching returns the second. */
+    TEST_EXPECT(other == vcjson_pool_attach(nullptr));
+    TEST_EXPECT(nullptr == vcjson_pool_attach(nullptr));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_pool_resource_handle(other)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_pool_resource_handle(pool)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a released node is reused by the next node of its size.
+ */
+TEST(vcjson_pool_reuses_nodes)
+{
+    allocator* alloc = nullptr;
+    vcjson_pool* pool = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* second = nullptr;
+    vcjson_value* large = nullptr;
+    vcjson_number* number = nullptr;
+    char text[1024];
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create and attach a pool. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_pool_create(&pool, alloc));
+    TEST_EXPECT(nullptr == vcjson_pool_attach(pool));
+
+    /* create and release a number value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_create_number(&value, alloc, 1));
+    void* first = value;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+
+    /* the next number value takes the same node. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_value_create_number(&second, alloc, 2));
+    TEST_EXPECT(first == (void*)second);
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&number, second));
+    TEST_EXPECT(2 == vcjson_number_value(number));
+
+    /* a string too large for the pool comes from the allocator. */
+    memset(text, 'x', sizeof(text));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_string_from_raw(
+                    &large, alloc, text, sizeof(text)));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(large)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(second)));
+    TEST_EXPECT(pool == vcjson_pool_attach(nullptr));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_pool_resource_handle(pool)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a document parsed with a pool attached is intact.
+ */
+TEST(vcjson_pool_parse)
+{
+    allocator* alloc = nullptr;
+    vcjson_pool* pool = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_object_iterator* iter = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT =
+        R"({"id":"a1","nested":{"name":"a long enough name to skip the )"
+        R"(pool entirely, since it does not fit in any of the size )"
+        R"(classes","ok":false},"tags":["x","y",true,null]})";
+    const char* output;
+    size_t output_length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create and attach a pool. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_pool_create(&pool, alloc));
+    TEST_EXPECT(nullptr == vcjson_pool_attach(pool));
+
+    /* parse this document twice, so that the second reuses nodes. */
+    for (int i = 0; i < 2; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_parse_string(
+                        &value, &error_begin, &error_end, alloc, INPUT));
+
+        /* iterators are also taken from the pool. */
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_object_iterator_create(&iter, obj));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(
+                        vcjson_object_iterator_resource_handle(iter)));
+
+        /* the document emits as it was parsed. */
+        TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+        output = vcjson_string_value(str, &output_length);
+        TEST_ASSERT(strlen(INPUT) == output_length);
+        TEST_EXPECT(0 == memcmp(INPUT, output, output_length));
+
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_string_resource_handle(str)));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_value_resource_handle(value)));
+    }
+
+    /* clean up. */
+    TEST_EXPECT(pool == vcjson_pool_attach(nullptr));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_pool_resource_handle(pool)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a pool refuses to be released while a node taken from it is
+ * still live.
+ */
+TEST(vcjson_pool_release_in_use)
+{
+    allocator* alloc = nullptr;
+    vcjson_pool* pool = nullptr;
+    vcjson_value* value = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* take a node from a pool, then detach it. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_pool_create(&pool, alloc));
+    TEST_EXPECT(nullptr == vcjson_pool_attach(pool));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_create_number(&value, alloc, 1));
+    TEST_EXPECT(pool == vcjson_pool_attach(nullptr));
+
+    /* the pool is left intact while the node is live. */
+    TEST_EXPECT(
+        ERROR_VCJSON_POOL_IN_USE
+            == resource_release(vcjson_pool_resource_handle(pool)));
+
+    /* once the node is released, so can the pool be. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_pool_resource_handle(pool)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Arguments for a thread releasing values taken from another thread's
+ * pool.
+ */
+struct release_thread_args
+{
+    vcjson_value** values;
+    size_t count;
+    status retval;
+};
+
+/**
+ * \brief Release the given values.
+ */
+static void* release_thread(void* context)
+{
+    release_thread_args* args = (release_thread_args*)context;
+
+    args->retval = STATUS_SUCCESS;
+    for (size_t i = 0; i < args->count && STATUS_SUCCESS == args->retval; ++i)
+    {
+        args->retval =
+            resource_release(vcjson_value_resource_handle(args->values[i]));
+    }
+
+    return nullptr;
+}
+
+/**
+ * Verify that nodes released on other threads are handed back to the thread
+ * that the pool is attached to.
+ */
+TEST(vcjson_pool_release_other_threads)
+{
+    allocator* alloc = nullptr;
+    vcjson_pool* pool = nullptr;
+    vcjson_value* values[64];
+    vcjson_value* reused = nullptr;
+    pthread_t threads[4];
+    release_thread_args args[4];
+    /* a slab holds at most this many nodes. */
+    vcjson_value* drained[VCJSON_POOL_SLAB_SIZE / 16];
+    size_t drained_count = 0;
+    bool found = false;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create and attach a pool. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_pool_create(&pool, alloc));
+    TEST_EXPECT(nullptr == vcjson_pool_attach(pool));
+
+    /* take some nodes from the pool. */
+    for (size_t i = 0; i < 64; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcjson_value_create_number(&values[i], alloc, (double)i));
+    }
+
+    /* release them on other threads. */
+    for (size_t i = 0; i < 4; ++i)
+    {
+        args[i].values = values + 16 * i;
+        args[i].count = 16;
+        TEST_ASSERT(
+            0
+                == pthread_create(
+                        &threads[i], nullptr, &release_thread, &args[i]));
+    }
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], nullptr));
+        TEST_EXPECT(STATUS_SUCCESS == args[i].retval);
+    }
+
+    /* drain the local free list; a released node is then reused. */
+    while (!found)
+    {
+        TEST_ASSERT(drained_count < sizeof(drained) / sizeof(drained[0]));
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcjson_value_create_number(&reused, alloc, 0));
+        for (size_t i = 0; i < 64; ++i)
+        {
+            found = found || (void*)values[i] == (void*)reused;
+        }
+
+        drained[drained_count++] = reused;
+    }
+
+    /* the pool is in use until every node is back. */
+    TEST_EXPECT(
+        ERROR_VCJSON_POOL_IN_USE
+            == resource_release(vcjson_pool_resource_handle(pool)));
+
+    /* clean up. */
+    for (size_t i = 0; i < drained_count; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == resource_release(vcjson_value_resource_handle(drained[i])));
+    }
+
+    TEST_EXPECT(pool == vcjson_pool_attach(nullptr));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_pool_resource_handle(pool)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,220 @@
+/**
+ * \file test/test_vcjson_sensitive.cpp
+ *
+ * \brief Unit tests for sensitive strings.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vcjson/vcjson.h>
+
+#include "../src/vcjson_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_sensitive);
+
+/**
+ * \brief Determine whether the string member with the given key is sensitive.
+ */
+static bool member_is_sensitive(vcjson_object* obj, const char* key)
+{
+    vcjson_value* value = nullptr;
+    vcjson_string* str = nullptr;
+
+    if (STATUS_SUCCESS != vcjson_object_get_cstr(&value, obj, key)
+     || STATUS_SUCCESS != vcjson_value_get_string(&str, value))
+    {
+        return false;
+    }
+
+    return vcjson_string_is_sensitive(str);
+}
+
+/**
+ * Verify that strings are not sensitive by default, and that a string can be
+ * marked as sensitive.
+ */
+TEST(vcjson_string_set_sensitive_basics)
+{
+    allocator* alloc = nullptr;
+    vcjson_string* str = nullptr;
+    vcjson_string* copy = nullptr;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a string. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_create(&str, alloc, "4111"));
+
+    /* it is not sensitive by default. */
+    TEST_EXPECT(!vcjson_string_is_sensitive(str));
+
+    /* it can be marked as sensitive. */
+    vcjson_string_set_sensitive(str, true);
+    TEST_EXPECT(vcjson_string_is_sensitive(str));
+
+    /* a copy is also sensitive. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_string_copy(&copy, alloc, str));
+    TEST_EXPECT(vcjson_string_is_sensitive(copy));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(copy)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that the values of sensitive keys are marked at parse time.
+ */
+TEST(vcjson_parse_with_sensitive_keys_basics)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* card_value = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_object* card = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT =
+        R"({"card":{"cvv":"123","name":"bob","pan":"4111"},"pan":"4242",)"
+        R"("region":"r1"})";
+    const char* KEYS[] = { "pan", "cvv" };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse this document, marking the pan and cvv members. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_with_sensitive_keys(
+                    &value, &error_begin, &error_end, alloc, INPUT,
+                    strlen(INPUT), 0, KEYS, 2));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_object_get_cstr(&card_value, obj, "card"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&card, card_value));
+
+    /* the listed members are sensitive at any depth. */
+    TEST_EXPECT(member_is_sensitive(obj, "pan"));
+    TEST_EXPECT(member_is_sensitive(card, "pan"));
+    TEST_EXPECT(member_is_sensitive(card, "cvv"));
+
+    /* other members are not. */
+    TEST_EXPECT(!member_is_sensitive(obj, "region"));
+    TEST_EXPECT(!member_is_sensitive(card, "name"));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that the sensitive parse flag marks every string.
+ */
+TEST(vcjson_parse_flag_sensitive)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_object* obj = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"name":"bob","region":"r1"})";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse this document as sensitive. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_with_flags(
+                    &value, &error_begin, &error_end, alloc, INPUT,
+                    strlen(INPUT), VCJSON_PARSE_FLAG_SENSITIVE));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+
+    /* every string is sensitive. */
+    TEST_EXPECT(member_is_sensitive(obj, "name"));
+    TEST_EXPECT(member_is_sensitive(obj, "region"));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that emitted text holding a sensitive string is sensitive.
+ */
+TEST(vcjson_emit_string_sensitive)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* member = nullptr;
+    vcjson_object* obj = nullptr;
+    vcjson_string* str = nullptr;
+    size_t error_begin = 0xffff;
+    size_t error_end = 0xffff;
+    const char* INPUT = R"({"a":{"pan":"4111"},"b":"x"})";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* parse this document. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_parse_string(
+                    &value, &error_begin, &error_end, alloc, INPUT));
+
+    /* without sensitive strings, the emitted text is not sensitive. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    TEST_EXPECT(!vcjson_string_is_sensitive(str));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* memoize the emitted form of this document. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_cache_update(value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_object(&obj, value));
+    TEST_EXPECT(!obj->cache.sensitive);
+
+    /* mark the nested object as sensitive. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_object_get_cstr(&member, obj, "a"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_set_sensitive(member));
+
+    /* the caches holding it are marked as well. */
+    TEST_EXPECT(obj->cache.sensitive);
+
+    /* the emitted text is now sensitive. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_string(&str, alloc, value));
+    TEST_EXPECT(vcjson_string_is_sensitive(str));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcjson_string_resource_handle(str)));
+
+    /* an iovec list is sensitive as well. */
+    vcjson_iovec_list* list = nullptr;
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_emit_iovec(&list, alloc, value));
+    TEST_EXPECT(list->sensitive);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_iovec_list_resource_handle(list)));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,279 @@
+/**
+ * \file test/test_vcjson_snapshot.cpp
+ *
+ * \brief Unit tests for frozen value snapshots.
+ *
+ * \copyright 2022 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <minunit/minunit.h>
+#include <unistd.h>
+#include <vcjson/vcjson.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcjson_snapshot);
+
+/**
+ * \brief Sink that writes to a file descriptor.
+ */
+static status fd_sink(void* context, const void* data, size_t size)
+{
+    int fd = *(int*)context;
+
+    if ((ssize_t)size != write(fd, data, size))
+    {
+        return ERROR_VCJSON_SNAPSHOT_IO;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Freeze the given input and write it to a new temporary file.
+ */
+static status write_snapshot(
+    char* path, allocator* alloc, const char* input, uint32_t flags)
+{
+    status retval;
+    vcjson_value* value;
+    vcjson_frozen* frozen;
+    size_t error_begin, error_end;
+    int fd;
+
+    retval =
+        vcjson_parse_with_flags(
+            &value, &error_begin, &error_end, alloc, input, strlen(input),
+            flags);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = vcjson_value_freeze(&frozen, alloc, value);
+    if (STATUS_SUCCESS == retval)
+    {
+        strcpy(path, "/tmp/vcjson_snapshot_XXXXXX");
+        fd = mkstemp(path);
+        retval = vcjson_frozen_snapshot_write(frozen, &fd_sink, &fd);
+        close(fd);
+
+        (void)resource_release(vcjson_frozen_resource_handle(frozen));
+    }
+
+    (void)resource_release(vcjson_value_resource_handle(value));
+
+    return retval;
+}
+
+/**
+ * \brief Overwrite a byte of the given file.
+ */
+static bool poke(const char* path, off_t offset, char byte)
+{
+    int fd = open(path, O_WRONLY);
+    bool ok = fd >= 0 && 1 == pwrite(fd, &byte, 1, offset);
+
+    close(fd);
+
+    return ok;
+}
+
+/**
+ * Verify that a snapshot can be mapped and read in place.
+ */
+TEST(vcjson_frozen_snapshot_round_trip)
+{
+    allocator* alloc = nullptr;
+    vcjson_frozen* frozen = nullptr;
+    const vcjson_frozen_value* member;
+    const vcjson_frozen_value* element;
+    const vcjson_frozen_object* obj;
+    const vcjson_frozen_array* arr;
+    const char* str;
+    size_t length;
+    double number;
+    char path[64];
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* write a snapshot. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == write_snapshot(
+                    path, alloc, R"({"name":"ref","rates":[1.5,2.5]})", 0));
+
+    /* map it. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_snapshot_map(&frozen, alloc, path, 0));
+
+    /* read it in place. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_value_get_object(
+                    &obj, vcjson_frozen_root(frozen)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_object_get_cstr(&member, obj, "name"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_value_get_string(&str, &length, member));
+    TEST_EXPECT(3 == length && !strcmp("ref", str));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_object_get_cstr(&member, obj, "rates"));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_value_get_array(&arr, member));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_frozen_array_get(&element, arr, 1));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcjson_frozen_value_get_number(&number, element));
+    TEST_EXPECT(2.5 == number);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_frozen_resource_handle(frozen)));
+    unlink(path);
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that corrupt, truncated, and missing snapshots are rejected.
+ */
+TEST(vcjson_frozen_snapshot_validation)
+{
+    allocator* alloc = nullptr;
+    vcjson_frozen* frozen = nullptr;
+    char path[64];
+    off_t size;
+    int fd;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* a missing file cannot be mapped. */
+    TEST_EXPECT(
+        ERROR_VCJSON_SNAPSHOT_IO
+            == vcjson_frozen_snapshot_map(
+                    &frozen, alloc, "/tmp/vcjson_snapshot_missing", 0));
+
+    /* corrupt the last byte of a snapshot's tape. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == write_snapshot(path, alloc, R"({"a":"bcdefgh"})", 0));
+    fd = open(path, O_RDONLY);
+    size = lseek(fd, 0, SEEK_END);
+    close(fd);
+    TEST_ASSERT(poke(path, size - 2, 'X'));
+
+    /* it is rejected, unless its checksum is skipped. */
+    TEST_EXPECT(
+        ERROR_VCJSON_SNAPSHOT_BAD_CHECKSUM
+            == vcjson_frozen_snapshot_map(&frozen, alloc, path, 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_snapshot_map(
+                    &frozen, alloc, path, VCJSON_SNAPSHOT_FLAG_NO_VERIFY));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_frozen_resource_handle(frozen)));
+
+    /* a truncated snapshot is rejected. */
+    TEST_ASSERT(0 == truncate(path, size - 1));
+    TEST_EXPECT(
+        ERROR_VCJSON_SNAPSHOT_BAD_HEADER
+            == vcjson_frozen_snapshot_map(&frozen, alloc, path, 0));
+    unlink(path);
+
+    /* a snapshot with a bad header is rejected. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == write_snapshot(path, alloc, R"({"a":"b"})", 0));
+    TEST_ASSERT(poke(path, 8, 2));
+    TEST_EXPECT(
+        ERROR_VCJSON_SNAPSHOT_BAD_HEADER
+            == vcjson_frozen_snapshot_map(&frozen, alloc, path, 0));
+    unlink(path);
+
+    /* sensitive strings are never written. */
+    TEST_EXPECT(
+        ERROR_VCJSON_SNAPSHOT_SENSITIVE
+            == write_snapshot(
+                    path, alloc, R"({"a":"b"})", VCJSON_PARSE_FLAG_SENSITIVE));
+    unlink(path);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
+
+/**
+ * Verify that a snapshot whose tape is not laid out as a frozen value is
+ * rejected, even when its checksum is skipped.
+ */
+TEST(vcjson_frozen_snapshot_bad_tape)
+{
+    allocator* alloc = nullptr;
+    vcjson_frozen* frozen = nullptr;
+    const char* INPUT = R"({"a":"b","c":[true,null]})";
+    char path[64];
+    /* the root entry follows the 48 byte header; each entry is 16 bytes. */
+    const off_t ROOT = 48;
+    const off_t VALUE = ROOT + 2 * 16;
+    const struct
+    {
+        off_t offset;
+        char byte;
+    } CORRUPTIONS[] = {
+        /* an unknown type tag. */
+        { ROOT, 99 },
+        /* more members than the tape holds. */
+        { ROOT + 6, 0x10 },
+        /* members outside the tape. */
+        { ROOT + 15, 0x10 },
+        /* members overlapping the object itself. */
+        { ROOT + 8, 0 },
+        /* a key that is not a string. */
+        { ROOT + 16, VCJSON_VALUE_TYPE_NULL },
+        /* a string running past the tape. */
+        { VALUE + 6, 0x10 },
+        /* a string without its terminator. */
+        { VALUE + 4, 2 },
+    };
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* an intact snapshot passes the structural checks. */
+    TEST_ASSERT(STATUS_SUCCESS == write_snapshot(path, alloc, INPUT, 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_frozen_snapshot_map(
+                    &frozen, alloc, path, VCJSON_SNAPSHOT_FLAG_NO_VERIFY));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_frozen_resource_handle(frozen)));
+    unlink(path);
+
+    /* each corruption is caught without the checksum. */
+    for (const auto& corruption : CORRUPTIONS)
+    {
+        TEST_ASSERT(STATUS_SUCCESS == write_snapshot(path, alloc, INPUT, 0));
+        TEST_ASSERT(poke(path, corruption.offset, corruption.byte));
+        TEST_EXPECT(
+            ERROR_VCJSON_SNAPSHOT_BAD_TAPE
+                == vcjson_frozen_snapshot_map(
+                        &frozen, alloc, path, VCJSON_SNAPSHOT_FLAG_NO_VERIFY));
+        unlink(path);
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(allocator_resource_handle(alloc)));
+}
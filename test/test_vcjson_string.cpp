@@ -45,3 +45,35 @@ TEST(vcjson_string_create_basics)
         STATUS_SUCCESS
             == resource_release(allocator_resource_handle(alloc)));
 }
+
+/**
+ * Verify that vcjson_string_create_from_raw keeps its characters ASCIIZ.
+ */
+TEST(vcjson_string_create_from_raw_asciiz)
+{
+    allocator* alloc = nullptr;
+    vcjson_string* string = nullptr;
+    const char* INPUT = "USDX";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a string from the first three characters. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_string_create_from_raw(&string, alloc, INPUT, 3));
+
+    /* the characters are ASCIIZ, though the terminator isn't part of them. */
+    size_t length;
+    const char* str = vcjson_string_value(string, &length);
+    TEST_ASSERT(3 == length);
+    TEST_EXPECT(0 == memcmp("USD", str, 4));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_string_resource_handle(string)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(allocator_resource_handle(alloc)));
+}
@@ -181,6 +181,95 @@ TEST(value_string_basics)
     resource_release(allocator_resource_handle(alloc));
 }
 
+/**
+ * \brief A number value can be created in a single allocation.
+ */
+TEST(value_create_number)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_number* numberval = nullptr;
+    const double EXPECTED_VALUE = -17.5;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a number value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_number(&value, alloc, EXPECTED_VALUE));
+
+    /* the type of this value is VCJSON_VALUE_TYPE_NUMBER. */
+    TEST_EXPECT(VCJSON_VALUE_TYPE_NUMBER == vcjson_value_type(value));
+
+    /* get the number value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&numberval, value));
+    TEST_EXPECT(EXPECTED_VALUE == vcjson_number_value(numberval));
+
+    /* a copy holds the same number. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_number(&numberval, copy));
+    TEST_EXPECT(EXPECTED_VALUE == vcjson_number_value(numberval));
+
+    /* clean up. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    resource_release(allocator_resource_handle(alloc));
+}
+
+/**
+ * \brief A string value can be created in a single allocation.
+ */
+TEST(value_create_string_from_raw)
+{
+    allocator* alloc = nullptr;
+    vcjson_value* value = nullptr;
+    vcjson_value* copy = nullptr;
+    vcjson_string* stringval = nullptr;
+    const char EXPECTED_VALUE[] = { 'a', 'b', 0, 'c' };
+    const char* str;
+    size_t length;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == malloc_allocator_create(&alloc));
+
+    /* create a string value holding an embedded zero byte. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcjson_value_create_string_from_raw(
+                    &value, alloc, EXPECTED_VALUE, sizeof(EXPECTED_VALUE)));
+
+    /* the type of this value is VCJSON_VALUE_TYPE_STRING. */
+    TEST_EXPECT(VCJSON_VALUE_TYPE_STRING == vcjson_value_type(value));
+
+    /* get the string value. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_string(&stringval, value));
+    str = vcjson_string_value(stringval, &length);
+    TEST_ASSERT(sizeof(EXPECTED_VALUE) == length);
+    TEST_EXPECT(0 == memcmp(EXPECTED_VALUE, str, length));
+
+    /* a copy holds the same string. */
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_copy(&copy, alloc, value));
+    TEST_ASSERT(STATUS_SUCCESS == vcjson_value_get_string(&stringval, copy));
+    str = vcjson_string_value(stringval, &length);
+    TEST_ASSERT(sizeof(EXPECTED_VALUE) == length);
+    TEST_EXPECT(0 == memcmp(EXPECTED_VALUE, str, length));
+
+    /* clean up. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(copy)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcjson_value_resource_handle(value)));
+    resource_release(allocator_resource_handle(alloc));
+}
+
 /**
  * \brief Test for object related values.
  */